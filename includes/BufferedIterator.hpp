@@ -0,0 +1,111 @@
+#ifndef BUFFEREDITERATOR_HPP
+# define BUFFEREDITERATOR_HPP
+
+#include "RBTreeIterator.hpp"
+
+namespace ft
+{
+	// iterator of buffered_map: merges the sorted write buffer (_buf[_pos]) with the tree
+	// (_node), which never hold the same key, yielding whichever is smaller under Compare
+	template <typename T, typename Compare>
+	class BufferedIterator : public ft::iterator<ft::bidirectional_iterator_tag, T>
+	{
+		public :
+			typedef const T		value_type;
+			typedef const T*	pointer;
+			typedef const T&	reference;
+			typedef typename ft::iterator<ft::bidirectional_iterator_tag, T>::difference_type	difference_type;
+			typedef typename ft::iterator<ft::bidirectional_iterator_tag, T>::iterator_category	iterator_category;
+			typedef ft::RBTreeNode<T>	node_type;
+			typedef ft::RBTreeIterator<T, T*, T&>	tree_iterator;
+
+		protected :
+			node_type* const*	_buf;
+			size_t				_pos;
+			size_t				_count;
+			node_type*			_node;
+			Compare				_comp;
+
+		public:
+
+			BufferedIterator() : _buf(NULL), _pos(0), _count(0), _node(NULL), _comp() {}
+			BufferedIterator(node_type* const* buf, size_t pos, size_t count, node_type* node)
+				: _buf(buf), _pos(pos), _count(count), _node(node), _comp() {}
+			BufferedIterator(const BufferedIterator& copy)
+				: _buf(copy._buf), _pos(copy._pos), _count(copy._count), _node(copy._node), _comp() {}
+			BufferedIterator& operator=(const BufferedIterator& copy)
+			{
+				if (this != &copy)
+				{
+					this->_buf = copy._buf;
+					this->_pos = copy._pos;
+					this->_count = copy._count;
+					this->_node = copy._node;
+				}
+				return (*this);
+			}
+			virtual ~BufferedIterator() {}
+
+			reference operator*() const
+			{
+				return (in_buffer() ? *this->_buf[this->_pos]->value : *this->_node->value);
+			}
+			pointer operator->() const
+			{
+				return (&(operator*()));
+			}
+
+			BufferedIterator& operator++()
+			{
+				if (in_buffer())
+					++this->_pos;
+				else
+					this->_node = (++tree_iterator(this->_node)).base();
+				return (*this);
+			}
+
+			BufferedIterator operator++(int)
+			{
+				BufferedIterator tmp = *this;
+				++(*this);
+				return (tmp);
+			}
+
+			// steps back on the side holding the greater predecessor; stepping back from
+			// the tree's first node lands on its nil, which holds no value
+			BufferedIterator& operator--()
+			{
+				node_type* prev = (--tree_iterator(this->_node)).base();
+				if (prev->value != NULL && (this->_pos == 0 || this->_comp(*this->_buf[this->_pos - 1]->value, *prev->value)))
+					this->_node = prev;
+				else
+					--this->_pos;
+				return (*this);
+			}
+
+			BufferedIterator operator--(int)
+			{
+				BufferedIterator tmp = *this;
+				--(*this);
+				return (tmp);
+			}
+
+			bool operator==(const BufferedIterator& iter) const
+			{
+				return (this->_pos == iter._pos && this->_node == iter._node);
+			}
+
+			bool operator!=(const BufferedIterator& iter) const
+			{
+				return (!(*this == iter));
+			}
+
+		private :
+			bool in_buffer() const
+			{
+				return (this->_pos != this->_count && (this->_node->value == NULL || this->_comp(*this->_buf[this->_pos]->value, *this->_node->value)));
+			}
+	};
+}
+
+#endif
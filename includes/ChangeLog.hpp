@@ -0,0 +1,138 @@
+#ifndef CHANGELOG_HPP
+# define CHANGELOG_HPP
+
+#include <cstddef>
+#include <vector>
+#include <algorithm>
+
+namespace ft
+{
+	// keys written or erased since each checkpoint, for map's change tracking: an
+	// append-only log cut into one segment per checkpoint version, so the changes since
+	// version v are the log from its mark on. A key written many times between two
+	// checkpoints is logged once per write, so the open segment is sorted and deduplicated
+	// once it outgrows twice the size of the map and has doubled since the last dedup. That
+	// bounds it by twice the distinct keys touched since the checkpoint, size() plus the
+	// erased ones, at O(log n) amortized per write even when most of the map is erased.
+	template <typename Key, typename Compare>
+	class ChangeLog {
+		private :
+			std::vector<Key>	_keys;
+			std::vector<size_t>	_marks;	// log size at version _base + i
+			unsigned long	_base;		// oldest version still answerable
+			unsigned long	_next;		// version the next checkpoint gets; 0 is never one
+			size_t	_deduped;	// open segment size after its last dedup
+			bool	_enabled;
+
+		public :
+			ChangeLog() : _base(1), _next(1), _deduped(0), _enabled(false) {}
+
+			// history starts over either way
+			void enable(bool on)
+			{
+				this->_enabled = on;
+				reset();
+			}
+
+			bool enabled() const
+			{
+				return (this->_enabled);
+			}
+
+			void record(const Key& k, size_t live, const Compare& comp)
+			{
+				if (!this->_enabled)
+					return ;
+				this->_keys.push_back(k);
+				size_t from = (this->_marks.empty() ? 0 : this->_marks.back());
+				size_t open = this->_keys.size() - from;
+				if (open > 2 * live + 64 && open >= 2 * this->_deduped)
+					dedup(from, comp);
+			}
+
+			// 0 while tracking is off
+			unsigned long checkpoint()
+			{
+				if (!this->_enabled)
+					return (0);
+				this->_marks.push_back(this->_keys.size());
+				this->_deduped = 0;
+				return (this->_next++);
+			}
+
+			// after a change to every element, no earlier version can be answered any more
+			void reset()
+			{
+				this->_keys.clear();
+				this->_marks.clear();
+				this->_deduped = 0;
+				this->_base = this->_next;
+			}
+
+			// appends the keys logged since version, sorted and unique; false when version
+			// is not one of the answerable checkpoints
+			bool since(unsigned long version, std::vector<Key>& keys, const Compare& comp) const
+			{
+				if (!this->_enabled || version < this->_base || version >= this->_next)
+					return (false);
+				size_t from = keys.size();
+				keys.insert(keys.end(), this->_keys.begin() + this->_marks[version - this->_base], this->_keys.end());
+				std::sort(keys.begin() + from, keys.end(), comp);
+				keys.erase(unique(keys.begin() + from, keys.end(), comp), keys.end());
+				return (true);
+			}
+
+			// drops what only versions before version need
+			void trim(unsigned long version)
+			{
+				if (version <= this->_base)
+					return ;
+				if (version >= this->_next)
+				{
+					reset();
+					return ;
+				}
+				size_t drop = this->_marks[version - this->_base];
+				this->_keys.erase(this->_keys.begin(), this->_keys.begin() + drop);
+				this->_marks.erase(this->_marks.begin(), this->_marks.begin() + (version - this->_base));
+				for (size_t i = 0; i < this->_marks.size(); ++i)
+					this->_marks[i] -= drop;
+				this->_base = version;
+			}
+
+			void swap(ChangeLog& x)
+			{
+				this->_keys.swap(x._keys);
+				this->_marks.swap(x._marks);
+				std::swap(this->_base, x._base);
+				std::swap(this->_next, x._next);
+				std::swap(this->_deduped, x._deduped);
+				std::swap(this->_enabled, x._enabled);
+			}
+
+		private :
+			void dedup(size_t from, const Compare& comp)
+			{
+				std::sort(this->_keys.begin() + from, this->_keys.end(), comp);
+				this->_keys.erase(unique(this->_keys.begin() + from, this->_keys.end(), comp), this->_keys.end());
+				this->_deduped = this->_keys.size() - from;
+			}
+
+			// std::unique with equivalence under comp
+			template <typename It>
+			static It unique(It first, It last, const Compare& comp)
+			{
+				if (first == last)
+					return (last);
+				It out = first;
+				while (++first != last)
+				{
+					if (comp(*out, *first))
+						*++out = *first;
+				}
+				return (++out);
+			}
+	};
+}
+
+#endif
@@ -0,0 +1,191 @@
+#ifndef COUNTINGBLOOM_HPP
+# define COUNTINGBLOOM_HPP
+
+#include <cstddef>
+#include "utils.hpp"
+
+namespace ft
+{
+	// counting Bloom filter over key hashes, used by map/set find() and count() once
+	// enabled to answer most misses without descending the tree. Each key bumps k one-byte
+	// counters picked by double hashing, so erase can take it out again; a counter that
+	// saturates at 255 is never decremented, which only costs precision. No false
+	// negatives as long as the owner adds every inserted key and removes every erased one.
+	// may_contain() runs under const lookups, which may be concurrent: it only reads the
+	// counters and bumps the rejection count with relaxed atomics.
+	class CountingBloom {
+		private :
+			unsigned char*	_counters;
+			size_t	_mask;		// counter count - 1, a power of two
+			size_t	_hashes;	// k
+			size_t	_per_key;	// counters per expected key, as asked
+			size_t	_capacity;	// keys the filter was sized for
+			size_t	_count;		// keys in it
+			size_t	_rejected;	// misses caught, may come out low under concurrent lookups
+
+		public :
+			CountingBloom() : _counters(NULL), _mask(0), _hashes(0), _per_key(0), _capacity(0), _count(0), _rejected(0) {}
+
+			CountingBloom(const CountingBloom& x) : _counters(NULL), _mask(0), _hashes(0), _per_key(0), _capacity(0), _count(0), _rejected(0)
+			{
+				*this = x;
+			}
+
+			~CountingBloom()
+			{
+				delete[] this->_counters;
+			}
+
+			// a copy holds the same keys, so it takes the counters along
+			CountingBloom& operator=(const CountingBloom& x)
+			{
+				if (this == &x)
+					return (*this);
+				enable(x._capacity, x._per_key);
+				for (size_t i = 0; this->_counters != NULL && i <= this->_mask; ++i)
+					this->_counters[i] = x._counters[i];
+				this->_count = x._count;
+				return (*this);
+			}
+
+			// room for capacity keys at per_key counters each (rounded up to a power of two
+			// in all), 10 giving about 1% false positives at capacity; 0 turns it off. The
+			// filter comes back empty and the owner refills it.
+			void enable(size_t capacity, size_t per_key)
+			{
+				delete[] this->_counters;
+				this->_counters = NULL;
+				this->_mask = 0;
+				this->_hashes = 0;
+				this->_per_key = per_key;
+				this->_capacity = capacity;
+				this->_count = 0;
+				this->_rejected = 0;
+				if (capacity == 0 || per_key == 0)
+					return ;
+				size_t size = 64;
+				while (size < capacity * per_key)
+					size <<= 1;
+				// k = ln 2 * counters per key is optimal for the false positive rate
+				this->_hashes = (size / capacity * 7 + 5) / 10;
+				if (this->_hashes < 1)
+					this->_hashes = 1;
+				if (this->_hashes > 8)
+					this->_hashes = 8;
+				this->_mask = size - 1;
+				this->_counters = new unsigned char[size];
+				clear();
+			}
+
+			bool enabled() const
+			{
+				return (this->_counters != NULL);
+			}
+
+			size_t capacity() const
+			{
+				return (this->_capacity);
+			}
+
+			size_t per_key() const
+			{
+				return (this->_per_key);
+			}
+
+			size_t rejected() const
+			{
+				return (ft::relaxed_load(this->_rejected));
+			}
+
+			// false means the key is surely absent
+			bool may_contain(size_t hash)
+			{
+				size_t h1;
+				size_t h2;
+				probes(hash, h1, h2);
+				for (size_t i = 0; i < this->_hashes; ++i, h1 += h2)
+				{
+					if (this->_counters[h1 & this->_mask] == 0)
+					{
+						ft::relaxed_increment(this->_rejected);
+						return (false);
+					}
+				}
+				return (true);
+			}
+
+			// true once more keys than capacity are in, when the owner should refill a
+			// larger filter
+			bool add(size_t hash)
+			{
+				size_t h1;
+				size_t h2;
+				probes(hash, h1, h2);
+				for (size_t i = 0; i < this->_hashes; ++i, h1 += h2)
+				{
+					unsigned char& counter = this->_counters[h1 & this->_mask];
+					if (counter != 255)
+						++counter;
+				}
+				return (++this->_count > this->_capacity);
+			}
+
+			void remove(size_t hash)
+			{
+				size_t h1;
+				size_t h2;
+				probes(hash, h1, h2);
+				for (size_t i = 0; i < this->_hashes; ++i, h1 += h2)
+				{
+					unsigned char& counter = this->_counters[h1 & this->_mask];
+					if (counter != 255)
+						--counter;
+				}
+				--this->_count;
+			}
+
+			void clear()
+			{
+				for (size_t i = 0; this->_counters != NULL && i <= this->_mask; ++i)
+					this->_counters[i] = 0;
+				this->_count = 0;
+			}
+
+			void swap(CountingBloom& x)
+			{
+				swap(this->_counters, x._counters);
+				swap(this->_mask, x._mask);
+				swap(this->_hashes, x._hashes);
+				swap(this->_per_key, x._per_key);
+				swap(this->_capacity, x._capacity);
+				swap(this->_count, x._count);
+				swap(this->_rejected, x._rejected);
+			}
+
+		private :
+			// the two hashes of double hashing, from one key hash mixed with the 64-bit
+			// murmur finalizer (identity integer hashes carry too little entropy as is);
+			// h2 is odd so the k probes are distinct
+			void probes(size_t hash, size_t& h1, size_t& h2) const
+			{
+				unsigned long long x = hash;
+				x ^= x >> 33;
+				x *= 0xff51afd7ed558ccdULL;
+				x ^= x >> 33;
+				x *= 0xc4ceb9fe1a85ec53ULL;
+				x ^= x >> 33;
+				h1 = static_cast<size_t>(x);
+				h2 = static_cast<size_t>(x >> 32) | 1;
+			}
+
+			template <typename _T>
+			void swap(_T& a, _T& b)
+			{
+				_T tmp(a);
+				a = b;
+				b = tmp;
+			}
+	};
+}
+
+#endif
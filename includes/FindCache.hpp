@@ -0,0 +1,160 @@
+#ifndef FINDCACHE_HPP
+# define FINDCACHE_HPP
+
+#include <cstddef>
+#include "utils.hpp"
+
+namespace ft
+{
+	// two-way set-associative cache of recently found tree nodes, indexed by key hash,
+	// used by map/set find() once enabled. A miss lands in the second way and only a hit
+	// there promotes it to the first, so one-off lookups never evict a hot key. The owner
+	// invalidates an erased node and clears everything when the tree is rebuilt; a slot
+	// whose key no longer matches is simply a miss. find() runs under const lookups, which
+	// may be concurrent: it reads and writes slots and counts with relaxed atomics, so a
+	// race between readers costs a miss or a lost count, never a wrong node.
+	template <typename Node>
+	class FindCache {
+		private :
+			Node**	_slots;
+			size_t	_size;
+			size_t	_shift;
+			size_t	_hits;
+			size_t	_misses;
+
+		public :
+			FindCache() : _slots(NULL), _size(0), _shift(0), _hits(0), _misses(0) {}
+
+			// a copy has the same geometry but caches nothing, its tree holds other nodes
+			FindCache(const FindCache& x) : _slots(NULL), _size(0), _shift(0), _hits(0), _misses(0)
+			{
+				enable(x._size);
+			}
+
+			~FindCache()
+			{
+				delete[] this->_slots;
+			}
+
+			FindCache& operator=(const FindCache& x)
+			{
+				if (this != &x)
+					enable(x._size);
+				return (*this);
+			}
+
+			// slots is rounded up to a power of two (four at least), 0 turns the cache off
+			void enable(size_t slots)
+			{
+				delete[] this->_slots;
+				this->_slots = NULL;
+				this->_size = 0;
+				this->_hits = 0;
+				this->_misses = 0;
+				if (slots == 0)
+					return ;
+				size_t bits = 2;
+				while ((static_cast<size_t>(1) << bits) < slots)
+					++bits;
+				this->_size = static_cast<size_t>(1) << bits;
+				this->_shift = sizeof(size_t) * 8 - (bits - 1);
+				this->_slots = new Node*[this->_size];
+				clear();
+			}
+
+			bool enabled() const
+			{
+				return (this->_slots != NULL);
+			}
+
+			size_t size() const
+			{
+				return (this->_size);
+			}
+
+			size_t hits() const
+			{
+				return (ft::relaxed_load(this->_hits));
+			}
+
+			size_t misses() const
+			{
+				return (ft::relaxed_load(this->_misses));
+			}
+
+			// cached node for key when it still holds key, else the tree lookup, remembered
+			// when found
+			template <typename Tree, typename Key>
+			Node* find(const Tree& tree, const Key& key, size_t hash)
+			{
+				Node** set = this->_slots + index(hash);
+				Node* first = ft::relaxed_load(set[0]);
+				if (first != NULL && tree.equivalent(key, first))
+				{
+					ft::relaxed_increment(this->_hits);
+					return (first);
+				}
+				Node* second = ft::relaxed_load(set[1]);
+				if (second != NULL && tree.equivalent(key, second))
+				{
+					ft::relaxed_increment(this->_hits);
+					ft::relaxed_store(set[0], second);
+					ft::relaxed_store(set[1], first);
+					return (second);
+				}
+				ft::relaxed_increment(this->_misses);
+				Node* res = tree.find(key);
+				if (res->value != NULL)
+					ft::relaxed_store(set[1], res);
+				return (res);
+			}
+
+			void invalidate(size_t hash, Node* node)
+			{
+				if (this->_slots == NULL)
+					return ;
+				Node** set = this->_slots + index(hash);
+				if (set[0] == node)
+				{
+					set[0] = set[1];
+					set[1] = NULL;
+				}
+				else if (set[1] == node)
+					set[1] = NULL;
+			}
+
+			void clear()
+			{
+				for (size_t i = 0; i < this->_size; ++i)
+					this->_slots[i] = NULL;
+			}
+
+			void swap(FindCache& x)
+			{
+				swap(this->_slots, x._slots);
+				swap(this->_size, x._size);
+				swap(this->_shift, x._shift);
+				swap(this->_hits, x._hits);
+				swap(this->_misses, x._misses);
+			}
+
+		private :
+			// first slot of the set: Fibonacci hashing keeps the top bits of hash * 2^64/phi,
+			// so identity integer hashes of sequential or strided keys still spread out
+			size_t index(size_t hash) const
+			{
+				const size_t golden = (sizeof(size_t) > 4 ? static_cast<size_t>(0x9E3779B97F4A7C15ULL) : static_cast<size_t>(0x9E3779B9UL));
+				return (((hash * golden) >> this->_shift) * 2);
+			}
+
+			template <typename _T>
+			void swap(_T& a, _T& b)
+			{
+				_T tmp(a);
+				a = b;
+				b = tmp;
+			}
+	};
+}
+
+#endif
@@ -0,0 +1,104 @@
+#ifndef HOTCOUNTERS_HPP
+# define HOTCOUNTERS_HPP
+
+#include <cstddef>
+#include <ostream>
+#include "utils.hpp"
+
+namespace ft
+{
+	// hot-path counters of one container, see CountingPolicy
+	struct HotCounters {
+		size_t	comparisons;
+		size_t	rotations;
+		size_t	recolorings;
+		size_t	node_allocs;
+		size_t	node_frees;
+		size_t	reallocations;
+		size_t	elements_copied;
+
+		HotCounters() : comparisons(0), rotations(0), recolorings(0), node_allocs(0), node_frees(0),
+			reallocations(0), elements_copied(0) {}
+
+		void reset()
+		{
+			*this = HotCounters();
+		}
+	};
+
+	// one "name value" pair per line, ready to be scraped
+	inline std::ostream& operator<<(std::ostream& os, const HotCounters& c)
+	{
+		os << "comparisons " << c.comparisons << '\n'
+			<< "rotations " << c.rotations << '\n'
+			<< "recolorings " << c.recolorings << '\n'
+			<< "node_allocs " << c.node_allocs << '\n'
+			<< "node_frees " << c.node_frees << '\n'
+			<< "reallocations " << c.reallocations << '\n'
+			<< "elements_copied " << c.elements_copied << '\n';
+		return (os);
+	}
+
+	// default policy: every hook is an empty inline function and the base is empty,
+	// so containers pay neither time nor space for it
+	struct NoCountingPolicy {
+		void count_compare() const {}
+		void count_rotation() const {}
+		void count_recolor(size_t) const {}
+		void count_node_alloc() const {}
+		void count_node_free() const {}
+		void count_reallocation() const {}
+		void count_copy(size_t) const {}
+		static void count_global_iterator_step() {}
+		static size_t global_iterator_steps() { return (0); }
+
+		HotCounters hot_counters() const { return (HotCounters()); }
+		void reset_hot_counters() const {}
+	};
+
+	// selected with -DFT_HOT_COUNTERS, counts are kept per container instance
+	struct CountingPolicy {
+		mutable HotCounters	_hot;
+
+		void count_compare() const { ++_hot.comparisons; }
+		void count_rotation() const { ++_hot.rotations; }
+		void count_recolor(size_t n) const { _hot.recolorings += n; }
+		void count_node_alloc() const { ++_hot.node_allocs; }
+		void count_node_free() const { ++_hot.node_frees; }
+		void count_reallocation() const { ++_hot.reallocations; }
+		void count_copy(size_t n) const { _hot.elements_copied += n; }
+
+		// RBTreeIterator only holds a node pointer and cannot reach its container, so its
+		// steps go to one process-wide count, kept apart from the per-container ones and
+		// bumped relaxed as threads may iterate different containers at once
+		static size_t& iterator_step_count()
+		{
+			static size_t steps = 0;
+			return (steps);
+		}
+		static void count_global_iterator_step() { ft::relaxed_increment(iterator_step_count()); }
+		static size_t global_iterator_steps() { return (ft::relaxed_load(iterator_step_count())); }
+
+		HotCounters hot_counters() const
+		{
+			return (_hot);
+		}
+		// const like the counting itself, so a tree shared by copies resets without a clone
+		void reset_hot_counters() const { _hot.reset(); }
+	};
+
+#ifdef FT_HOT_COUNTERS
+	typedef CountingPolicy	DefaultCountingPolicy;
+#else
+	typedef NoCountingPolicy	DefaultCountingPolicy;
+#endif
+
+	// steps taken by every RBTree iterator of the process since it started (0 unless
+	// built with -DFT_HOT_COUNTERS); steps from concurrent threads may be lost
+	inline size_t hot_iterator_steps()
+	{
+		return (DefaultCountingPolicy::global_iterator_steps());
+	}
+}
+
+#endif
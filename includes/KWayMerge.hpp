@@ -0,0 +1,155 @@
+#ifndef KWAYMERGE_HPP
+# define KWAYMERGE_HPP
+
+#include <cstddef>
+#include <vector>
+#include "parallel.hpp"
+
+namespace ft
+{
+	// one sorted input of a k-way merge; source is its rank among the inputs
+	template <typename It>
+	struct MergeCursor {
+		It		cur;
+		It		end;
+		size_t	source;
+
+		MergeCursor(It first, It last, size_t s) : cur(first), end(last), source(s) {}
+	};
+
+	// heap order: smaller key first, then lower source
+	template <typename It, typename Less>
+	bool before(const MergeCursor<It>& a, const MergeCursor<It>& b, const Less& less)
+	{
+		if (less(a.cur->first, b.cur->first))
+			return (true);
+		return (!less(b.cur->first, a.cur->first) && a.source < b.source);
+	}
+
+	// moves the root down to where it belongs, one swap per level
+	template <typename It, typename Less>
+	void sift_down(std::vector< MergeCursor<It> >& heap, const Less& less)
+	{
+		size_t i = 0;
+		while (2 * i + 1 < heap.size())
+		{
+			size_t c = 2 * i + 1;
+			if (c + 1 < heap.size() && before(heap[c + 1], heap[c], less))
+				++c;
+			if (!before(heap[c], heap[i], less))
+				return ;
+			std::swap(heap[c], heap[i]);
+			i = c;
+		}
+	}
+
+	// appends to out the union of runs, each sorted by key with unique keys, in key order.
+	// A binary min-heap holds the head of every run, ties going to the lower source, so
+	// the values of one key are folded with reduce(acc, value) in run order.
+	template <typename It, typename Out, typename Less, typename Reduce>
+	void kway_merge(const std::vector< MergeCursor<It> >& runs, std::vector<Out>& out, const Less& less, const Reduce& reduce)
+	{
+		std::vector< MergeCursor<It> > heap;
+		for (size_t i = 0; i < runs.size(); ++i)
+		{
+			if (runs[i].cur == runs[i].end)
+				continue ;
+			heap.push_back(runs[i]);
+			for (size_t c = heap.size() - 1; c > 0 && before(heap[c], heap[(c - 1) / 2], less); c = (c - 1) / 2)
+				std::swap(heap[c], heap[(c - 1) / 2]);
+		}
+		while (!heap.empty())
+		{
+			MergeCursor<It>& top = heap[0];
+			if (!out.empty() && !less(out.back().first, top.cur->first))
+				out.back().second = reduce(out.back().second, top.cur->second);
+			else
+				out.push_back(Out(top.cur->first, top.cur->second));
+			if (++top.cur == top.end)
+			{
+				top = heap.back();
+				heap.pop_back();
+			}
+			sift_down(heap, less);
+		}
+	}
+
+	// first round of a parallel merge: each task merges a contiguous group of inputs
+	template <typename It, typename Out, typename Less, typename Reduce>
+	struct GroupMergeJob {
+		const std::vector< MergeCursor<It> >&	runs;
+		const std::vector<size_t>&				bounds;
+		std::vector< std::vector<Out> >&		outs;
+		const Less&								less;
+		const Reduce&							reduce;
+
+		GroupMergeJob(const std::vector< MergeCursor<It> >& r, const std::vector<size_t>& b, std::vector< std::vector<Out> >& o,
+			const Less& l, const Reduce& red) : runs(r), bounds(b), outs(o), less(l), reduce(red) {}
+
+		void run(size_t i)
+		{
+			std::vector< MergeCursor<It> > group(runs.begin() + bounds[i], runs.begin() + bounds[i + 1]);
+			kway_merge(group, outs[i], less, reduce);
+		}
+	};
+
+	// later rounds: task i merges outputs 2i and 2i + 1 of the previous round into to[i]
+	template <typename Out, typename Less, typename Reduce>
+	struct PairMergeJob {
+		typedef typename std::vector<Out>::const_iterator	run_iterator;
+
+		const std::vector< std::vector<Out> >&	from;
+		std::vector< std::vector<Out> >&		to;
+		const Less&								less;
+		const Reduce&							reduce;
+
+		PairMergeJob(const std::vector< std::vector<Out> >& f, std::vector< std::vector<Out> >& t, const Less& l, const Reduce& r)
+			: from(f), to(t), less(l), reduce(r) {}
+
+		void run(size_t i)
+		{
+			std::vector< MergeCursor<run_iterator> > pair;
+			for (size_t j = 2 * i; j < 2 * i + 2 && j < from.size(); ++j)
+				pair.push_back(MergeCursor<run_iterator>(from[j].begin(), from[j].end(), j));
+			to[i].reserve(from[2 * i].size() + (2 * i + 1 < from.size() ? from[2 * i + 1].size() : 0));
+			kway_merge(pair, to[i], less, reduce);
+		}
+	};
+
+	// kway_merge on up to threads pthreads (0: one per core) as a merge tree: the inputs
+	// are cut into one contiguous group per thread, the groups are merged concurrently,
+	// then the results pairwise in rounds. Groups keep the inputs in order, but reduce
+	// must be associative since values are folded per group first.
+	template <typename It, typename Out, typename Less, typename Reduce>
+	void parallel_kway_merge(const std::vector< MergeCursor<It> >& runs, std::vector<Out>& out, const Less& less, const Reduce& reduce,
+		unsigned int threads)
+	{
+		if (threads == 0)
+			threads = hardware_threads();
+		size_t groups = std::min(static_cast<size_t>(threads), runs.size() / 2);
+		if (groups <= 1)
+		{
+			kway_merge(runs, out, less, reduce);
+			return ;
+		}
+		std::vector<size_t> bounds;
+		for (size_t i = 0; i <= groups; ++i)
+			bounds.push_back(runs.size() * i / groups);
+		std::vector< std::vector<Out> > level(groups);
+		GroupMergeJob<It, Out, Less, Reduce> group_job(runs, bounds, level, less, reduce);
+		ParallelRunner< GroupMergeJob<It, Out, Less, Reduce> >(group_job, groups).run(threads);
+		while (level.size() > 1)
+		{
+			std::vector< std::vector<Out> > next((level.size() + 1) / 2);
+			PairMergeJob<Out, Less, Reduce> pair_job(level, next, less, reduce);
+			ParallelRunner< PairMergeJob<Out, Less, Reduce> >(pair_job, next.size()).run(threads);
+			level.swap(next);
+		}
+		if (out.empty())
+			out.swap(level[0]);
+		else
+			out.insert(out.end(), level[0].begin(), level[0].end());
+	}
+}
+
+#endif
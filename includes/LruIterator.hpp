@@ -0,0 +1,93 @@
+#ifndef LRUITERATOR_HPP
+# define LRUITERATOR_HPP
+
+#include "iterator.hpp"
+#include "LruNode.hpp"
+
+namespace ft
+{
+	// iterator of lru_cache, from the most to the least recently used entry; the list's
+	// sentinel link is end()
+	template <typename T, typename Pointer = T*, typename Reference = T&>
+	class LruIterator : public ft::iterator<ft::bidirectional_iterator_tag, T>
+	{
+		public :
+			typedef const T		value_type;
+			typedef Pointer		pointer;
+			typedef Reference	reference;
+			typedef typename ft::iterator<ft::bidirectional_iterator_tag, T>::difference_type	difference_type;
+			typedef typename ft::iterator<ft::bidirectional_iterator_tag, T>::iterator_category	iterator_category;
+			typedef ft::LruNode<T>	node_type;
+
+		protected :
+			LruLink*	_link;
+
+		public:
+
+			LruIterator() : _link(NULL) {}
+			explicit LruIterator(LruLink* link) : _link(link) {}
+			LruIterator(const LruIterator& copy) : _link(copy.base()) {}
+			// iterator to const_iterator
+			template <typename P>
+			LruIterator(const LruIterator<T, P, T&>& copy) : _link(copy.base()) {}
+			LruIterator& operator=(const LruIterator& copy)
+			{
+				if (this != &copy)
+					this->_link = copy.base();
+				return (*this);
+			}
+			virtual ~LruIterator() {}
+
+			LruLink* base() const
+			{
+				return (this->_link);
+			}
+
+			reference operator*() const
+			{
+				return (static_cast<node_type*>(this->_link)->value);
+			}
+			pointer operator->() const
+			{
+				return (&(operator*()));
+			}
+
+			LruIterator& operator++()
+			{
+				this->_link = this->_link->next;
+				return (*this);
+			}
+
+			LruIterator operator++(int)
+			{
+				LruIterator tmp = *this;
+				++(*this);
+				return (tmp);
+			}
+
+			LruIterator& operator--()
+			{
+				this->_link = this->_link->prev;
+				return (*this);
+			}
+
+			LruIterator operator--(int)
+			{
+				LruIterator tmp = *this;
+				--(*this);
+				return (tmp);
+			}
+
+			bool operator==(const LruIterator& iter) const
+			{
+				return (this->_link == iter.base());
+			}
+
+			bool operator!=(const LruIterator& iter) const
+			{
+				return (!(*this == iter));
+			}
+	};
+}
+
+#endif
@@ -0,0 +1,48 @@
+#ifndef LRUNODE_HPP
+# define LRUNODE_HPP
+
+#include <cstddef>
+
+namespace ft
+{
+	// place in lru_cache's recency list, a ring through one sentinel link: next goes
+	// towards less recently used entries, the sentinel's next is the most recent one
+	struct LruLink {
+		LruLink*	prev;
+		LruLink*	next;
+
+		LruLink() : prev(this), next(this) {}
+
+		// moves this link just after at
+		void link_after(LruLink* at)
+		{
+			this->prev = at;
+			this->next = at->next;
+			at->next->prev = this;
+			at->next = this;
+		}
+
+		void unlink()
+		{
+			this->prev->next = this->next;
+			this->next->prev = this->prev;
+		}
+	};
+
+	// entry of lru_cache, one allocation holding the value, its recency links and its
+	// hash chain, with the hash and weight kept to rehash and evict without recomputing
+	template <typename T>
+	struct LruNode : public LruLink {
+		T			value;
+		LruNode*	chain;
+		size_t		hash;
+		size_t		weight;
+
+		LruNode(const T& val, size_t h, size_t w) : LruLink(), value(val), chain(NULL), hash(h), weight(w) {}
+
+		template <typename K, typename V>
+		LruNode(const K& k, const V& v, size_t h, size_t w) : LruLink(), value(k, v), chain(NULL), hash(h), weight(w) {}
+	};
+}
+
+#endif
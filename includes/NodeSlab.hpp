@@ -0,0 +1,37 @@
+#ifndef NODESLAB_HPP
+# define NODESLAB_HPP
+
+#include <cstddef>
+
+namespace ft
+{
+	// layouts RBTree::compact() can lay nodes out in: key order, for scans, or van Emde
+	// Boas order, which keeps every few levels of a subtree together for lookups
+	enum CompactOrder { IN_ORDER, VEB_ORDER };
+
+	// one contiguous block of nodes and one of values filled by RBTree::compact(); slot i
+	// of the node block owns slot i of the value block. The block is given back once
+	// every node moved into it has been erased or moved out again.
+	template <typename Node, typename Value>
+	struct NodeSlab {
+		Node*	nodes;
+		Value*	values;
+		size_t	capacity;
+		size_t	used;	// slots handed out, filled from the front
+		size_t	live;	// handed out and not freed yet
+
+		NodeSlab(Node* n, Value* v, size_t c) : nodes(n), values(v), capacity(c), used(0), live(0) {}
+
+		bool contains(const Node* node) const
+		{
+			return (node >= this->nodes && node < this->nodes + this->capacity);
+		}
+
+		bool full() const
+		{
+			return (this->used == this->capacity);
+		}
+	};
+}
+
+#endif
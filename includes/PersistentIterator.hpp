@@ -0,0 +1,100 @@
+#ifndef PERSISTENTITERATOR_HPP
+# define PERSISTENTITERATOR_HPP
+
+#include "iterator.hpp"
+
+namespace ft
+{
+	// iterator of persistent_map: a slot number plus the tree, so it survives the
+	// remapping done when the file grows (0 is end())
+	template <typename Tree, typename T, typename Pointer = T*, typename Reference = T&>
+	class PersistentIterator : public ft::iterator<ft::bidirectional_iterator_tag, T>
+	{
+		public :
+			typedef const T		value_type;
+			typedef Pointer		pointer;
+			typedef Reference	reference;
+			typedef typename ft::iterator<ft::bidirectional_iterator_tag, T>::difference_type	difference_type;
+			typedef typename ft::iterator<ft::bidirectional_iterator_tag, T>::iterator_category	iterator_category;
+
+		protected :
+			const Tree*	_tree;
+			size_t		_pos;
+
+		public:
+
+			PersistentIterator() : _tree(NULL), _pos(0) {}
+			PersistentIterator(const Tree* tree, size_t pos) : _tree(tree), _pos(pos) {}
+			PersistentIterator(const PersistentIterator& copy) : _tree(copy.tree()), _pos(copy.base()) {}
+			// iterator to const_iterator
+			template <typename P>
+			PersistentIterator(const PersistentIterator<Tree, T, P, T&>& copy) : _tree(copy.tree()), _pos(copy.base()) {}
+			PersistentIterator& operator=(const PersistentIterator& copy)
+			{
+				if (this != &copy)
+				{
+					this->_tree = copy.tree();
+					this->_pos = copy.base();
+				}
+				return (*this);
+			}
+			virtual ~PersistentIterator() {}
+
+			size_t base() const
+			{
+				return (this->_pos);
+			}
+
+			const Tree* tree() const
+			{
+				return (this->_tree);
+			}
+
+			reference operator*() const
+			{
+				return (this->_tree->value(this->_pos));
+			}
+			pointer operator->() const
+			{
+				return (&(operator*()));
+			}
+
+			PersistentIterator& operator++()
+			{
+				this->_pos = this->_tree->next(this->_pos);
+				return (*this);
+			}
+
+			PersistentIterator operator++(int)
+			{
+				PersistentIterator tmp = *this;
+				++(*this);
+				return (tmp);
+			}
+
+			PersistentIterator& operator--()
+			{
+				this->_pos = this->_tree->prev(this->_pos);
+				return (*this);
+			}
+
+			PersistentIterator operator--(int)
+			{
+				PersistentIterator tmp = *this;
+				--(*this);
+				return (tmp);
+			}
+
+			bool operator==(const PersistentIterator& iter) const
+			{
+				return (this->_pos == iter.base());
+			}
+
+			bool operator!=(const PersistentIterator& iter) const
+			{
+				return (!(*this == iter));
+			}
+	};
+}
+
+#endif
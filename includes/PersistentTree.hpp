@@ -0,0 +1,612 @@
+#ifndef PERSISTENTTREE_HPP
+# define PERSISTENTTREE_HPP
+
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <typeinfo>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "utils.hpp"
+#include "RBTreeNode.hpp"
+
+namespace ft
+{
+	// first bytes of a persistent_map file
+	struct PersistentHeader {
+		char	magic[8];
+		size_t	node_size;	// sizeof(node), with type_hash rejects other key/value types
+		size_t	type_hash;	// hash of the value type's name
+		size_t	dirty;		// written to since the last checkpoint or close
+		size_t	capacity;	// node slots in the file, slot 0 is the nil sentinel
+		size_t	used;		// slots handed out so far
+		size_t	free;		// erased slots, chained through right
+		size_t	root;
+		size_t	size;
+		size_t	max;		// cached for --end()
+	};
+
+	// links are slot numbers, not pointers, so the file can be mapped at any address
+	template <typename T>
+	struct PersistentNode {
+		size_t	parent;
+		size_t	left;
+		size_t	right;
+		RBColor	color;
+		T		value;
+	};
+
+	// red-black tree stored in a file-backed MAP_SHARED mapping. T must be a POD-like
+	// type: values are written with a byte copy and never destroyed. The mapping grows
+	// by doubling (ftruncate + remap), which moves it: slot numbers stay valid, pointers
+	// and references into values do not. A file still marked dirty when opened was left
+	// by a writer that neither checkpointed nor closed it: the tree is verified first.
+	template <typename T, typename Compare>
+	class PersistentTree {
+		public :
+			typedef T	value_type;
+			typedef size_t	size_type;
+			typedef PersistentNode<T>	node_type;
+
+		private :
+			int			_fd;
+			char*		_base;
+			size_t		_bytes;
+			std::string	_path;
+			Compare		_comp;
+
+			PersistentTree(const PersistentTree&);
+			PersistentTree& operator=(const PersistentTree&);
+
+		public :
+			// opens path, or creates it with room for capacity values
+			PersistentTree(const std::string& path, size_type capacity) : _fd(-1), _base(NULL), _bytes(0), _path(path), _comp()
+			{
+				this->_fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+				if (this->_fd < 0)
+					fail("open");
+				struct stat st;
+				if (::fstat(this->_fd, &st) < 0)
+					fail("fstat");
+				if (st.st_size == 0)
+				{
+					if (capacity < 1)
+						capacity = 1;
+					resize_file(capacity + 1);
+					PersistentHeader& head = header();
+					head.node_size = sizeof(node_type);
+					head.type_hash = type_hash();
+					head.dirty = 0;
+					head.capacity = capacity + 1;
+					reset();
+					// last, so that a file cut short here is never taken for a map
+					std::memcpy(head.magic, "ftpmap2", 8);
+					return ;
+				}
+				if (static_cast<size_t>(st.st_size) < sizeof(PersistentHeader))
+					fail("truncated file", 0);
+				map_file(static_cast<size_t>(st.st_size));
+				const PersistentHeader& head = header();
+				if (std::memcmp(head.magic, "ftpmap2", 8) != 0 || head.node_size != sizeof(node_type)
+					|| head.type_hash != type_hash() || this->_bytes < file_bytes(head.capacity))
+					fail("not a file of this map type", 0);
+				if (head.dirty != 0 && !verify())
+					fail("tree left inconsistent by an interrupted write", 0);
+			}
+
+			// a clean close flushes the mapping, value-only writes through operator[] and
+			// iterators included, and only then marks the file clean on disk
+			~PersistentTree()
+			{
+				if (this->_base != NULL && ::msync(this->_base, this->_bytes, MS_SYNC) == 0 && header().dirty != 0)
+				{
+					header().dirty = 0;
+					::msync(this->_base, sizeof(PersistentHeader), MS_SYNC);
+				}
+				close_file();
+			}
+
+			const std::string& path() const
+			{
+				return (this->_path);
+			}
+
+			size_type size() const
+			{
+				return (header().size);
+			}
+
+			size_type capacity() const
+			{
+				return (header().capacity - 1);
+			}
+
+			// flushes the mapping and the file to disk before returning, then marks it clean
+			void checkpoint()
+			{
+				if (::msync(this->_base, this->_bytes, MS_SYNC) < 0)
+					fail("msync", errno, false);
+				if (::fsync(this->_fd) < 0)
+					fail("fsync", errno, false);
+				if (header().dirty != 0)
+				{
+					header().dirty = 0;
+					sync_header();
+				}
+			}
+
+			void reserve(size_type n)
+			{
+				if (n + 1 > header().capacity)
+				{
+					resize_file(n + 1);
+					header().capacity = n + 1;
+				}
+			}
+
+			// keeps the file size, the slots are reused
+			void clear()
+			{
+				touch();
+				reset();
+			}
+
+			T& value(size_t pos) const
+			{
+				return (node(pos).value);
+			}
+
+			size_t begin() const
+			{
+				return (header().root == 0 ? 0 : minimum(header().root));
+			}
+
+			// the end position is 0, its predecessor the max
+			size_t next(size_t pos) const
+			{
+				if (node(pos).right != 0)
+					return (minimum(node(pos).right));
+				size_t parent = node(pos).parent;
+				while (parent != 0 && pos == node(parent).right)
+				{
+					pos = parent;
+					parent = node(parent).parent;
+				}
+				return (parent);
+			}
+
+			size_t prev(size_t pos) const
+			{
+				if (pos == 0)
+					return (header().max);
+				if (node(pos).left != 0)
+					return (maximum(node(pos).left));
+				size_t parent = node(pos).parent;
+				while (parent != 0 && pos == node(parent).left)
+				{
+					pos = parent;
+					parent = node(parent).parent;
+				}
+				return (parent);
+			}
+
+			template <typename Key>
+			size_t find(const Key& key) const
+			{
+				size_t res = lower_bound(key);
+				if (res != 0 && this->_comp(key, node(res).value))
+					return (0);
+				return (res);
+			}
+
+			template <typename Key>
+			size_t lower_bound(const Key& key) const
+			{
+				size_t pos = header().root;
+				size_t res = 0;
+				while (pos != 0)
+				{
+					if (!this->_comp(node(pos).value, key))
+					{
+						res = pos;
+						pos = node(pos).left;
+					}
+					else
+						pos = node(pos).right;
+				}
+				return (res);
+			}
+
+			template <typename Key>
+			size_t upper_bound(const Key& key) const
+			{
+				size_t pos = header().root;
+				size_t res = 0;
+				while (pos != 0)
+				{
+					if (this->_comp(key, node(pos).value))
+					{
+						res = pos;
+						pos = node(pos).left;
+					}
+					else
+						pos = node(pos).right;
+				}
+				return (res);
+			}
+
+			// slot of val, inserted unless an equal value is already there
+			ft::pair<size_t, bool> insert(const T& val)
+			{
+				size_t parent = 0;
+				size_t last_right = 0;
+				bool left = false;
+				for (size_t pos = header().root; pos != 0; )
+				{
+					parent = pos;
+					left = this->_comp(val, node(pos).value);
+					if (!left)
+						last_right = pos;
+					pos = (left ? node(pos).left : node(pos).right);
+				}
+				if (last_right != 0 && !this->_comp(node(last_right).value, val))
+					return (ft::make_pair(last_right, false));
+
+				touch();
+				size_t pos = allocate_node();
+				node_type& n = node(pos);
+				new (&n.value) T(val);
+				n.parent = parent;
+				n.left = 0;
+				n.right = 0;
+				n.color = RED;
+				if (parent == 0)
+					header().root = pos;
+				else if (left)
+					node(parent).left = pos;
+				else
+					node(parent).right = pos;
+				if (parent == header().max && !left)
+					header().max = pos;
+				insert_fixup(pos);
+				header().size++;
+				return (ft::make_pair(pos, true));
+			}
+
+			void erase(size_t pos)
+			{
+				touch();
+				size_t target = pos;
+				RBColor removed = node(target).color;
+				size_t child;
+				if (node(pos).left == 0)
+				{
+					child = node(pos).right;
+					transplant(pos, child);
+				}
+				else if (node(pos).right == 0)
+				{
+					child = node(pos).left;
+					transplant(pos, child);
+				}
+				else
+				{
+					target = minimum(node(pos).right);
+					removed = node(target).color;
+					child = node(target).right;
+					if (node(target).parent == pos)
+						node(child).parent = target;
+					else
+					{
+						transplant(target, child);
+						node(target).right = node(pos).right;
+						node(node(target).right).parent = target;
+					}
+					transplant(pos, target);
+					node(target).left = node(pos).left;
+					node(node(target).left).parent = target;
+					node(target).color = node(pos).color;
+				}
+				if (removed == BLACK)
+					erase_fixup(child);
+				node(0).parent = 0;
+				node(0).color = BLACK;
+				if (pos == header().max)
+					header().max = (header().root == 0 ? 0 : maximum(header().root));
+				header().size--;
+				node(pos).right = header().free;
+				header().free = pos;
+			}
+
+			// checks the red-black invariants, ordering, parent links and the size, O(n).
+			// Safe on a tree cut short mid-write: no walk goes past size nodes
+			bool verify() const
+			{
+				size_t root = header().root;
+				if (node(0).color != BLACK || root >= header().used
+					|| (root != 0 && (node(root).color != BLACK || node(root).parent != 0)))
+					return (false);
+				size_t count = 0;
+				if (root != 0 && black_height(root, count) == 0)
+					return (false);
+				if (count != header().size || header().max != (root == 0 ? 0 : maximum(root)))
+					return (false);
+				for (size_t pos = begin(), last = 0; pos != 0; last = pos, pos = next(pos))
+				{
+					if (last != 0 && !this->_comp(node(last).value, node(pos).value))
+						return (false);
+				}
+				return (true);
+			}
+
+		private :
+			PersistentHeader& header() const
+			{
+				return (*reinterpret_cast<PersistentHeader*>(this->_base));
+			}
+
+			node_type& node(size_t pos) const
+			{
+				return (reinterpret_cast<node_type*>(this->_base + sizeof(PersistentHeader))[pos]);
+			}
+
+			static size_t file_bytes(size_t slots)
+			{
+				return (sizeof(PersistentHeader) + slots * sizeof(node_type));
+			}
+
+			// the mangled name, the same for every build of one ABI
+			static size_t type_hash()
+			{
+				return (ft::hash<std::string>()(typeid(T).name()));
+			}
+
+			// the first write after a checkpoint marks the file dirty on disk before it
+			// changes the tree
+			void touch()
+			{
+				if (header().dirty == 0)
+				{
+					header().dirty = 1;
+					sync_header();
+				}
+			}
+
+			void sync_header()
+			{
+				if (::msync(this->_base, sizeof(PersistentHeader), MS_SYNC) < 0)
+					fail("msync", errno, false);
+			}
+
+			void reset()
+			{
+				PersistentHeader& head = header();
+				head.used = 1;
+				head.free = 0;
+				head.root = 0;
+				head.size = 0;
+				head.max = 0;
+				std::memset(static_cast<void*>(&node(0)), 0, sizeof(node_type));
+				node(0).color = BLACK;
+			}
+
+			size_t allocate_node()
+			{
+				PersistentHeader* head = &header();
+				if (head->free != 0)
+				{
+					size_t res = head->free;
+					head->free = node(res).right;
+					return (res);
+				}
+				if (head->used == head->capacity)
+				{
+					size_t slots = head->capacity * 2;
+					resize_file(slots);
+					head = &header();
+					head->capacity = slots;
+				}
+				return (head->used++);
+			}
+
+			void resize_file(size_t slots)
+			{
+				if (::ftruncate(this->_fd, static_cast<off_t>(file_bytes(slots))) < 0)
+					fail("ftruncate", errno, false);
+				if (this->_base != NULL)
+					::munmap(this->_base, this->_bytes);
+				this->_base = NULL;
+				map_file(file_bytes(slots));
+			}
+
+			void map_file(size_t bytes)
+			{
+				void* addr = ::mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, this->_fd, 0);
+				if (addr == MAP_FAILED)
+					fail("mmap");
+				this->_base = static_cast<char*>(addr);
+				this->_bytes = bytes;
+			}
+
+			void close_file()
+			{
+				if (this->_base != NULL)
+					::munmap(this->_base, this->_bytes);
+				if (this->_fd >= 0)
+					::close(this->_fd);
+				this->_base = NULL;
+				this->_fd = -1;
+			}
+
+			// throws std::runtime_error; a constructor failure also releases the file
+			void fail(const char* what, int err = errno, bool release = true)
+			{
+				std::string msg = std::string("persistent_map: ") + this->_path + ": " + what;
+				if (err != 0)
+					msg += std::string(": ") + std::strerror(err);
+				if (release)
+					close_file();
+				throw std::runtime_error(msg);
+			}
+
+			size_t minimum(size_t pos) const
+			{
+				while (node(pos).left != 0)
+					pos = node(pos).left;
+				return (pos);
+			}
+
+			size_t maximum(size_t pos) const
+			{
+				while (node(pos).right != 0)
+					pos = node(pos).right;
+				return (pos);
+			}
+
+			// black nodes down to nil, 0 if unbalanced, two reds touch, a link is broken or
+			// there are more nodes than size
+			size_t black_height(size_t pos, size_t& count) const
+			{
+				if (pos == 0)
+					return (1);
+				if (pos >= header().used || ++count > header().size)
+					return (0);
+				const node_type& n = node(pos);
+				if (n.left >= header().used || n.right >= header().used)
+					return (0);
+				if (n.color == RED && (node(n.left).color == RED || node(n.right).color == RED))
+					return (0);
+				if ((n.left != 0 && node(n.left).parent != pos) || (n.right != 0 && node(n.right).parent != pos))
+					return (0);
+				size_t left = black_height(n.left, count);
+				size_t right = black_height(n.right, count);
+				if (left == 0 || left != right)
+					return (0);
+				return (left + (n.color == BLACK ? 1 : 0));
+			}
+
+			void transplant(size_t pos, size_t child)
+			{
+				size_t parent = node(pos).parent;
+				if (parent == 0)
+					header().root = child;
+				else if (pos == node(parent).left)
+					node(parent).left = child;
+				else
+					node(parent).right = child;
+				node(child).parent = parent;
+			}
+
+			void rotate_left(size_t pos)
+			{
+				size_t child = node(pos).right;
+				node(pos).right = node(child).left;
+				if (node(child).left != 0)
+					node(node(child).left).parent = pos;
+				transplant(pos, child);
+				node(child).left = pos;
+				node(pos).parent = child;
+			}
+
+			void rotate_right(size_t pos)
+			{
+				size_t child = node(pos).left;
+				node(pos).left = node(child).right;
+				if (node(child).right != 0)
+					node(node(child).right).parent = pos;
+				transplant(pos, child);
+				node(child).right = pos;
+				node(pos).parent = child;
+			}
+
+			void insert_fixup(size_t pos)
+			{
+				while (node(node(pos).parent).color == RED)
+				{
+					size_t parent = node(pos).parent;
+					size_t grand = node(parent).parent;
+					bool left = (parent == node(grand).left);
+					size_t uncle = (left ? node(grand).right : node(grand).left);
+					if (node(uncle).color == RED)
+					{
+						node(parent).color = BLACK;
+						node(uncle).color = BLACK;
+						node(grand).color = RED;
+						pos = grand;
+						continue ;
+					}
+					if (pos == (left ? node(parent).right : node(parent).left))
+					{
+						pos = parent;
+						if (left)
+							rotate_left(pos);
+						else
+							rotate_right(pos);
+						parent = node(pos).parent;
+					}
+					node(parent).color = BLACK;
+					node(grand).color = RED;
+					if (left)
+						rotate_right(grand);
+					else
+						rotate_left(grand);
+				}
+				node(header().root).color = BLACK;
+			}
+
+			// pos carries an extra black; nil's parent was set by transplant
+			void erase_fixup(size_t pos)
+			{
+				while (pos != header().root && node(pos).color == BLACK)
+				{
+					size_t parent = node(pos).parent;
+					bool left = (pos == node(parent).left);
+					size_t sibling = (left ? node(parent).right : node(parent).left);
+					if (node(sibling).color == RED)
+					{
+						node(sibling).color = BLACK;
+						node(parent).color = RED;
+						if (left)
+							rotate_left(parent);
+						else
+							rotate_right(parent);
+						sibling = (left ? node(parent).right : node(parent).left);
+					}
+					size_t near = (left ? node(sibling).left : node(sibling).right);
+					size_t far = (left ? node(sibling).right : node(sibling).left);
+					if (node(near).color == BLACK && node(far).color == BLACK)
+					{
+						node(sibling).color = RED;
+						pos = parent;
+						continue ;
+					}
+					if (node(far).color == BLACK)
+					{
+						node(near).color = BLACK;
+						node(sibling).color = RED;
+						if (left)
+							rotate_right(sibling);
+						else
+							rotate_left(sibling);
+						sibling = (left ? node(parent).right : node(parent).left);
+						far = (left ? node(sibling).right : node(sibling).left);
+					}
+					node(sibling).color = node(parent).color;
+					node(parent).color = BLACK;
+					node(far).color = BLACK;
+					if (left)
+						rotate_left(parent);
+					else
+						rotate_right(parent);
+					pos = header().root;
+				}
+				node(pos).color = BLACK;
+			}
+	};
+}
+
+#endif
@@ -2,14 +2,22 @@
 # define RBTREE_HPP
 
 #include <stdexcept>
+#include <vector>
 #include "RBTreeIterator.hpp"
+#include "RBTreeStats.hpp"
+#include "NodeSlab.hpp"
+#include "HotCounters.hpp"
+#include "RBTreeBalance.hpp"
+#include "parallel.hpp"
 #include "printMap.hpp"
 
 namespace ft
 {
 
-	template < typename T, typename Compare = ft::less<T>, typename Alloc = std::allocator<T> >
-	class RBTree {
+	// Balance picks the rebalancing scheme (RBBalance, AVLBalance or WBBalance), see RBTreeBalance.hpp
+	template < typename T, typename Compare = ft::less<T>, typename Alloc = std::allocator<T>,
+		typename Balance = ft::RBBalance, typename Counter = ft::DefaultCountingPolicy >
+	class RBTree : private Counter {
 		public :
 
 			typedef T	value_type;
@@ -19,33 +27,45 @@ namespace ft
 			typedef const T&	const_reference;
 			typedef Compare	value_comp;
 			typedef Alloc	allocator_type;
+			typedef Balance	balance_policy;
 			typedef size_t	size_type;
 			typedef ft::RBTreeNode<T>	node_type;
 			typedef typename ft::RBTreeIterator<T, T*, T&>	iterator;
 			typedef typename ft::RBTreeIterator<T, const T*, const T&>	const_iterator;
 			typedef typename Alloc::template rebind<node_type>::other	node_allocator_type;
+			typedef ft::NodeSlab<node_type, value_type>	slab_type;
+
+			using Counter::hot_counters;
+			using Counter::reset_hot_counters;
 
 		private:
+			enum { ERASE_IF_REBUILD = 8 };
 
 			node_type*	_root;
 			node_type*	_nil;
 			size_type	_size;
 			value_comp	_comp;
 			node_allocator_type	_node_alloc;
+			std::vector<slab_type>	_slabs;			// blocks filled by compact(), the last one while compacting
+			node_type*	_compact_cursor;	// next node compact_step() moves, NULL when no pass runs
+			size_type	_dead;			// nodes erased in lazy mode and still linked, not in _size
+			double		_max_dead;		// share of dead nodes that triggers purge(), 0 when erase is eager
 
 		public:
 
-			RBTree() : _root(NULL), _nil(NULL), _size(0), _comp(value_comp()), _node_alloc(node_allocator_type())
+			RBTree() : _root(NULL), _nil(NULL), _size(0), _comp(value_comp()), _node_alloc(node_allocator_type()), _compact_cursor(NULL),
+				_dead(0), _max_dead(0)
 			{
 				this->_nil = make_nil();
 				this->_root = this->_nil;
 			}
 
-			RBTree(const RBTree& x) : _root(NULL), _nil(NULL), _size(0), _comp(value_comp()), _node_alloc(node_allocator_type())
+			RBTree(const RBTree& x) : _root(NULL), _nil(NULL), _size(0), _comp(value_comp()), _node_alloc(node_allocator_type()), _compact_cursor(NULL),
+				_dead(0), _max_dead(0)
 			{
 				this->_nil = make_nil();
+				this->_root = this->_nil;
 				copy(x);
-				this->_nil->parent = get_max_value_node();
 			}
 
 			~RBTree()
@@ -72,7 +92,8 @@ namespace ft
 			{
 				if (node->value == NULL)
 					return ;
-				insert(*node->value);
+				if (!node->dead)
+					insert(*node->value);
 				if (node->leftChild->value != NULL)
 					copy(node->leftChild);
 				if (node->rightChild->value != NULL)
@@ -84,6 +105,8 @@ namespace ft
 				node_type* tmp = this->_root;
 				while (tmp->leftChild->value != NULL)
 					tmp = tmp->leftChild;
+				if (tmp->dead)
+					return ((++iterator(tmp)).base());
 				return (tmp);
 			}
 
@@ -92,6 +115,11 @@ namespace ft
 				return (this->_nil);
 			}
 
+			node_type* get_root() const
+			{
+				return (this->_root);
+			}
+
 			bool empty() const
 			{
 				return (this->_size == 0);
@@ -110,40 +138,118 @@ namespace ft
 
 			ft::pair<node_type*, bool> insert(const value_type& val, node_type* hint = NULL)
 			{
-				node_type* new_node = make_node(val);
-				node_type* position = this->_root;
 				if (this->_size == 0)
+					return ft::make_pair(link_root(make_node(val)), true);
+				int side = 0;
+				node_type* position = locate(val, hint, side);
+				return (insert_at(position, side, val));
+			}
+
+#ifdef FT_CXX11
+			// val is moved into the new node, and left alone when the key is taken
+			ft::pair<node_type*, bool> insert(value_type&& val, node_type* hint = NULL)
+			{
+				if (this->_size == 0)
+					return ft::make_pair(link_root(make_node(std::move(val))), true);
+				int side = 0;
+				node_type* position = locate(val, hint, side);
+				if (side == 0 && position->dead)
+					return (ft::make_pair(revive(position, std::move(val)), true));
+				if (side == 0)
+					return (ft::make_pair(position, false));
+				return (ft::make_pair(link_at(position, side, make_node(std::move(val))), true));
+			}
+
+			// the value is built in a new node from args first, as its key is only known
+			// then, and the node is freed again if the key is taken
+			template <typename... Args>
+			ft::pair<node_type*, bool> emplace(node_type* hint, Args&&... args)
+			{
+				node_type* node = make_node(std::forward<Args>(args)...);
+				if (this->_size == 0)
+					return (ft::make_pair(link_root(node), true));
+				int side = 0;
+				node_type* position = locate(*node->value, hint, side);
+				if (side != 0)
+					return (ft::make_pair(link_at(position, side, node), true));
+				bool revived = position->dead;
+				if (revived)
+					revive(position, std::move(*node->value));
+				free_node(node);
+				return (ft::make_pair(position, revived));
+			}
+#endif
+
+			// a node holding val that is not linked anywhere yet, for adopt_sorted();
+			// destroy_detached() frees it if it is never handed over
+			node_type* make_detached(const value_type& val)
+			{
+				return (make_node(val));
+			}
+
+			void destroy_detached(node_type* node)
+			{
+				free_node(node);
+			}
+
+			// links the detached nodes of [first, last), sorted ascending, starting each
+			// descent from where the previous node went rather than from the root: a node
+			// d positions further costs O(log d) steps, near nodes just visited. A node
+			// whose key is already in the tree, or earlier in the range, is freed, as
+			// insert() would keep the first; unsorted input only loses the speedup.
+			template <typename NodeIt>
+			void adopt_sorted(NodeIt first, NodeIt last)
+			{
+				node_type* finger = NULL;
+				for (; first != last; ++first)
 				{
-					this->_root = new_node;
-					this->_root->leftChild = this->_nil;
-					this->_root->rightChild = this->_nil;
-					this->_root->parent = this->_nil;
-					this->_root->color = BLACK;
-					this->_nil->parent = this->_root;
-					this->_size++;
-					return ft::make_pair(this->_root, true);
-				}
-				if (hint != NULL && hint->value != NULL)
-					position = check_hint(val, hint);
-				ft::pair<node_type*, bool> is_valid = get_position(position, new_node);
-				if (is_valid.second == false)
-				{
-					_node_alloc.destroy(new_node);
-					_node_alloc.deallocate(new_node, 1);
-					return (is_valid);
-				}
-				insert_case1(new_node);
-				this->_size++;
-				this->_nil->parent = get_max_value_node();
-				return (ft::make_pair(new_node, true));
+					node_type* node = *first;
+					if (this->_size == 0)
+					{
+						finger = link_root(node);
+						continue ;
+					}
+					node_type* from = this->_root;
+					if (finger != NULL && compare(*finger->value, *node->value))
+						from = climb(finger, *node->value);
+					int side = 0;
+					node_type* position = get_position(*node->value, side, from, is_three_way<Compare>());
+					if (side != 0)
+					{
+						finger = link_at(position, side, node);
+						continue ;
+					}
+					if (position->dead)
+						revive(position, *node->value);
+					finger = position;
+					free_node(node);
+				}
 			}
 
 
 			size_type erase(node_type* node)
 			{
-				if (node->value == NULL)
+				if (node->value == NULL || node->dead)
 					return (0);
+				if (node == this->_compact_cursor)
+					this->_compact_cursor = (++iterator(node)).base();
+				if (this->_max_dead > 0)
+				{
+					bury(node);
+					if (this->_size == 0 || this->_dead > this->_max_dead * (this->_size + this->_dead))
+						purge();
+					return (1);
+				}
 
+				// the max only changes when it goes, to its predecessor: the max has no right
+				// child, so that is the end of its left subtree's right spine or its parent
+				node_type* max = this->_nil->parent;
+				if (node == max)
+				{
+					max = (node->leftChild->value != NULL ? node->leftChild : node->parent);
+					while (max != node->parent && max->rightChild->value != NULL)
+						max = max->rightChild;
+				}
 				node_type* target = replace_erase_node(node);
 				node_type* child;
 				if (target->rightChild->value == NULL)
@@ -152,21 +258,52 @@ namespace ft
 					child = target->rightChild;
 
 				replace_node(target, child);
-				if (target->color == BLACK)
-				{
-					if (child->color == RED)
-						child->color = BLACK;
-					else
-						delete_case1(child);
-				}
+				Balance::erase_fixup(target, child, this->_root, static_cast<const Counter&>(*this));
 				this->_size--;
 				if (target->parent->value == NULL)
 					this->_root = this->_nil;
-				delete target;
-				this->_nil->parent = get_max_value_node();
+				free_node(target);
+				this->_nil->parent = max;
 				return (1);
 			}
 
+			// erases every live value pred holds for, in one in-order pass, and returns how
+			// many. Victims are erased as they are met, while their neighbourhood is still
+			// in cache; once a sixteenth of the values has been seen and fewer than one in
+			// ERASE_IF_REBUILD survived, the rest are only marked dead and purge() relinks
+			// the survivors in linear time rather than rebalancing once per victim.
+			// Iterators to survivors stay valid.
+			template <typename Predicate>
+			size_type erase_if(Predicate& pred)
+			{
+				if (this->_size == 0)
+					return (0);
+				size_type total = this->_size;
+				size_type seen = 0;
+				size_type res = 0;
+				bool rebuild = false;
+				node_type* node = get_begin();
+				while (node != this->_nil)
+				{
+					node_type* next = (++iterator(node)).base();
+					++seen;
+					if (pred(static_cast<const value_type&>(*node->value)))
+					{
+						++res;
+						if (!rebuild && seen * 16 >= total && (seen - res) * ERASE_IF_REBUILD < seen)
+							rebuild = true;
+						if (rebuild)
+							bury(node);
+						else
+							erase(node);
+					}
+					node = next;
+				}
+				if (rebuild)
+					purge();
+				return (res);
+			}
+
 			void swap(RBTree& x)
 			{
 				swap(_root, x._root);
@@ -174,6 +311,10 @@ namespace ft
 				swap(_comp, x._comp);
 				swap(_node_alloc, x._node_alloc);
 				swap(_size, x._size);
+				_slabs.swap(x._slabs);
+				swap(_compact_cursor, x._compact_cursor);
+				swap(_dead, x._dead);
+				swap(_max_dead, x._max_dead);
 			}
 
 			void clear(node_type* node = NULL)
@@ -195,73 +336,282 @@ namespace ft
 				{
 					if (node == this->_root)
 						this->_root = this->_nil;
-					_node_alloc.destroy(node);
-					_node_alloc.deallocate(node, 1);
-					this->_size--;
+					if (node->dead)
+						this->_dead--;
+					else
+						this->_size--;
+					free_node(node);
 				}
+				if (this->_size == 0 && this->_dead == 0)
+					end_compaction();
+			}
+
+			// lazy erase: with max_dead > 0, erase() only marks the node dead and leaves it
+			// linked, and purge() runs once dead nodes are more than max_dead of all the
+			// nodes (or nothing is left alive). 0 makes erase eager again and purges now.
+			void set_lazy_erase(double max_dead)
+			{
+				this->_max_dead = (max_dead > 1 ? 1 : max_dead);
+				if (this->_max_dead <= 0)
+				{
+					this->_max_dead = 0;
+					purge();
+				}
+				else if (this->_size == 0 || this->_dead > this->_max_dead * (this->_size + this->_dead))
+					purge();
+			}
+
+			double lazy_erase() const
+			{
+				return (this->_max_dead);
+			}
+
+			size_type tombstones() const
+			{
+				return (this->_dead);
 			}
 
-			node_type* find(value_type val) const
+			// frees every dead node and relinks the live ones, in order and without moving
+			// them, into a perfectly balanced tree: one pass, no comparison, no rotation.
+			// Iterators to live elements stay valid.
+			void purge()
 			{
-				node_type* res = this->_root;
+				if (this->_dead == 0)
+					return ;
+				std::vector<node_type*> live;
+				live.reserve(this->_size);
+				collect_live(this->_root, live);
+				this->_root = link_sorted(live, 0, live.size(), this->_nil, 1, build_depth(live.size()));
+				this->_nil->parent = (live.empty() ? this->_nil : live.back());
 				if (this->_size == 0)
-					return (this->_nil);
-				while (res->value != NULL && (_comp(val, *res->value) || _comp(*res->value, val)))
+					end_compaction();
+			}
+
+			// moves every node, with its value, into one new contiguous block in the given
+			// order, keeping the shape; iterators and node pointers are invalidated
+			void compact(CompactOrder order = IN_ORDER)
+			{
+				end_compaction();
+				purge();
+				if (this->_size == 0)
+					return ;
+				if (order == IN_ORDER)
 				{
-					if (_comp(val, *res->value))
-						res = res->leftChild;
-					else
-						res = res->rightChild;
+					compact_step(this->_size);
+					return ;
 				}
-				return (res);
+				std::vector<node_type*> nodes;
+				nodes.reserve(this->_size);
+				veb_order(this->_root, subtree_height(this->_root), nodes);
+				begin_compaction();
+				for (size_type i = 0; i < nodes.size(); ++i)
+					relocate(nodes[i]);
+				end_compaction();
 			}
 
-			node_type* lower_bound(const value_type& val) const
+			// in-order compact() spread over several calls: moves up to budget more nodes,
+			// starting a pass when none is running, and returns true once the pass is over.
+			// The tree can be used between calls; nodes inserted meanwhile behind the
+			// cursor, or once the block is full, stay where they are until the next pass.
+			bool compact_step(size_type budget)
 			{
-				iterator it(get_begin());
-				iterator ite(get_end());
-				while (it != ite && _comp(*it, val))
-					it++;
-				return (it.base());
+				if (this->_compact_cursor == NULL)
+				{
+					purge();
+					if (this->_size == 0)
+						return (true);
+					begin_compaction();
+					this->_compact_cursor = get_begin();
+				}
+				while (budget > 0 && this->_compact_cursor != this->_nil && !this->_slabs.back().full())
+				{
+					node_type* moved = relocate(this->_compact_cursor);
+					this->_compact_cursor = (++iterator(moved)).base();
+					--budget;
+				}
+				if (this->_compact_cursor != this->_nil && !this->_slabs.back().full())
+					return (false);
+				end_compaction();
+				return (true);
 			}
 
-			node_type* upper_bound(const value_type& val) const
+			// replaces the content with the n values at first, which must be sorted and unique;
+			// the tree is built perfectly balanced from the middle element down with no
+			// comparison. With threads > 1 the subtrees below the top levels are built
+			// concurrently, so Alloc must then be safe to use from several threads.
+			template <typename RandomIt>
+			void build_sorted(RandomIt first, size_type n, unsigned int threads = 1)
 			{
-				iterator it(get_begin());
-				iterator ite(get_end());
-				while (it != ite && !_comp(val, *it))
-					it++;
-				return (it.base());
+				clear();
+				if (n == 0)
+					return ;
+				size_t max_depth = build_depth(n);
+				std::vector< BuildTask<RandomIt> > tasks;
+				size_t cut = (threads == 1 ? max_depth + 1 : split_depth(n) + 1);
+				plan_build(first, 0, n, &this->_root, this->_nil, 1, cut, max_depth, tasks);
+				BuildJob<RandomIt> job(*this, tasks, max_depth);
+				ParallelRunner< BuildJob<RandomIt> >(job, tasks.size()).run(threads);
+				finish_build(this->_root, 1, cut, max_depth);
+				this->_size = n;
+				this->_nil->parent = get_max_value_node();
+				for (size_type i = 0; i < n; ++i)
+					this->count_node_alloc();
 			}
 
-			void showMap() { ft::printMap(_root, 0); }
+			// lookups are templates so map can search by key without building a value_type,
+			// Key only has to be comparable with value_type through Compare
+			template <typename Key>
+			node_type* find(const Key& val) const
+			{
+				return (find(val, is_three_way<Compare>()));
+			}
 
-		private :
-			node_type* get_grandparent(node_type* node) const
+			// true when val and the node's value are equivalent under Compare
+			template <typename Key>
+			bool equivalent(const Key& val, node_type* node) const
 			{
-				if (node != NULL && node->parent != NULL)
-					return (node->parent->parent);
-				else
-					return (NULL);
+				return (equivalent(val, node, is_three_way<Compare>()));
 			}
 
-			node_type* get_uncle(node_type* node) const
+			// first node not less than val
+			template <typename Key>
+			node_type* lower_bound(const Key& val) const
 			{
-				node_type* grand = get_grandparent(node);
-				if (grand == NULL)
-					return (NULL);
-				if (grand->leftChild == node->parent)
-					return (grand->rightChild);
-				else
-					return (grand->leftChild);
+				return (lower_bound_below(this->_root, this->_nil, val));
 			}
 
-			node_type* get_sibling(node_type* node) const
+			// lower_bound() searched from finger, any node of the tree, instead of the root:
+			// climbs until the subtree under it spans val, then descends, so a result d
+			// nodes away from finger costs O(log d) and a far one at most twice a lookup
+			template <typename Key>
+			node_type* lower_bound_from(node_type* finger, const Key& val) const
 			{
-				if (node == node->parent->leftChild)
-					return (node->parent->rightChild);
+				if (finger == NULL || finger->value == NULL)
+					return (lower_bound(val));
+				node_type* node = finger;
+				node_type* res = this->_nil;
+				if (compare(*finger->value, val))
+				{
+					// val is to the right: up to a left child of something not less than val
+					while (node->parent->value != NULL)
+					{
+						if (node->parent->leftChild == node && !compare(*node->parent->value, val))
+						{
+							res = node->parent;
+							break ;
+						}
+						node = node->parent;
+					}
+				}
 				else
-					return (node->parent->leftChild);
+				{
+					// finger qualifies: up to a right child of something less than val
+					res = finger;
+					while (node->parent->value != NULL)
+					{
+						if (node->parent->rightChild == node && compare(*node->parent->value, val))
+							break ;
+						node = node->parent;
+					}
+				}
+				return (lower_bound_below(node, res, val));
+			}
+
+			// first node greater than val
+			template <typename Key>
+			node_type* upper_bound(const Key& val) const
+			{
+				node_type* node = this->_root;
+				node_type* res = this->_nil;
+				while (node->value != NULL)
+				{
+					if (compare(val, *node->value))
+					{
+						res = node;
+						node = node->leftChild;
+					}
+					else
+						node = node->rightChild;
+				}
+				if (res->dead)
+					return ((++iterator(res)).base());
+				return (res);
+			}
+
+			void showMap() const { ft::printMap(_root, 0); }
+
+			void exportDot(std::ostream& os) const { ft::printDot(os, _root); }
+
+			RBTreeStats tree_stats() const
+			{
+				RBTreeStats res;
+				size_t depth_sum = 0;
+				if (this->_root->value != NULL)
+					collect_stats(this->_root, 1, res, depth_sum);
+				if (res.node_count != 0)
+					res.average_depth = static_cast<double>(depth_sum) / res.node_count;
+				res.black_height = Balance::black_height(this->_root);
+				res.node_bytes = res.node_count * sizeof(node_type);
+				res.value_bytes = res.node_count * sizeof(value_type);
+				res.sentinel_bytes = sizeof(node_type);
+				res.total_bytes = res.node_bytes + res.value_bytes + res.sentinel_bytes;
+				res.tombstones = this->_dead;
+				res.valid = verify();
+				return (res);
+			}
+
+			// checks the balancing and bookkeeping invariants, O(n)
+			bool verify() const
+			{
+				if (this->_nil->value != NULL || this->_nil->color != BLACK)
+					return (false);
+				if (this->_root->value == NULL)
+					return (this->_size == 0);
+				if (this->_root->parent != this->_nil || this->_nil->rank != 0)
+					return (false);
+				if (this->_nil->parent != get_max_value_node())
+					return (false);
+				if (!Balance::verify(this->_root))
+					return (false);
+				size_type count = 0;
+				size_type dead = 0;
+				const value_type* prev = NULL;
+				return (check_links(this->_root, count, dead, prev) && count == this->_size + this->_dead && dead == this->_dead);
+			}
+
+		private :
+			void collect_stats(node_type* node, size_t depth, RBTreeStats& res, size_t& depth_sum) const
+			{
+				res.node_count++;
+				depth_sum += depth;
+				if (depth > res.height)
+					res.height = depth;
+				if (node->leftChild->value != NULL)
+					collect_stats(node->leftChild, depth + 1, res, depth_sum);
+				if (node->rightChild->value != NULL)
+					collect_stats(node->rightChild, depth + 1, res, depth_sum);
+			}
+
+			// in-order walk checking parent links and strict ordering
+			bool check_links(node_type* node, size_type& count, size_type& dead, const value_type*& prev) const
+			{
+				if (node->leftChild->value != NULL)
+				{
+					if (node->leftChild->parent != node || !check_links(node->leftChild, count, dead, prev))
+						return (false);
+				}
+				if (prev != NULL && !_comp(*prev, *node->value))
+					return (false);
+				prev = node->value;
+				count++;
+				if (node->dead)
+					dead++;
+				if (node->rightChild->value != NULL)
+				{
+					if (node->rightChild->parent != node || !check_links(node->rightChild, count, dead, prev))
+						return (false);
+				}
+				return (true);
 			}
 
 			node_type* get_max_value_node() const
@@ -284,337 +634,624 @@ namespace ft
 				return (res);
 			}
 
-			node_type* make_node(const value_type& val)
+#ifdef FT_CXX11
+			template <typename... Args>
+			node_type* make_node(Args&&... args)
+			{
+				this->count_node_alloc();
+				return (new_node(std::forward<Args>(args)...));
+			}
+
+			// make_node without the counter, safe to call from build workers
+			template <typename... Args>
+			node_type* new_node(Args&&... args)
 			{
 				node_type* res = _node_alloc.allocate(1);
-				_node_alloc.construct(res, node_type(val));
+				::new (static_cast<void*>(res)) node_type(ft::emplace_tag(), std::forward<Args>(args)...);
 				return (res);
 			}
-
-
-			node_type* check_hint(value_type val, node_type* hint)
+#else
+			node_type* make_node(const value_type& val)
 			{
-				if (_comp(*hint->value, *_root->value) && _comp(val, *hint->value))
-					return (hint);
-				else if (_comp(*hint->value, *_root->value) && _comp(*hint->value, val))
-					return (_root);
-				else if (_comp(*_root->value, *hint->value) && _comp(val, *hint->value))
-					return (_root);
-				else if (_comp(*_root->value, *hint->value) && _comp(*hint->value, val))
-					return (hint);
-				else
-					return (_root);
+				this->count_node_alloc();
+				return (new_node(val));
 			}
 
-			ft::pair<node_type*, bool> get_position(node_type* position, node_type* node)
+			// make_node without the counter, safe to call from build workers; the node is
+			// built in place, a temporary would copy the value twice
+			node_type* new_node(const value_type& val)
 			{
-				while (position->value != NULL)
+				node_type* res = _node_alloc.allocate(1);
+				::new (static_cast<void*>(res)) node_type(val);
+				return (res);
+			}
+#endif
+
+			// subtree of build_sorted left to a worker: values [lo, hi) hang from *slot
+			template <typename RandomIt>
+			struct BuildTask {
+				RandomIt	first;
+				size_t		lo;
+				size_t		hi;
+				node_type**	slot;
+				node_type*	parent;
+				size_t		depth;
+
+				BuildTask(RandomIt f, size_t l, size_t h, node_type** s, node_type* p, size_t d)
+					: first(f), lo(l), hi(h), slot(s), parent(p), depth(d) {}
+			};
+
+			template <typename RandomIt>
+			struct BuildJob {
+				RBTree&									tree;
+				const std::vector< BuildTask<RandomIt> >&	tasks;
+				size_t									max_depth;
+
+				BuildJob(RBTree& t, const std::vector< BuildTask<RandomIt> >& ts, size_t m) : tree(t), tasks(ts), max_depth(m) {}
+
+				void run(size_t i)
 				{
-					if (_comp(*node->value, *position->value))
-					{
-						if (position->leftChild->value == NULL)
-						{
-							position->leftChild = node;
-							node->parent = position;
-							node->leftChild = _nil;
-							node->rightChild = _nil;
-							node->color = RED;
-							break;
-						}
-						else
-							position = position->leftChild;
-					}
-					else if (_comp(*position->value, *node->value))
-					{
-						if (position->rightChild->value == NULL)
-						{
-							position->rightChild = node;
-							node->parent = position;
-							node->leftChild = _nil;
-							node->rightChild = _nil;
-							node->color = RED;
-							break;
-						}
-						else
-							position = position->rightChild;
-					}
-					else
-						return (ft::make_pair(position, false));
+					const BuildTask<RandomIt>& t = tasks[i];
+					*t.slot = tree.build_subtree(t.first, t.lo, t.hi, t.parent, t.depth, max_depth);
 				}
-				return (ft::make_pair(position, true));
-			}
+			};
 
-			node_type* replace_erase_node(node_type* node)
+			// builds the levels above cut here, queueing the subtrees at cut as tasks
+			template <typename RandomIt>
+			void plan_build(RandomIt first, size_t lo, size_t hi, node_type** slot, node_type* parent, size_t depth,
+				size_t cut, size_t max_depth, std::vector< BuildTask<RandomIt> >& tasks)
 			{
-
-				node_type* res;
-				if (node->leftChild->value != NULL)
+				if (lo == hi)
 				{
-					res = node->leftChild;
-					while (res->rightChild->value != NULL)
-						res = res->rightChild;
+					*slot = this->_nil;
+					return ;
 				}
-				else if (node->rightChild->value != NULL)
+				if (depth == cut)
 				{
-					res = node->rightChild;
-					while (res->leftChild->value != NULL)
-						res = res->leftChild;
+					*slot = this->_nil;
+					tasks.push_back(BuildTask<RandomIt>(first, lo, hi, slot, parent, depth));
+					return ;
 				}
-				else
-					return (node);
+				size_t mid = lo + (hi - lo) / 2;
+				node_type* node = new_node(first[mid]);
+				node->parent = parent;
+				*slot = node;
+				plan_build(first, lo, mid, &node->leftChild, node, depth + 1, cut, max_depth, tasks);
+				plan_build(first, mid + 1, hi, &node->rightChild, node, depth + 1, cut, max_depth, tasks);
+			}
 
-				node_type* tmp_parent = node->parent;
-				node_type* tmp_left = node->leftChild;
-				node_type* tmp_right = node->rightChild;
-				RBColor tmp_color = node->color;
+			template <typename RandomIt>
+			node_type* build_subtree(RandomIt first, size_t lo, size_t hi, node_type* parent, size_t depth, size_t max_depth)
+			{
+				if (lo == hi)
+					return (this->_nil);
+				size_t mid = lo + (hi - lo) / 2;
+				node_type* node = new_node(first[mid]);
+				node->parent = parent;
+				node->leftChild = build_subtree(first, lo, mid, node, depth + 1, max_depth);
+				node->rightChild = build_subtree(first, mid + 1, hi, node, depth + 1, max_depth);
+				Balance::build_node(node, depth, max_depth);
+				return (node);
+			}
 
-				node->leftChild = res->leftChild;
-				if (res->leftChild->value != NULL)
-					res->leftChild->parent = node;
-				node->rightChild = res->rightChild;
-				if (res->rightChild->value != NULL)
-					res->rightChild->parent = node;
+			// balancing data of the levels plan_build made, once the tasks below are done
+			void finish_build(node_type* node, size_t depth, size_t cut, size_t max_depth)
+			{
+				if (node->value == NULL || depth == cut)
+					return ;
+				finish_build(node->leftChild, depth + 1, cut, max_depth);
+				finish_build(node->rightChild, depth + 1, cut, max_depth);
+				Balance::build_node(node, depth, max_depth);
+			}
 
-				if (tmp_parent->leftChild == node)
-					tmp_parent->leftChild = res;
-				else if (tmp_parent->rightChild == node)
-					tmp_parent->rightChild = res;
+			// levels of the perfectly balanced tree over n nodes
+			static size_t build_depth(size_t n)
+			{
+				size_t depth = 0;
+				while ((static_cast<size_t>(1) << depth) <= n)
+					++depth;
+				return (depth);
+			}
 
-				if (res == tmp_left)
-				{
-					tmp_right->parent = res;
-					res->rightChild = tmp_right;
-					node->parent = res;
-					res->leftChild = node;
-				}
-				else if (res == tmp_right)
+			// lazy erase of a live node: it stays linked, marked dead, until purge()
+			void bury(node_type* node)
+			{
+				if (node == this->_compact_cursor)
+					this->_compact_cursor = (++iterator(node)).base();
+				node->dead = true;
+				this->_dead++;
+				this->_size--;
+			}
+
+			// live nodes under node in key order into out, dead ones freed on the way
+			void collect_live(node_type* node, std::vector<node_type*>& out)
+			{
+				if (node->value == NULL)
+					return ;
+				node_type* right = node->rightChild;
+				collect_live(node->leftChild, out);
+				if (node->dead)
 				{
-					tmp_left->parent = res;
-					res->leftChild = tmp_left;
-					node->parent = res;
-					res->rightChild = node;
+					this->_dead--;
+					free_node(node);
 				}
 				else
-				{
-					tmp_left->parent = res;
-					res->leftChild = tmp_left;
-					tmp_right->parent = res;
-					res->rightChild = tmp_right;
-					node->parent = res->parent;
-					res->parent->rightChild = node;
-				}
-
-				res->parent = tmp_parent;
-
-				if (res->parent->value == NULL)
-					this->_root = res;
-				node->color = res->color;
-				res->color = tmp_color;
+					out.push_back(node);
+				collect_live(right, out);
+			}
 
+			// build_subtree over existing nodes: nodes[lo, hi) hang from parent
+			node_type* link_sorted(const std::vector<node_type*>& nodes, size_t lo, size_t hi, node_type* parent, size_t depth, size_t max_depth)
+			{
+				if (lo == hi)
+					return (this->_nil);
+				size_t mid = lo + (hi - lo) / 2;
+				node_type* node = nodes[mid];
+				node->parent = parent;
+				node->leftChild = link_sorted(nodes, lo, mid, node, depth + 1, max_depth);
+				node->rightChild = link_sorted(nodes, mid + 1, hi, node, depth + 1, max_depth);
+				Balance::build_node(node, depth, max_depth);
 				return (node);
 			}
 
-			void replace_node(node_type* node, node_type* child)
+			// insert over a tombstone of an equivalent key: the node comes back in place
+			// holding val
+			node_type* revive(node_type* node, const value_type& val)
 			{
-				child->parent = node->parent;
-				if (node->parent->leftChild == node)
-					node->parent->leftChild = child;
-				else
-					node->parent->rightChild = child;
+				allocator_type().destroy(node->value);
+				allocator_type().construct(node->value, val);
+				return (revived(node));
 			}
 
-			void insert_case1(node_type* node)
+#ifdef FT_CXX11
+			node_type* revive(node_type* node, value_type&& val)
 			{
-				if (node->parent->value != NULL)
-					insert_case2(node);
-				else
-					node->color = BLACK;
+				allocator_type().destroy(node->value);
+				::new (static_cast<void*>(node->value)) value_type(std::move(val));
+				return (revived(node));
 			}
+#endif
 
-			void insert_case2(node_type* node)
+			node_type* revived(node_type* node)
 			{
-				if (node->parent->color == RED)
-					insert_case3(node);
+				node->dead = false;
+				this->_dead--;
+				this->_size++;
+				return (node);
 			}
 
-			void insert_case3(node_type* node)
+			void free_node(node_type* node)
 			{
-				node_type* uncle = get_uncle(node);
-				node_type* grand;
-				if (uncle->value != NULL && uncle->color == RED)
+				this->count_node_free();
+				slab_type* slab = find_slab(node);
+				if (slab == NULL)
 				{
-					node->parent->color = BLACK;
-					uncle->color = BLACK;
-					grand = get_grandparent(node);
-					grand->color = RED;
-					insert_case1(grand);
+					_node_alloc.destroy(node);
+					_node_alloc.deallocate(node, 1);
+					return ;
 				}
-				else
-					insert_case4(node);
+				allocator_type().destroy(node->value);
+				node->value = NULL;
+				_node_alloc.destroy(node);
+				slab->live--;
+				release_empty_slabs();
 			}
 
-			void insert_case4(node_type* node)
+			slab_type* find_slab(node_type* node)
 			{
-
-				node_type* grand = get_grandparent(node);
-				if (node == node->parent->rightChild && node->parent == grand->leftChild)
+				for (size_t i = 0; i < this->_slabs.size(); ++i)
 				{
-					rotate_left(node->parent);
-					node = node->leftChild;
+					if (this->_slabs[i].contains(node))
+						return (&this->_slabs[i]);
 				}
-				else if (node == node->parent->leftChild && node->parent == grand->rightChild)
+				return (NULL);
+			}
+
+			// frees every block with no node left in it, except the one being filled
+			void release_empty_slabs()
+			{
+				size_t filled = (this->_compact_cursor != NULL ? this->_slabs.size() - 1 : this->_slabs.size());
+				for (size_t i = filled; i-- > 0; )
 				{
-					rotate_right(node->parent);
-					node = node->rightChild;
+					if (this->_slabs[i].live != 0)
+						continue ;
+					_node_alloc.deallocate(this->_slabs[i].nodes, this->_slabs[i].capacity);
+					allocator_type().deallocate(this->_slabs[i].values, this->_slabs[i].capacity);
+					this->_slabs.erase(this->_slabs.begin() + i);
 				}
-				insert_case5(node);
 			}
 
-			void insert_case5(node_type* node)
+			void begin_compaction()
+			{
+				node_type* nodes = _node_alloc.allocate(this->_size);
+				value_type* values = allocator_type().allocate(this->_size);
+				this->_slabs.push_back(slab_type(nodes, values, this->_size));
+				this->_compact_cursor = this->_nil;
+			}
+
+			void end_compaction()
 			{
+				this->_compact_cursor = NULL;
+				release_empty_slabs();
+			}
 
-				node_type* grand = get_grandparent(node);
-				node->parent->color = BLACK;
-				grand->color = RED;
-				if (node == node->parent->leftChild)
-					rotate_right(grand);
+			// copies node and value into the next slot of the block being filled, points
+			// the neighbours at the copy and frees the original
+			node_type* relocate(node_type* old)
+			{
+				slab_type& slab = this->_slabs.back();
+				node_type* res = slab.nodes + slab.used;
+				_node_alloc.construct(res, node_type());
+				allocator_type().construct(slab.values + slab.used, *old->value);
+				res->value = slab.values + slab.used;
+				slab.used++;
+				slab.live++;
+				this->count_node_alloc();
+
+				res->color = old->color;
+				res->rank = old->rank;
+				res->dead = old->dead;
+				res->parent = old->parent;
+				res->leftChild = old->leftChild;
+				res->rightChild = old->rightChild;
+				if (old->parent->value == NULL)
+					this->_root = res;
+				else if (old->parent->leftChild == old)
+					old->parent->leftChild = res;
 				else
-					rotate_left(grand);
+					old->parent->rightChild = res;
+				if (old->leftChild->value != NULL)
+					old->leftChild->parent = res;
+				if (old->rightChild->value != NULL)
+					old->rightChild->parent = res;
+				if (this->_nil->parent == old)
+					this->_nil->parent = res;
+				free_node(old);
+				return (res);
 			}
 
+			size_t subtree_height(node_type* node) const
+			{
+				if (node->value == NULL)
+					return (0);
+				size_t left = subtree_height(node->leftChild);
+				size_t right = subtree_height(node->rightChild);
+				return ((left > right ? left : right) + 1);
+			}
 
-			void rotate_left(node_type* node)
+			// van Emde Boas layout of the top levels of node: the upper half of the levels
+			// first, then each subtree hanging below it, both laid out the same way
+			void veb_order(node_type* node, size_t levels, std::vector<node_type*>& out) const
 			{
-				node_type* child = node->rightChild;
-				node_type* parent = node->parent;
-				if (child->leftChild->value != NULL)
-					child->leftChild->parent = node;
-				node->rightChild = child->leftChild;
-				node->parent = child;
-				child->leftChild = node;
-				child->parent = parent;
-				if (parent->value != NULL)
+				if (node->value == NULL)
+					return ;
+				if (levels == 1)
 				{
-					if (parent->leftChild == node)
-						parent->leftChild = child;
-					else
-						parent->rightChild = child;
+					out.push_back(node);
+					return ;
 				}
-				else
-					this->_root = child;
+				size_t top = levels / 2;
+				veb_order(node, top, out);
+				std::vector<node_type*> roots;
+				subtrees_below(node, top, roots);
+				for (size_t i = 0; i < roots.size(); ++i)
+					veb_order(roots[i], levels - top, out);
 			}
 
-			void rotate_right(node_type* node)
+			void subtrees_below(node_type* node, size_t depth, std::vector<node_type*>& out) const
 			{
-				node_type* child = node->leftChild;
-				node_type* parent = node->parent;
-				if (child->rightChild->value != NULL)
-					child->rightChild->parent = node;
-				node->leftChild = child->rightChild;
-				node->parent = child;
-				child->rightChild = node;
-				child->parent = parent;
-				if (parent->value != NULL)
+				if (node->value == NULL)
+					return ;
+				if (depth == 0)
 				{
-					if (parent->rightChild == node)
-						parent->rightChild = child;
-					else
-						parent->leftChild = child;
+					out.push_back(node);
+					return ;
 				}
-				else
-					this->_root = child;
+				subtrees_below(node->leftChild, depth - 1, out);
+				subtrees_below(node->rightChild, depth - 1, out);
 			}
 
-			void delete_case1(node_type* node)
+			template <typename A, typename B>
+			bool compare(const A& a, const B& b) const
 			{
-
-				if (node->parent->value != NULL)
-					delete_case2(node);
+				this->count_compare();
+				return (_comp(a, b));
 			}
 
-			void delete_case2(node_type* node)
+			template <typename A, typename B>
+			int compare_three_way(const A& a, const B& b) const
 			{
+				this->count_compare();
+				return (_comp.compare(a, b));
+			}
 
-				node_type* sibling = get_sibling(node);
-				if (sibling->color == RED)
+
+			// lower_bound descent from node, res being the answer if nothing below qualifies
+			template <typename Key>
+			node_type* lower_bound_below(node_type* node, node_type* res, const Key& val) const
+			{
+				while (node->value != NULL)
 				{
-					node->parent->color = RED;
-					sibling->color = BLACK;
-					if (node == node->parent->leftChild)
-						rotate_left(node->parent);
+					if (!compare(*node->value, val))
+					{
+						res = node;
+						node = node->leftChild;
+					}
 					else
-						rotate_right(node->parent);
+						node = node->rightChild;
 				}
-				delete_case3(node);
+				if (res->dead)
+					return ((++iterator(res)).base());
+				return (res);
 			}
 
-
-			void delete_case3(node_type* node)
+			// three-way comparator: one call per level, stops on the first equal node
+			template <typename Key>
+			node_type* find(const Key& val, const true_type&) const
 			{
-
-				node_type* sibling = get_sibling(node);
-				if (node->parent->color == BLACK && sibling->color == BLACK && sibling->leftChild->color == BLACK && sibling->rightChild->color == BLACK)
+				node_type* node = this->_root;
+				while (node->value != NULL)
 				{
-					sibling->color = RED;
-					delete_case1(node->parent);
+					int cmp = compare_three_way(val, *node->value);
+					if (cmp == 0)
+						return (node->dead ? this->_nil : node);
+					node = (cmp < 0 ? node->leftChild : node->rightChild);
 				}
-				else
-					delete_case4(node);
+				return (this->_nil);
 			}
 
+			// less-only comparator: one call per level down to the lower bound, then one
+			// more to tell an equal key from a greater one
+			template <typename Key>
+			node_type* find(const Key& val, const false_type&) const
+			{
+				node_type* res = lower_bound(val);
+				if (res->value != NULL && compare(val, *res->value))
+					return (this->_nil);
+				return (res);
+			}
 
-			void delete_case4(node_type* node)
+			template <typename Key>
+			bool equivalent(const Key& val, node_type* node, const true_type&) const
 			{
+				return (compare_three_way(val, *node->value) == 0);
+			}
 
-				node_type* sibling = get_sibling(node);
-				if (node->parent->color == RED && sibling->color == BLACK && sibling->leftChild->color == BLACK && sibling->rightChild->color == BLACK)
+			template <typename Key>
+			bool equivalent(const Key& val, node_type* node, const false_type&) const
+			{
+				return (!compare(val, *node->value) && !compare(*node->value, val));
+			}
+
+			// parent for val with side < 0 (left) or > 0 (right), or the equal node with side 0,
+			// searching the subtree of from, which must span val
+			node_type* get_position(const value_type& val, int& side, node_type* from, const true_type&) const
+			{
+				node_type* node = from;
+				node_type* parent = node;
+				side = 0;
+				while (node->value != NULL)
 				{
-					sibling->color = RED;
-					node->parent->color = BLACK;
+					parent = node;
+					side = compare_three_way(val, *node->value);
+					if (side == 0)
+						return (node);
+					node = (side < 0 ? node->leftChild : node->rightChild);
 				}
-				else
-					delete_case5(node);
+				return (parent);
 			}
 
-			void delete_case5(node_type* node)
+			node_type* get_position(const value_type& val, int& side, node_type* from, const false_type&) const
 			{
-
-				node_type* sibling = get_sibling(node);
-
-				if (sibling->color == BLACK)
+				node_type* node = from;
+				node_type* parent = node;
+				node_type* last_right = NULL;
+				while (node->value != NULL)
 				{
-					if (node == node->parent->leftChild && sibling->rightChild->color == BLACK && sibling->leftChild->color == RED)
+					parent = node;
+					if (compare(val, *node->value))
 					{
-						sibling->color = RED;
-						sibling->leftChild->color = BLACK;
-						rotate_right(sibling);
+						side = -1;
+						node = node->leftChild;
 					}
-					else if (node == node->parent->rightChild && sibling->leftChild->color == BLACK && sibling->rightChild->color == RED)
+					else
 					{
-						sibling->color = RED;
-						sibling->rightChild->color = BLACK;
-						rotate_left(sibling);
+						side = 1;
+						last_right = node;
+						node = node->rightChild;
 					}
 				}
-				delete_case6(node);
+				// val is not less than last_right, so it is equal unless last_right is less
+				if (last_right != NULL && !compare(*last_right->value, val))
+				{
+					side = 0;
+					return (last_right);
+				}
+				return (parent);
+			}
+
+			// where val goes, from the hint when it is usable (see check_hint) or from the root
+			node_type* locate(const value_type& val, node_type* hint, int& side)
+			{
+				// past the cached max, as keys that only grow always are, val hangs right
+				// of it with no descent
+				node_type* max = this->_nil->parent;
+				if (max->value != NULL && compare(*max->value, val))
+				{
+					side = 1;
+					return (max);
+				}
+				node_type* position = NULL;
+				// a tombstone between the hint and its neighbour could hold val, so
+				// hints are only trusted while there is none
+				if (hint != NULL && this->_dead == 0)
+					position = check_hint(val, hint, side);
+				if (position == NULL)
+					position = get_position(val, side, this->_root, is_three_way<Compare>());
+				return (position);
+			}
+
+			// links val at the spot get_position() found, or revives or returns the equal node
+			ft::pair<node_type*, bool> insert_at(node_type* position, int side, const value_type& val)
+			{
+				if (side == 0 && position->dead)
+					return (ft::make_pair(revive(position, val), true));
+				if (side == 0)
+					return (ft::make_pair(position, false));
+				return (ft::make_pair(link_at(position, side, make_node(val)), true));
+			}
+
+			node_type* link_root(node_type* node)
+			{
+				this->_root = node;
+				node->leftChild = this->_nil;
+				node->rightChild = this->_nil;
+				node->parent = this->_nil;
+				Balance::init_node(node);
+				Balance::insert_fixup(node, this->_root, static_cast<const Counter&>(*this));
+				this->_nil->parent = node;
+				this->_size++;
+				return (node);
+			}
+
+			node_type* link_at(node_type* position, int side, node_type* node)
+			{
+				attach_node(position, node, side);
+				Balance::insert_fixup(node, this->_root, static_cast<const Counter&>(*this));
+				this->_size++;
+				if (position == this->_nil->parent && side > 0)
+					this->_nil->parent = node;
+				return (node);
+			}
+
+			// lowest ancestor of node (node included) whose subtree spans val, for val
+			// greater than node's value: climbs until node is a left child of something
+			// greater than val
+			node_type* climb(node_type* node, const value_type& val) const
+			{
+				while (node->parent->value != NULL)
+				{
+					if (node->parent->leftChild == node && compare(val, *node->parent->value))
+						return (node);
+					node = node->parent;
+				}
+				return (node);
 			}
 
-			void delete_case6(node_type* node)
+			// a hint is used when val goes right before it, otherwise NULL is returned and
+			// the insertion descends from the root. locate() has already hung val after the
+			// max when it goes there, so an end() hint is no help
+			node_type* check_hint(const value_type& val, node_type* hint, int& side)
 			{
+				if (hint->value == NULL || !compare(val, *hint->value))
+					return (NULL);
+				node_type* prev = (--iterator(hint)).base();
+				if (prev->value != NULL && !compare(*prev->value, val))
+					return (NULL);
+				if (hint->leftChild->value == NULL)
+				{
+					side = -1;
+					return (hint);
+				}
+				side = 1;
+				return (prev);
+			}
+
+			void attach_node(node_type* parent, node_type* node, int side)
+			{
+				if (side < 0)
+					parent->leftChild = node;
+				else
+					parent->rightChild = node;
+				node->parent = parent;
+				node->leftChild = this->_nil;
+				node->rightChild = this->_nil;
+				Balance::init_node(node);
+			}
+
+			node_type* replace_erase_node(node_type* node)
+			{
+
+				node_type* res;
+				if (node->leftChild->value != NULL)
+				{
+					res = node->leftChild;
+					while (res->rightChild->value != NULL)
+						res = res->rightChild;
+				}
+				else if (node->rightChild->value != NULL)
+				{
+					res = node->rightChild;
+					while (res->leftChild->value != NULL)
+						res = res->leftChild;
+				}
+				else
+					return (node);
+
+				node_type* tmp_parent = node->parent;
+				node_type* tmp_left = node->leftChild;
+				node_type* tmp_right = node->rightChild;
+				RBColor tmp_color = node->color;
+				unsigned int tmp_rank = node->rank;
+
+				node->leftChild = res->leftChild;
+				if (res->leftChild->value != NULL)
+					res->leftChild->parent = node;
+				node->rightChild = res->rightChild;
+				if (res->rightChild->value != NULL)
+					res->rightChild->parent = node;
+
+				if (tmp_parent->leftChild == node)
+					tmp_parent->leftChild = res;
+				else if (tmp_parent->rightChild == node)
+					tmp_parent->rightChild = res;
 
-				node_type* sibling = get_sibling(node);
-				sibling->color = node->parent->color;
-				node->parent->color = BLACK;
-				if (node == node->parent->leftChild)
+				if (res == tmp_left)
 				{
-					sibling->rightChild->color = BLACK;
-					rotate_left(node->parent);
+					tmp_right->parent = res;
+					res->rightChild = tmp_right;
+					node->parent = res;
+					res->leftChild = node;
+				}
+				else if (res == tmp_right)
+				{
+					tmp_left->parent = res;
+					res->leftChild = tmp_left;
+					node->parent = res;
+					res->rightChild = node;
 				}
 				else
 				{
-					sibling->leftChild->color = BLACK;
-					rotate_right(node->parent);
+					tmp_left->parent = res;
+					res->leftChild = tmp_left;
+					tmp_right->parent = res;
+					res->rightChild = tmp_right;
+					node->parent = res->parent;
+					if (res->parent->rightChild == res)
+						res->parent->rightChild = node;
+					else
+						res->parent->leftChild = node;
 				}
+
+				res->parent = tmp_parent;
+
+				if (res->parent->value == NULL)
+					this->_root = res;
+				node->color = res->color;
+				res->color = tmp_color;
+				node->rank = res->rank;
+				res->rank = tmp_rank;
+
+				return (node);
+			}
+
+			void replace_node(node_type* node, node_type* child)
+			{
+				child->parent = node->parent;
+				if (node->parent->leftChild == node)
+					node->parent->leftChild = child;
+				else
+					node->parent->rightChild = child;
 			}
 
 			template <typename _T>
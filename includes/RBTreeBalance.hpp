@@ -0,0 +1,460 @@
+#ifndef RBTREEBALANCE_HPP
+# define RBTREEBALANCE_HPP
+
+#include <cstddef>
+#include "RBTreeNode.hpp"
+
+namespace ft
+{
+	// Balancing policies of RBTree. Each one is a set of static hooks called by the tree:
+	//   init_node(node)                       a node about to be linked as a leaf
+	//   insert_fixup(node, root, counter)     after the leaf is linked
+	//   erase_fixup(target, child, root, counter)
+	//                                         after target (at most one child) was replaced by child,
+	//                                         target->parent still points to its old parent
+	//   build_node(node, depth, max_depth)    RBTree::build_sorted, once both subtrees are built;
+	//                                         leaves are at max_depth or max_depth - 1
+	//   verify(root) / black_height(root)     used by RBTree::verify() and tree_stats()
+	// Node::rank is free for the policy: unused by red-black, subtree height for AVL and
+	// subtree size for weight-balanced trees. The nil sentinel keeps rank 0 and BLACK.
+
+	struct TreeRotation {
+		template <typename Node, typename Counter>
+		static void rotate_left(Node* node, Node*& root, const Counter& counter)
+		{
+			counter.count_rotation();
+			Node* child = node->rightChild;
+			Node* parent = node->parent;
+			if (child->leftChild->value != NULL)
+				child->leftChild->parent = node;
+			node->rightChild = child->leftChild;
+			node->parent = child;
+			child->leftChild = node;
+			child->parent = parent;
+			if (parent->value != NULL)
+			{
+				if (parent->leftChild == node)
+					parent->leftChild = child;
+				else
+					parent->rightChild = child;
+			}
+			else
+				root = child;
+		}
+
+		template <typename Node, typename Counter>
+		static void rotate_right(Node* node, Node*& root, const Counter& counter)
+		{
+			counter.count_rotation();
+			Node* child = node->leftChild;
+			Node* parent = node->parent;
+			if (child->rightChild->value != NULL)
+				child->rightChild->parent = node;
+			node->leftChild = child->rightChild;
+			node->parent = child;
+			child->rightChild = node;
+			child->parent = parent;
+			if (parent->value != NULL)
+			{
+				if (parent->rightChild == node)
+					parent->rightChild = child;
+				else
+					parent->leftChild = child;
+			}
+			else
+				root = child;
+		}
+	};
+
+
+	struct RBBalance : public TreeRotation {
+		template <typename Node>
+		static void init_node(Node* node)
+		{
+			node->color = RED;
+		}
+
+		// climbs two levels per red uncle, then ends in at most two rotations; parent,
+		// grandparent and uncle are loaded once per level
+		template <typename Node, typename Counter>
+		static void insert_fixup(Node* node, Node*& root, const Counter& counter)
+		{
+			Node* parent = node->parent;
+			while (parent->value != NULL && parent->color == RED)
+			{
+				// a red parent is never the root, so grand is a node
+				Node* grand = parent->parent;
+				bool left = (parent == grand->leftChild);
+				Node* uncle = (left ? grand->rightChild : grand->leftChild);
+				if (uncle->color == RED)
+				{
+					counter.count_recolor(3);
+					parent->color = BLACK;
+					uncle->color = BLACK;
+					grand->color = RED;
+					node = grand;
+					parent = node->parent;
+					continue ;
+				}
+				if (left && node == parent->rightChild)
+				{
+					rotate_left(parent, root, counter);
+					parent = node;
+				}
+				else if (!left && node == parent->leftChild)
+				{
+					rotate_right(parent, root, counter);
+					parent = node;
+				}
+				counter.count_recolor(2);
+				parent->color = BLACK;
+				grand->color = RED;
+				if (left)
+					rotate_right(grand, root, counter);
+				else
+					rotate_left(grand, root, counter);
+				return ;
+			}
+			if (parent->value == NULL)
+			{
+				counter.count_recolor(1);
+				node->color = BLACK;
+			}
+		}
+
+		template <typename Node, typename Counter>
+		static void erase_fixup(Node* target, Node* child, Node*& root, const Counter& counter)
+		{
+			if (target->color == BLACK)
+			{
+				if (child->color == RED)
+				{
+					counter.count_recolor(1);
+					child->color = BLACK;
+				}
+				else
+					erase_loop(child, root, counter);
+			}
+		}
+
+		// every path holds one node per level above the bottom one, all black, and
+		// the bottom level is red: same black count everywhere, no red child
+		template <typename Node>
+		static void build_node(Node* node, size_t depth, size_t max_depth)
+		{
+			node->color = (depth == max_depth && depth > 1 ? RED : BLACK);
+		}
+
+		template <typename Node>
+		static bool verify(Node* root)
+		{
+			return (root->value == NULL || (root->color == BLACK && black_height(root) != 0));
+		}
+
+		// black nodes on every path down to nil (nil included), 0 if it differs or two reds touch
+		template <typename Node>
+		static size_t black_height(Node* node)
+		{
+			if (node->value == NULL)
+				return (1);
+			if (node->color == RED && (node->leftChild->color == RED || node->rightChild->color == RED))
+				return (0);
+			size_t left = black_height(node->leftChild);
+			size_t right = black_height(node->rightChild);
+			if (left == 0 || left != right)
+				return (0);
+			return (left + (node->color == BLACK ? 1 : 0));
+		}
+
+		private :
+			// node is one black short on its side: climbs while the sibling's side can
+			// give a black away by recoloring, then ends in at most three rotations
+			template <typename Node, typename Counter>
+			static void erase_loop(Node* node, Node*& root, const Counter& counter)
+			{
+				while (node->parent->value != NULL)
+				{
+					Node* parent = node->parent;
+					bool left = (node == parent->leftChild);
+					Node* sibling = (left ? parent->rightChild : parent->leftChild);
+					if (sibling->color == RED)
+					{
+						counter.count_recolor(2);
+						parent->color = RED;
+						sibling->color = BLACK;
+						if (left)
+						{
+							rotate_left(parent, root, counter);
+							sibling = parent->rightChild;
+						}
+						else
+						{
+							rotate_right(parent, root, counter);
+							sibling = parent->leftChild;
+						}
+					}
+					Node* inner = (left ? sibling->leftChild : sibling->rightChild);
+					Node* outer = (left ? sibling->rightChild : sibling->leftChild);
+					if (inner->color == BLACK && outer->color == BLACK)
+					{
+						counter.count_recolor(parent->color == RED ? 2 : 1);
+						sibling->color = RED;
+						if (parent->color == RED)
+						{
+							parent->color = BLACK;
+							return ;
+						}
+						node = parent;
+						continue ;
+					}
+					if (outer->color == BLACK)
+					{
+						counter.count_recolor(2);
+						sibling->color = RED;
+						inner->color = BLACK;
+						if (left)
+							rotate_right(sibling, root, counter);
+						else
+							rotate_left(sibling, root, counter);
+						outer = sibling;
+						sibling = inner;
+					}
+					counter.count_recolor(3);
+					sibling->color = parent->color;
+					parent->color = BLACK;
+					outer->color = BLACK;
+					if (left)
+						rotate_left(parent, root, counter);
+					else
+						rotate_right(parent, root, counter);
+					return ;
+				}
+			}
+	};
+
+
+	// height-balanced: subtree heights of siblings differ by at most one, so the tree is
+	// at most ~1.44 log n deep against 2 log n for red-black, for more rotations on writes
+	struct AVLBalance : public TreeRotation {
+		template <typename Node>
+		static void init_node(Node* node)
+		{
+			node->color = BLACK;
+			node->rank = 1;
+		}
+
+		template <typename Node, typename Counter>
+		static void insert_fixup(Node* node, Node*& root, const Counter& counter)
+		{
+			retrace(node->parent, root, counter);
+		}
+
+		template <typename Node, typename Counter>
+		static void erase_fixup(Node* target, Node*, Node*& root, const Counter& counter)
+		{
+			retrace(target->parent, root, counter);
+		}
+
+		template <typename Node>
+		static void build_node(Node* node, size_t, size_t)
+		{
+			node->color = BLACK;
+			node->rank = height_of(node);
+		}
+
+		template <typename Node>
+		static bool verify(Node* node)
+		{
+			if (node->value == NULL)
+				return (node->rank == 0);
+			int diff = static_cast<int>(node->leftChild->rank) - static_cast<int>(node->rightChild->rank);
+			if (diff < -1 || diff > 1 || node->rank != height_of(node))
+				return (false);
+			return (verify(node->leftChild) && verify(node->rightChild));
+		}
+
+		template <typename Node>
+		static size_t black_height(Node*)
+		{
+			return (0);
+		}
+
+		private :
+			template <typename Node>
+			static unsigned int height_of(Node* node)
+			{
+				unsigned int left = node->leftChild->rank;
+				unsigned int right = node->rightChild->rank;
+				return ((left > right ? left : right) + 1);
+			}
+
+			template <typename Node, typename Counter>
+			static void rotate_left(Node* node, Node*& root, const Counter& counter)
+			{
+				Node* child = node->rightChild;
+				TreeRotation::rotate_left(node, root, counter);
+				node->rank = height_of(node);
+				child->rank = height_of(child);
+			}
+
+			template <typename Node, typename Counter>
+			static void rotate_right(Node* node, Node*& root, const Counter& counter)
+			{
+				Node* child = node->leftChild;
+				TreeRotation::rotate_right(node, root, counter);
+				node->rank = height_of(node);
+				child->rank = height_of(child);
+			}
+
+			// fixes heights from node up to the root, rotating where siblings differ by two
+			template <typename Node, typename Counter>
+			static void retrace(Node* node, Node*& root, const Counter& counter)
+			{
+				while (node->value != NULL)
+				{
+					int diff = static_cast<int>(node->leftChild->rank) - static_cast<int>(node->rightChild->rank);
+					if (diff > 1)
+					{
+						Node* left = node->leftChild;
+						if (left->leftChild->rank < left->rightChild->rank)
+							rotate_left(left, root, counter);
+						rotate_right(node, root, counter);
+						node = node->parent;
+					}
+					else if (diff < -1)
+					{
+						Node* right = node->rightChild;
+						if (right->rightChild->rank < right->leftChild->rank)
+							rotate_right(right, root, counter);
+						rotate_left(node, root, counter);
+						node = node->parent;
+					}
+					else
+					{
+						// ancestors only depend on this height, nothing left to fix once it holds
+						unsigned int height = height_of(node);
+						if (height == node->rank)
+							break ;
+						node->rank = height;
+					}
+					node = node->parent;
+				}
+			}
+	};
+
+
+	// weight-balanced (BB[alpha] with delta 3, gamma 2): no sibling holds more than about
+	// three times the nodes of the other; rank keeps the subtree size
+	struct WBBalance : public TreeRotation {
+		template <typename Node>
+		static void init_node(Node* node)
+		{
+			node->color = BLACK;
+			node->rank = 1;
+		}
+
+		template <typename Node, typename Counter>
+		static void insert_fixup(Node* node, Node*& root, const Counter& counter)
+		{
+			retrace(node->parent, root, counter);
+		}
+
+		template <typename Node, typename Counter>
+		static void erase_fixup(Node* target, Node*, Node*& root, const Counter& counter)
+		{
+			retrace(target->parent, root, counter);
+		}
+
+		template <typename Node>
+		static void build_node(Node* node, size_t, size_t)
+		{
+			node->color = BLACK;
+			node->rank = size_of(node);
+		}
+
+		template <typename Node>
+		static bool verify(Node* node)
+		{
+			if (node->value == NULL)
+				return (node->rank == 0);
+			if (node->rank != size_of(node) || !balanced(weight(node->leftChild), weight(node->rightChild))
+				|| !balanced(weight(node->rightChild), weight(node->leftChild)))
+				return (false);
+			return (verify(node->leftChild) && verify(node->rightChild));
+		}
+
+		template <typename Node>
+		static size_t black_height(Node*)
+		{
+			return (0);
+		}
+
+		private :
+			static const unsigned int delta = 3;
+			static const unsigned int gamma = 2;
+
+			template <typename Node>
+			static unsigned int size_of(Node* node)
+			{
+				return (node->leftChild->rank + node->rightChild->rank + 1);
+			}
+
+			template <typename Node>
+			static unsigned long weight(Node* node)
+			{
+				return (static_cast<unsigned long>(node->rank) + 1);
+			}
+
+			static bool balanced(unsigned long a, unsigned long b)
+			{
+				return (delta * a >= b);
+			}
+
+			template <typename Node, typename Counter>
+			static void rotate_left(Node* node, Node*& root, const Counter& counter)
+			{
+				Node* child = node->rightChild;
+				TreeRotation::rotate_left(node, root, counter);
+				node->rank = size_of(node);
+				child->rank = size_of(child);
+			}
+
+			template <typename Node, typename Counter>
+			static void rotate_right(Node* node, Node*& root, const Counter& counter)
+			{
+				Node* child = node->leftChild;
+				TreeRotation::rotate_right(node, root, counter);
+				node->rank = size_of(node);
+				child->rank = size_of(child);
+			}
+
+			// fixes sizes from node up to the root, rotating where one side outweighs the other
+			template <typename Node, typename Counter>
+			static void retrace(Node* node, Node*& root, const Counter& counter)
+			{
+				while (node->value != NULL)
+				{
+					node->rank = size_of(node);
+					if (!balanced(weight(node->leftChild), weight(node->rightChild)))
+					{
+						Node* right = node->rightChild;
+						if (weight(right->leftChild) >= gamma * weight(right->rightChild))
+							rotate_right(right, root, counter);
+						rotate_left(node, root, counter);
+						node = node->parent;
+					}
+					else if (!balanced(weight(node->rightChild), weight(node->leftChild)))
+					{
+						Node* left = node->leftChild;
+						if (weight(left->rightChild) >= gamma * weight(left->leftChild))
+							rotate_left(left, root, counter);
+						rotate_right(node, root, counter);
+						node = node->parent;
+					}
+					node = node->parent;
+				}
+			}
+	};
+}
+
+#endif
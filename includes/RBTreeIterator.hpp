@@ -3,6 +3,7 @@
 
 #include "utils.hpp"
 #include "RBTreeNode.hpp"
+#include "HotCounters.hpp"
 
 
 namespace ft
@@ -23,7 +24,10 @@ namespace ft
 		public:
 
 			RBTreeIterator(node_type* ptr = NULL) : _node(ptr) {}
-			RBTreeIterator(const RBTreeIterator<T>& copy) : _node(copy.base()) {}
+			RBTreeIterator(const RBTreeIterator& copy) : _node(copy.base()) {}
+			// iterator to const_iterator; a template, so both keep a declared copy constructor
+			template <typename P>
+			RBTreeIterator(const RBTreeIterator<T, P, T&>& copy) : _node(copy.base()) {}
 			RBTreeIterator& operator=(const RBTreeIterator& copy)
 			{
 				if (this != &copy)
@@ -45,8 +49,51 @@ namespace ft
 				return (this->_node->value);
 			}
 
+			// nodes erased in lazy mode stay linked until the tree is rebuilt, steps skip them
 			RBTreeIterator& operator++()
 			{
+				do
+					step_forward();
+				while (_node->dead);
+				return (*this);
+			}
+
+			RBTreeIterator operator++(int)
+			{
+				RBTreeIterator tmp = *this;
+				++(*this);
+				return (tmp);
+			}
+
+			RBTreeIterator& operator--()
+			{
+				do
+					step_back();
+				while (_node->dead);
+				return (*this);
+			}
+
+			RBTreeIterator operator--(int)
+			{
+				RBTreeIterator tmp = *this;
+				--(*this);
+				return (tmp);
+			}
+
+			bool operator==(const RBTreeIterator& iter) const
+			{
+				return (_node == iter.base());
+			}
+
+			bool operator!=(const RBTreeIterator& iter) const
+			{
+				return (_node != iter.base());
+			}
+
+		private :
+			void step_forward()
+			{
+				ft::DefaultCountingPolicy::count_global_iterator_step();
 				node_type* tmp = NULL;
 				if (_node->rightChild->value != NULL)
 				{
@@ -66,18 +113,11 @@ namespace ft
 					}
 				}
 				_node = tmp;
-				return (*this);
-			}
-
-			RBTreeIterator operator++(int)
-			{
-				RBTreeIterator tmp = *this;
-				++(*this);
-				return (tmp);
 			}
 
-			RBTreeIterator& operator--()
+			void step_back()
 			{
+				ft::DefaultCountingPolicy::count_global_iterator_step();
 				node_type* tmp = NULL;
 				if (_node->value == NULL)
 					tmp = _node->parent;
@@ -98,24 +138,6 @@ namespace ft
 					}
 				}
 				_node = tmp;
-				return (*this);
-			}
-
-			RBTreeIterator operator--(int)
-			{
-				RBTreeIterator tmp = *this;
-				--(*this);
-				return (tmp);
-			}
-
-			bool operator==(const RBTreeIterator& iter)
-			{
-				return (_node == iter.base());
-			}
-
-			bool operator!=(const RBTreeIterator& iter)
-			{
-				return (_node != iter.base());
 			}
 
 
@@ -2,11 +2,18 @@
 # define RBTREENODE_HPP
 
 #include <memory>
+#include <new>
+#include "utils.hpp"
 
 namespace ft
 {
 	enum RBColor { RED = false, BLACK = true };
 
+#ifdef FT_CXX11
+	// selects the node constructor that builds the value from constructor arguments
+	struct emplace_tag {};
+#endif
+
 	template < typename T, typename Alloc = std::allocator<T> >
 	struct RBTreeNode {
 	public :
@@ -18,23 +25,37 @@ namespace ft
 		node	leftChild;
 		node	rightChild;
 		RBColor	color;
-		Alloc	alloc;
+		unsigned int	rank;	// owned by the balancing policy, see RBTreeBalance.hpp
+		bool	dead;	// erased but still linked, only in RBTree's lazy erase mode
 
-		RBTreeNode() : value(NULL), parent(NULL), leftChild(NULL), rightChild(NULL), color(BLACK), alloc(Alloc()) {}
+		RBTreeNode() : value(NULL), parent(NULL), leftChild(NULL), rightChild(NULL), color(BLACK), rank(0), dead(false) {}
 
-		RBTreeNode(const T& val) : value(NULL), parent(NULL), leftChild(NULL), rightChild(NULL), color(RED), alloc(Alloc())
+		RBTreeNode(const T& val) : value(NULL), parent(NULL), leftChild(NULL), rightChild(NULL), color(RED), rank(0), dead(false)
 		{
+			Alloc alloc;
 			value = alloc.allocate(1);
 			alloc.construct(value, val);
 		}
 
-		RBTreeNode(const RBTreeNode& copy) : value(NULL), parent(NULL), leftChild(NULL), rightChild(NULL), color(RED), alloc(Alloc())
+#ifdef FT_CXX11
+		template <typename... Args>
+		RBTreeNode(emplace_tag, Args&&... args) : value(NULL), parent(NULL), leftChild(NULL), rightChild(NULL), color(RED), rank(0), dead(false)
+		{
+			Alloc alloc;
+			value = alloc.allocate(1);
+			::new (static_cast<void*>(value)) T(std::forward<Args>(args)...);
+		}
+#endif
+
+		RBTreeNode(const RBTreeNode& copy) : value(NULL), parent(NULL), leftChild(NULL), rightChild(NULL), color(RED), rank(0), dead(false)
 		{
 			if (copy.value != NULL)
 			{
+				Alloc alloc;
 				value = alloc.allocate(1);
 				alloc.construct(value, *copy.value);
 				color = copy.color;
+				rank = copy.rank;
 			}
 		}
 
@@ -42,6 +63,7 @@ namespace ft
 		{
 			if (value != NULL)
 			{
+				Alloc alloc;
 				alloc.destroy(value);
 				alloc.deallocate(value, 1);
 			}
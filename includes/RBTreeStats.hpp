@@ -0,0 +1,26 @@
+#ifndef RBTREESTATS_HPP
+# define RBTREESTATS_HPP
+
+#include <cstddef>
+
+namespace ft
+{
+	// snapshot of the shape and memory footprint of a tree, filled by RBTree::tree_stats()
+	struct RBTreeStats {
+		size_t	node_count;		// dead nodes of a lazy erase included
+		size_t	height;			// nodes on the longest root-to-leaf path, i.e. the worst lookup depth
+		size_t	black_height;	// black nodes on any root-to-nil path, nil included (0 if the colors are broken or the tree is not red-black)
+		double	average_depth;	// mean nodes visited by a successful lookup
+		size_t	node_bytes;		// node_count * sizeof(node)
+		size_t	value_bytes;	// node_count * sizeof(value), each value is a separate allocation
+		size_t	sentinel_bytes;	// the nil node owned by every tree, even an empty one
+		size_t	total_bytes;
+		size_t	tombstones;		// nodes erased in lazy mode and not purged yet
+		bool	valid;			// result of RBTree::verify()
+
+		RBTreeStats() : node_count(0), height(0), black_height(0), average_depth(0.0),
+			node_bytes(0), value_bytes(0), sentinel_bytes(0), total_bytes(0), tombstones(0), valid(true) {}
+	};
+}
+
+#endif
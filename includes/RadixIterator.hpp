@@ -0,0 +1,101 @@
+#ifndef RADIXITERATOR_HPP
+# define RADIXITERATOR_HPP
+
+#include "iterator.hpp"
+
+namespace ft
+{
+	// iterator of radix_map: a leaf of the tree's key-ordered leaf chain (NULL is end()),
+	// plus the tree for stepping back from end()
+	template <typename Tree, typename T, typename Pointer = T*, typename Reference = T&>
+	class RadixIterator : public ft::iterator<ft::bidirectional_iterator_tag, T>
+	{
+		public :
+			typedef const T		value_type;
+			typedef Pointer		pointer;
+			typedef Reference	reference;
+			typedef typename ft::iterator<ft::bidirectional_iterator_tag, T>::difference_type	difference_type;
+			typedef typename ft::iterator<ft::bidirectional_iterator_tag, T>::iterator_category	iterator_category;
+			typedef typename Tree::Leaf	leaf_type;
+
+		protected :
+			const Tree*	_tree;
+			leaf_type*	_leaf;
+
+		public:
+
+			RadixIterator() : _tree(NULL), _leaf(NULL) {}
+			RadixIterator(const Tree* tree, leaf_type* leaf) : _tree(tree), _leaf(leaf) {}
+			RadixIterator(const RadixIterator& copy) : _tree(copy.tree()), _leaf(copy.base()) {}
+			// iterator to const_iterator
+			template <typename P>
+			RadixIterator(const RadixIterator<Tree, T, P, T&>& copy) : _tree(copy.tree()), _leaf(copy.base()) {}
+			RadixIterator& operator=(const RadixIterator& copy)
+			{
+				if (this != &copy)
+				{
+					this->_tree = copy.tree();
+					this->_leaf = copy.base();
+				}
+				return (*this);
+			}
+			virtual ~RadixIterator() {}
+
+			leaf_type* base() const
+			{
+				return (this->_leaf);
+			}
+
+			const Tree* tree() const
+			{
+				return (this->_tree);
+			}
+
+			reference operator*() const
+			{
+				return (this->_leaf->value);
+			}
+			pointer operator->() const
+			{
+				return (&(operator*()));
+			}
+
+			RadixIterator& operator++()
+			{
+				this->_leaf = this->_leaf->next;
+				return (*this);
+			}
+
+			RadixIterator operator++(int)
+			{
+				RadixIterator tmp = *this;
+				++(*this);
+				return (tmp);
+			}
+
+			RadixIterator& operator--()
+			{
+				this->_leaf = (this->_leaf == NULL ? this->_tree->last() : this->_leaf->prev);
+				return (*this);
+			}
+
+			RadixIterator operator--(int)
+			{
+				RadixIterator tmp = *this;
+				--(*this);
+				return (tmp);
+			}
+
+			bool operator==(const RadixIterator& iter) const
+			{
+				return (this->_leaf == iter.base());
+			}
+
+			bool operator!=(const RadixIterator& iter) const
+			{
+				return (!(*this == iter));
+			}
+	};
+}
+
+#endif
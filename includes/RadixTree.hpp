@@ -0,0 +1,777 @@
+#ifndef RADIXTREE_HPP
+# define RADIXTREE_HPP
+
+#include <cstring>
+#include <string>
+#include "utils.hpp"
+
+namespace ft
+{
+	// the bytes a radix_map branches on, ordered like the keys themselves: integers are
+	// stored big-endian with the sign bit flipped, strings are their own bytes (a string
+	// that is a prefix of another sorts first, as std::string does)
+	template <typename Key, bool = ft::is_integral<Key>::value>
+	class RadixKey;
+
+	template <typename Key>
+	class RadixKey<Key, true> {
+		private :
+			unsigned char	_bytes[sizeof(Key)];
+
+		public :
+			explicit RadixKey(const Key& key)
+			{
+				unsigned long long x = static_cast<unsigned long long>(key);
+				if (static_cast<Key>(-1) < static_cast<Key>(0))
+					x ^= static_cast<unsigned long long>(1) << (sizeof(Key) * 8 - 1);
+				for (size_t i = sizeof(Key); i > 0; --i, x >>= 8)
+					this->_bytes[i - 1] = static_cast<unsigned char>(x);
+			}
+
+			const unsigned char* data() const
+			{
+				return (this->_bytes);
+			}
+
+			size_t size() const
+			{
+				return (sizeof(Key));
+			}
+	};
+
+	template <>
+	class RadixKey<std::string, false> {
+		private :
+			const std::string&	_key;
+
+		public :
+			explicit RadixKey(const std::string& key) : _key(key) {}
+
+			const unsigned char* data() const
+			{
+				return (reinterpret_cast<const unsigned char*>(this->_key.data()));
+			}
+
+			size_t size() const
+			{
+				return (this->_key.size());
+			}
+	};
+
+	// adaptive radix tree (Leis et al., ICDE 2013) behind radix_map. Inner nodes grow and
+	// shrink between 4, 16, 48 and 256 children and skip the bytes all their keys share
+	// (path compression: up to INLINE_PREFIX of them kept in the node, the rest read back
+	// from a leaf). A key that ends inside the tree sits in the terminal slot of the node
+	// where it ends. Leaves are also chained in key order, so iteration is a list walk.
+	template <typename Key, typename T>
+	class RadixTree {
+		public :
+			typedef T	value_type;
+			typedef size_t	size_type;
+
+		private :
+			enum NodeType { LEAF, NODE4, NODE16, NODE48, NODE256 };
+			enum { INLINE_PREFIX = 8 };
+
+			struct Node {
+				unsigned char	type;
+
+				explicit Node(unsigned char t) : type(t) {}
+			};
+
+		public :
+			struct Leaf : Node {
+				T		value;
+				Leaf*	prev;
+				Leaf*	next;
+
+				explicit Leaf(const T& val) : Node(LEAF), value(val), prev(NULL), next(NULL) {}
+			};
+
+		private :
+			struct Inner : Node {
+				unsigned short	count;
+				size_t			prefix_len;
+				unsigned char	prefix[INLINE_PREFIX];
+				Leaf*			terminal;
+
+				explicit Inner(unsigned char t) : Node(t), count(0), prefix_len(0), terminal(NULL) {}
+			};
+
+			struct Node4 : Inner {
+				unsigned char	keys[4];
+				Node*			children[4];
+
+				Node4() : Inner(NODE4) {}
+			};
+
+			struct Node16 : Inner {
+				unsigned char	keys[16];
+				Node*			children[16];
+
+				Node16() : Inner(NODE16) {}
+			};
+
+			// index holds slot + 1 of each byte's child, 0 for none
+			struct Node48 : Inner {
+				unsigned char	index[256];
+				Node*			children[48];
+
+				Node48() : Inner(NODE48)
+				{
+					std::memset(this->index, 0, sizeof(this->index));
+					for (size_t i = 0; i < 48; ++i)
+						this->children[i] = NULL;
+				}
+			};
+
+			struct Node256 : Inner {
+				Node*	children[256];
+
+				Node256() : Inner(NODE256)
+				{
+					for (size_t i = 0; i < 256; ++i)
+						this->children[i] = NULL;
+				}
+			};
+
+			Node*		_root;
+			Leaf*		_head;
+			Leaf*		_tail;
+			size_type	_size;
+
+			RadixTree(const RadixTree&);
+			RadixTree& operator=(const RadixTree&);
+
+		public :
+			RadixTree() : _root(NULL), _head(NULL), _tail(NULL), _size(0) {}
+
+			~RadixTree()
+			{
+				clear();
+			}
+
+			size_type size() const
+			{
+				return (this->_size);
+			}
+
+			Leaf* first() const
+			{
+				return (this->_head);
+			}
+
+			Leaf* last() const
+			{
+				return (this->_tail);
+			}
+
+			Leaf* find(const Key& k) const
+			{
+				RadixKey<Key> key(k);
+				Node* n = this->_root;
+				size_t depth = 0;
+				while (n != NULL && n->type != LEAF)
+				{
+					Inner* in = static_cast<Inner*>(n);
+					// only the inline prefix bytes are checked here, the leaf's key settles it
+					if (depth + in->prefix_len > key.size()
+						|| std::memcmp(in->prefix, key.data() + depth, inline_prefix(in)) != 0)
+						return (NULL);
+					depth += in->prefix_len;
+					if (depth == key.size())
+					{
+						n = in->terminal;
+						break ;
+					}
+					Node** child = find_child(in, key.data()[depth]);
+					n = (child == NULL ? NULL : *child);
+					++depth;
+				}
+				if (n == NULL || !equal(static_cast<Leaf*>(n)->value.first, k))
+					return (NULL);
+				return (static_cast<Leaf*>(n));
+			}
+
+			// first leaf whose key is not less than k, NULL when there is none
+			Leaf* lower_bound(const Key& k) const
+			{
+				RadixKey<Key> key(k);
+				return (lower_bound(this->_root, k, key, 0));
+			}
+
+			Leaf* upper_bound(const Key& k) const
+			{
+				Leaf* res = lower_bound(k);
+				if (res != NULL && equal(res->value.first, k))
+					res = res->next;
+				return (res);
+			}
+
+			ft::pair<Leaf*, bool> insert(const T& val)
+			{
+				Leaf* next = lower_bound(val.first);
+				if (next != NULL && equal(next->value.first, val.first))
+					return (ft::make_pair(next, false));
+				Leaf* leaf = new Leaf(val);
+				RadixKey<Key> key(leaf->value.first);
+				insert(&this->_root, leaf, key, 0);
+				leaf->next = next;
+				leaf->prev = (next == NULL ? this->_tail : next->prev);
+				if (leaf->prev == NULL)
+					this->_head = leaf;
+				else
+					leaf->prev->next = leaf;
+				if (next == NULL)
+					this->_tail = leaf;
+				else
+					next->prev = leaf;
+				++this->_size;
+				return (ft::make_pair(leaf, true));
+			}
+
+			void erase(Leaf* leaf)
+			{
+				RadixKey<Key> key(leaf->value.first);
+				erase(&this->_root, leaf, key, 0);
+				if (leaf->prev == NULL)
+					this->_head = leaf->next;
+				else
+					leaf->prev->next = leaf->next;
+				if (leaf->next == NULL)
+					this->_tail = leaf->prev;
+				else
+					leaf->next->prev = leaf->prev;
+				delete leaf;
+				--this->_size;
+			}
+
+			void clear()
+			{
+				destroy(this->_root);
+				this->_root = NULL;
+				this->_head = NULL;
+				this->_tail = NULL;
+				this->_size = 0;
+			}
+
+			void swap(RadixTree& x)
+			{
+				swap(this->_root, x._root);
+				swap(this->_head, x._head);
+				swap(this->_tail, x._tail);
+				swap(this->_size, x._size);
+			}
+
+			// inner nodes by kind (4, 16, 48, 256 children), for tuning and tests
+			void node_counts(size_type counts[4]) const
+			{
+				for (size_t i = 0; i < 4; ++i)
+					counts[i] = 0;
+				count_nodes(this->_root, counts);
+			}
+
+			// every leaf sits where its key leads, inner nodes hold at least two entries in
+			// byte order and the leaf chain is the in-order walk; for tests
+			bool verify() const
+			{
+				Leaf* prev = NULL;
+				size_type seen = 0;
+				if (!check(this->_root, 0, prev, seen) || prev != this->_tail || seen != this->_size)
+					return (false);
+				return (this->_size == 0 ? this->_head == NULL : this->_head->prev == NULL && this->_tail->next == NULL);
+			}
+
+		private :
+			static bool equal(const Key& a, const Key& b)
+			{
+				return (!(a < b) && !(b < a));
+			}
+
+			static Leaf* min_leaf(Node* n)
+			{
+				while (n->type != LEAF)
+				{
+					Inner* in = static_cast<Inner*>(n);
+					if (in->terminal != NULL)
+						return (in->terminal);
+					n = child_from(in, 0);
+				}
+				return (static_cast<Leaf*>(n));
+			}
+
+			// n's prefix byte i; bytes past the inline ones come from a leaf below n
+			static unsigned char prefix_byte(Inner* in, size_t i, size_t depth)
+			{
+				if (i < INLINE_PREFIX)
+					return (in->prefix[i]);
+				Leaf* leaf = min_leaf(in);
+				RadixKey<Key> key(leaf->value.first);
+				return (key.data()[depth + i]);
+			}
+
+			// how many of in's prefix bytes are kept in the node
+			static size_t inline_prefix(Inner* in)
+			{
+				return (in->prefix_len < static_cast<size_t>(INLINE_PREFIX) ? in->prefix_len : static_cast<size_t>(INLINE_PREFIX));
+			}
+
+			static void set_prefix(Inner* in, const unsigned char* bytes, size_t len)
+			{
+				in->prefix_len = len;
+				std::memcpy(in->prefix, bytes, inline_prefix(in));
+			}
+
+			// first index where in's prefix and key (from depth) differ, prefix_len if none
+			static size_t mismatch(Inner* in, const RadixKey<Key>& key, size_t depth)
+			{
+				size_t inline_len = inline_prefix(in);
+				for (size_t i = 0; i < inline_len; ++i)
+					if (depth + i == key.size() || in->prefix[i] != key.data()[depth + i])
+						return (i);
+				if (in->prefix_len <= INLINE_PREFIX)
+					return (in->prefix_len);
+				RadixKey<Key> full(min_leaf(in)->value.first);
+				for (size_t i = INLINE_PREFIX; i < in->prefix_len; ++i)
+					if (depth + i == key.size() || full.data()[depth + i] != key.data()[depth + i])
+						return (i);
+				return (in->prefix_len);
+			}
+
+			static Node** find_child(Inner* in, unsigned char b)
+			{
+				switch (in->type)
+				{
+					case NODE4:
+					{
+						Node4* n = static_cast<Node4*>(in);
+						for (size_t i = 0; i < n->count; ++i)
+							if (n->keys[i] == b)
+								return (&n->children[i]);
+						return (NULL);
+					}
+					case NODE16:
+					{
+						Node16* n = static_cast<Node16*>(in);
+						for (size_t i = 0; i < n->count && n->keys[i] <= b; ++i)
+							if (n->keys[i] == b)
+								return (&n->children[i]);
+						return (NULL);
+					}
+					case NODE48:
+					{
+						Node48* n = static_cast<Node48*>(in);
+						return (n->index[b] == 0 ? NULL : &n->children[n->index[b] - 1]);
+					}
+					default:
+					{
+						Node256* n = static_cast<Node256*>(in);
+						return (n->children[b] == NULL ? NULL : &n->children[b]);
+					}
+				}
+			}
+
+			// the child with the smallest byte >= from (0 to 256), NULL when there is none
+			static Node* child_from(Inner* in, size_t from)
+			{
+				switch (in->type)
+				{
+					case NODE4:
+					case NODE16:
+					{
+						unsigned char* keys = (in->type == NODE4 ? static_cast<Node4*>(in)->keys : static_cast<Node16*>(in)->keys);
+						Node** children = (in->type == NODE4 ? static_cast<Node4*>(in)->children : static_cast<Node16*>(in)->children);
+						for (size_t i = 0; i < in->count; ++i)
+							if (keys[i] >= from)
+								return (children[i]);
+						return (NULL);
+					}
+					case NODE48:
+					{
+						Node48* n = static_cast<Node48*>(in);
+						for (size_t b = from; b < 256; ++b)
+							if (n->index[b] != 0)
+								return (n->children[n->index[b] - 1]);
+						return (NULL);
+					}
+					default:
+					{
+						Node256* n = static_cast<Node256*>(in);
+						for (size_t b = from; b < 256; ++b)
+							if (n->children[b] != NULL)
+								return (n->children[b]);
+						return (NULL);
+					}
+				}
+			}
+
+			// in must have room
+			static void add_child(Inner* in, unsigned char b, Node* child)
+			{
+				switch (in->type)
+				{
+					case NODE4:
+					case NODE16:
+					{
+						unsigned char* keys = (in->type == NODE4 ? static_cast<Node4*>(in)->keys : static_cast<Node16*>(in)->keys);
+						Node** children = (in->type == NODE4 ? static_cast<Node4*>(in)->children : static_cast<Node16*>(in)->children);
+						size_t i = in->count;
+						for (; i > 0 && keys[i - 1] > b; --i)
+						{
+							keys[i] = keys[i - 1];
+							children[i] = children[i - 1];
+						}
+						keys[i] = b;
+						children[i] = child;
+						break ;
+					}
+					case NODE48:
+					{
+						Node48* n = static_cast<Node48*>(in);
+						size_t slot = 0;
+						while (n->children[slot] != NULL)
+							++slot;
+						n->children[slot] = child;
+						n->index[b] = static_cast<unsigned char>(slot + 1);
+						break ;
+					}
+					default:
+						static_cast<Node256*>(in)->children[b] = child;
+				}
+				++in->count;
+			}
+
+			static void remove_child(Inner* in, unsigned char b)
+			{
+				switch (in->type)
+				{
+					case NODE4:
+					case NODE16:
+					{
+						unsigned char* keys = (in->type == NODE4 ? static_cast<Node4*>(in)->keys : static_cast<Node16*>(in)->keys);
+						Node** children = (in->type == NODE4 ? static_cast<Node4*>(in)->children : static_cast<Node16*>(in)->children);
+						size_t i = 0;
+						while (keys[i] != b)
+							++i;
+						for (; i + 1 < in->count; ++i)
+						{
+							keys[i] = keys[i + 1];
+							children[i] = children[i + 1];
+						}
+						break ;
+					}
+					case NODE48:
+					{
+						Node48* n = static_cast<Node48*>(in);
+						n->children[n->index[b] - 1] = NULL;
+						n->index[b] = 0;
+						break ;
+					}
+					default:
+						static_cast<Node256*>(in)->children[b] = NULL;
+				}
+				--in->count;
+			}
+
+			static size_t capacity(Inner* in)
+			{
+				switch (in->type)
+				{
+					case NODE4:
+						return (4);
+					case NODE16:
+						return (16);
+					case NODE48:
+						return (48);
+					default:
+						return (256);
+				}
+			}
+
+			// a node of kind type holding in's prefix, terminal and children; in is freed
+			static Inner* resize(Inner* in, unsigned char type)
+			{
+				Inner* res;
+				if (type == NODE4)
+					res = new Node4;
+				else if (type == NODE16)
+					res = new Node16;
+				else if (type == NODE48)
+					res = new Node48;
+				else
+					res = new Node256;
+				res->prefix_len = in->prefix_len;
+				std::memcpy(res->prefix, in->prefix, INLINE_PREFIX);
+				res->terminal = in->terminal;
+				for (size_t b = 0; b < 256; ++b)
+				{
+					Node** child = find_child(in, static_cast<unsigned char>(b));
+					if (child != NULL)
+						add_child(res, static_cast<unsigned char>(b), *child);
+				}
+				delete_inner(in);
+				return (res);
+			}
+
+			static void delete_inner(Inner* in)
+			{
+				switch (in->type)
+				{
+					case NODE4:
+						delete static_cast<Node4*>(in);
+						break ;
+					case NODE16:
+						delete static_cast<Node16*>(in);
+						break ;
+					case NODE48:
+						delete static_cast<Node48*>(in);
+						break ;
+					default:
+						delete static_cast<Node256*>(in);
+				}
+			}
+
+			// leaf goes in the node where key ends at depth, or under byte key[depth]
+			static void place(Inner* in, Leaf* leaf, const RadixKey<Key>& key, size_t depth)
+			{
+				if (depth == key.size())
+					in->terminal = leaf;
+				else
+					add_child(in, key.data()[depth], leaf);
+			}
+
+			// links a leaf whose key is not in the tree yet
+			void insert(Node** ref, Leaf* leaf, const RadixKey<Key>& key, size_t depth)
+			{
+				while (*ref != NULL)
+				{
+					Node* n = *ref;
+					if (n->type == LEAF)
+					{
+						// two keys under one slot: a node for the bytes they share
+						RadixKey<Key> other(static_cast<Leaf*>(n)->value.first);
+						size_t len = (key.size() < other.size() ? key.size() : other.size());
+						size_t common = depth;
+						while (common < len && key.data()[common] == other.data()[common])
+							++common;
+						Node4* node = new Node4;
+						set_prefix(node, key.data() + depth, common - depth);
+						place(node, static_cast<Leaf*>(n), other, common);
+						place(node, leaf, key, common);
+						*ref = node;
+						return ;
+					}
+					Inner* in = static_cast<Inner*>(n);
+					size_t p = mismatch(in, key, depth);
+					if (p < in->prefix_len)
+					{
+						// key leaves the prefix at p: a node for the first p bytes above in
+						unsigned char rest[INLINE_PREFIX];
+						for (size_t i = 0; i < INLINE_PREFIX && p + 1 + i < in->prefix_len; ++i)
+							rest[i] = prefix_byte(in, p + 1 + i, depth);
+						unsigned char b = prefix_byte(in, p, depth);
+						Node4* node = new Node4;
+						set_prefix(node, key.data() + depth, p);
+						set_prefix(in, rest, in->prefix_len - p - 1);
+						add_child(node, b, in);
+						place(node, leaf, key, depth + p);
+						*ref = node;
+						return ;
+					}
+					depth += in->prefix_len;
+					if (depth == key.size())
+					{
+						in->terminal = leaf;
+						return ;
+					}
+					Node** child = find_child(in, key.data()[depth]);
+					if (child == NULL)
+					{
+						if (in->count == capacity(in))
+						{
+							in = resize(in, in->type + 1);
+							*ref = in;
+						}
+						add_child(in, key.data()[depth], leaf);
+						return ;
+					}
+					ref = child;
+					++depth;
+				}
+				*ref = leaf;
+			}
+
+			// unlinks leaf from the subtree at ref, shrinking the nodes on the way back up
+			void erase(Node** ref, Leaf* leaf, const RadixKey<Key>& key, size_t depth)
+			{
+				Node* n = *ref;
+				if (n == leaf)
+				{
+					*ref = NULL;
+					return ;
+				}
+				Inner* in = static_cast<Inner*>(n);
+				depth += in->prefix_len;
+				if (depth == key.size())
+					in->terminal = NULL;
+				else
+				{
+					unsigned char b = key.data()[depth];
+					Node** child = find_child(in, b);
+					if (*child == leaf)
+						remove_child(in, b);
+					else
+						erase(child, leaf, key, depth + 1);
+				}
+				shrink(ref, depth - in->prefix_len);
+			}
+
+			// in (at *ref) after an erase: a smaller node kind once it is sparse enough, and
+			// gone once a single entry is left, which takes its place
+			void shrink(Node** ref, size_t depth)
+			{
+				Inner* in = static_cast<Inner*>(*ref);
+				if (in->count + (in->terminal != NULL) >= 2)
+				{
+					if ((in->type == NODE256 && in->count <= 40) || (in->type == NODE48 && in->count <= 12)
+						|| (in->type == NODE16 && in->count <= 3))
+						*ref = resize(in, in->type - 1);
+					return ;
+				}
+				if (in->count == 0)
+				{
+					*ref = in->terminal;
+					delete_inner(in);
+					return ;
+				}
+				size_t b = 0;
+				while (find_child(in, static_cast<unsigned char>(b)) == NULL)
+					++b;
+				Node* child = *find_child(in, static_cast<unsigned char>(b));
+				if (child->type != LEAF)
+				{
+					// in's prefix, b and the child's prefix make the child's new prefix
+					Inner* c = static_cast<Inner*>(child);
+					unsigned char bytes[INLINE_PREFIX];
+					size_t n = 0;
+					for (; n < INLINE_PREFIX && n < in->prefix_len; ++n)
+						bytes[n] = prefix_byte(in, n, depth);
+					if (n < INLINE_PREFIX)
+						bytes[n++] = static_cast<unsigned char>(b);
+					for (size_t i = 0; n < INLINE_PREFIX && i < c->prefix_len; ++i)
+						bytes[n++] = c->prefix[i];
+					size_t len = in->prefix_len + 1 + c->prefix_len;
+					set_prefix(c, bytes, n);
+					c->prefix_len = len;
+				}
+				*ref = child;
+				delete_inner(in);
+			}
+
+			Leaf* lower_bound(Node* n, const Key& k, const RadixKey<Key>& key, size_t depth) const
+			{
+				if (n == NULL)
+					return (NULL);
+				if (n->type == LEAF)
+				{
+					Leaf* leaf = static_cast<Leaf*>(n);
+					return (leaf->value.first < k ? NULL : leaf);
+				}
+				Inner* in = static_cast<Inner*>(n);
+				size_t p = mismatch(in, key, depth);
+				if (p < in->prefix_len)
+				{
+					// the subtree is all above key when key ends or is smaller there
+					if (depth + p == key.size() || prefix_byte(in, p, depth) > key.data()[depth + p])
+						return (min_leaf(in));
+					return (NULL);
+				}
+				depth += in->prefix_len;
+				if (depth == key.size())
+					return (min_leaf(in));
+				unsigned char b = key.data()[depth];
+				Node** child = find_child(in, b);
+				if (child != NULL)
+				{
+					Leaf* res = lower_bound(*child, k, key, depth + 1);
+					if (res != NULL)
+						return (res);
+				}
+				Node* next = child_from(in, static_cast<size_t>(b) + 1);
+				return (next == NULL ? NULL : min_leaf(next));
+			}
+
+			void destroy(Node* n)
+			{
+				if (n == NULL)
+					return ;
+				if (n->type == LEAF)
+				{
+					delete static_cast<Leaf*>(n);
+					return ;
+				}
+				Inner* in = static_cast<Inner*>(n);
+				destroy(in->terminal);
+				for (size_t b = 0; b < 256; ++b)
+				{
+					Node** child = find_child(in, static_cast<unsigned char>(b));
+					if (child != NULL)
+						destroy(*child);
+				}
+				delete_inner(in);
+			}
+
+			static void count_nodes(Node* n, size_type counts[4])
+			{
+				if (n == NULL || n->type == LEAF)
+					return ;
+				Inner* in = static_cast<Inner*>(n);
+				++counts[in->type - NODE4];
+				for (size_t b = 0; b < 256; ++b)
+				{
+					Node** child = find_child(in, static_cast<unsigned char>(b));
+					if (child != NULL)
+						count_nodes(*child, counts);
+				}
+			}
+
+			bool check(Node* n, size_t depth, Leaf*& prev, size_type& seen) const
+			{
+				if (n == NULL)
+					return (this->_size == 0);
+				if (n->type == LEAF)
+				{
+					Leaf* leaf = static_cast<Leaf*>(n);
+					if (leaf->prev != prev || (prev != NULL && !(prev->value.first < leaf->value.first)))
+						return (false);
+					prev = leaf;
+					++seen;
+					return (find(leaf->value.first) == leaf);
+				}
+				Inner* in = static_cast<Inner*>(n);
+				size_t entries = (in->terminal != NULL);
+				if (in->terminal != NULL && !check(in->terminal, depth, prev, seen))
+					return (false);
+				for (size_t b = 0; b < 256; ++b)
+				{
+					Node** child = find_child(in, static_cast<unsigned char>(b));
+					if (child == NULL)
+						continue ;
+					if (*child == NULL || !check(*child, depth + in->prefix_len + 1, prev, seen))
+						return (false);
+					++entries;
+				}
+				return (entries >= 2 && entries == static_cast<size_t>(in->count + (in->terminal != NULL)) && in->count <= capacity(in));
+			}
+
+			template <typename _T>
+			static void swap(_T& a, _T& b)
+			{
+				_T tmp(a);
+				a = b;
+				b = tmp;
+			}
+	};
+}
+
+#endif
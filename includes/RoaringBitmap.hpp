@@ -0,0 +1,262 @@
+#ifndef ROARINGBITMAP_HPP
+# define ROARINGBITMAP_HPP
+
+#include <cstddef>
+#include <vector>
+#include "RoaringContainer.hpp"
+
+namespace ft
+{
+	// the storage of roaring_set: 32-bit values split into chunks by their high 16 bits,
+	// the chunk keys in a sorted array next to one RoaringContainer per chunk holding the
+	// low 16 bits. Chunks are never empty.
+	class RoaringBitmap {
+		private :
+			std::vector<unsigned short>		_keys;
+			std::vector<RoaringContainer*>	_chunks;
+			size_t	_size;
+
+		public :
+			RoaringBitmap() : _size(0) {}
+
+			RoaringBitmap(const RoaringBitmap& x) : _size(0)
+			{
+				*this = x;
+			}
+
+			~RoaringBitmap()
+			{
+				clear();
+			}
+
+			RoaringBitmap& operator=(const RoaringBitmap& x)
+			{
+				if (this == &x)
+					return (*this);
+				clear();
+				this->_chunks.reserve(x._chunks.size());
+				for (size_t i = 0; i < x._chunks.size(); ++i)
+					this->_chunks.push_back(new RoaringContainer(*x._chunks[i]));
+				this->_keys = x._keys;
+				this->_size = x._size;
+				return (*this);
+			}
+
+			size_t size() const
+			{
+				return (this->_size);
+			}
+
+			size_t chunks() const
+			{
+				return (this->_chunks.size());
+			}
+
+			unsigned int key(size_t i) const
+			{
+				return (this->_keys[i]);
+			}
+
+			const RoaringContainer& chunk(size_t i) const
+			{
+				return (*this->_chunks[i]);
+			}
+
+			// first chunk whose key is not less than high; appends hit the last chunk, which
+			// is tried before searching
+			size_t chunk_index(unsigned int high) const
+			{
+				size_t count = this->_keys.size();
+				if (count == 0 || this->_keys[count - 1] < high)
+					return (count);
+				if (this->_keys[count - 1] == high)
+					return (count - 1);
+				size_t first = 0;
+				while (count > 0)
+				{
+					size_t half = count / 2;
+					if (this->_keys[first + half] < high)
+					{
+						first += half + 1;
+						count -= half + 1;
+					}
+					else
+						count = half;
+				}
+				return (first);
+			}
+
+			bool contains(unsigned int val) const
+			{
+				size_t i = chunk_index(val >> 16);
+				return (i < this->_keys.size() && this->_keys[i] == (val >> 16) && this->_chunks[i]->contains(val & 0xffff));
+			}
+
+			// false when val was in already; index is its chunk either way
+			bool add(unsigned int val, size_t& index)
+			{
+				unsigned int high = val >> 16;
+				index = chunk_index(high);
+				if (index == this->_keys.size() || this->_keys[index] != high)
+				{
+					RoaringContainer* chunk = new RoaringContainer();
+					this->_chunks.insert(this->_chunks.begin() + index, chunk);
+					this->_keys.insert(this->_keys.begin() + index, static_cast<unsigned short>(high));
+				}
+				if (!this->_chunks[index]->add(val & 0xffff))
+					return (false);
+				++this->_size;
+				return (true);
+			}
+
+			// false when val was not in
+			bool remove(unsigned int val)
+			{
+				size_t i = chunk_index(val >> 16);
+				if (i == this->_keys.size() || this->_keys[i] != (val >> 16) || !this->_chunks[i]->remove(val & 0xffff))
+					return (false);
+				--this->_size;
+				if (this->_chunks[i]->empty())
+				{
+					delete this->_chunks[i];
+					this->_chunks.erase(this->_chunks.begin() + i);
+					this->_keys.erase(this->_keys.begin() + i);
+				}
+				return (true);
+			}
+
+			// the first value not less than val as chunk index, position in the chunk and low
+			// 16 bits; false if there is none
+			bool seek(unsigned int val, size_t& index, unsigned int& pos, unsigned int& low) const
+			{
+				size_t i = chunk_index(val >> 16);
+				if (i == this->_keys.size())
+					return (false);
+				if (this->_keys[i] == (val >> 16))
+				{
+					if (this->_chunks[i]->seek(val & 0xffff, pos, low))
+					{
+						index = i;
+						return (true);
+					}
+					if (++i == this->_keys.size())
+						return (false);
+				}
+				this->_chunks[i]->first(pos, low);
+				index = i;
+				return (true);
+			}
+
+			// this = this | x, chunk by chunk; chunks only x has are copied
+			void unite(const RoaringBitmap& x)
+			{
+				if (this == &x)
+					return ;
+				std::vector<unsigned short> keys;
+				std::vector<RoaringContainer*> chunks;
+				keys.reserve(this->_keys.size() + x._keys.size());
+				chunks.reserve(this->_keys.size() + x._keys.size());
+				size_t i = 0;
+				size_t j = 0;
+				this->_size = 0;
+				while (i < this->_keys.size() || j < x._keys.size())
+				{
+					if (j == x._keys.size() || (i < this->_keys.size() && this->_keys[i] < x._keys[j]))
+					{
+						keys.push_back(this->_keys[i]);
+						chunks.push_back(this->_chunks[i++]);
+					}
+					else if (i == this->_keys.size() || x._keys[j] < this->_keys[i])
+					{
+						keys.push_back(x._keys[j]);
+						chunks.push_back(new RoaringContainer(*x._chunks[j++]));
+					}
+					else
+					{
+						this->_chunks[i]->unite(*x._chunks[j++]);
+						keys.push_back(this->_keys[i]);
+						chunks.push_back(this->_chunks[i++]);
+					}
+					this->_size += chunks.back()->size();
+				}
+				this->_keys.swap(keys);
+				this->_chunks.swap(chunks);
+			}
+
+			// this = this & x, chunk by chunk; chunks left empty are dropped
+			void intersect(const RoaringBitmap& x)
+			{
+				if (this == &x)
+					return ;
+				size_t out = 0;
+				size_t j = 0;
+				this->_size = 0;
+				for (size_t i = 0; i < this->_keys.size(); ++i)
+				{
+					while (j < x._keys.size() && x._keys[j] < this->_keys[i])
+						++j;
+					if (j < x._keys.size() && x._keys[j] == this->_keys[i])
+					{
+						this->_chunks[i]->intersect(*x._chunks[j]);
+						if (!this->_chunks[i]->empty())
+						{
+							this->_size += this->_chunks[i]->size();
+							this->_keys[out] = this->_keys[i];
+							this->_chunks[out++] = this->_chunks[i];
+							continue ;
+						}
+					}
+					delete this->_chunks[i];
+				}
+				this->_keys.resize(out);
+				this->_chunks.resize(out);
+			}
+
+			void optimize()
+			{
+				for (size_t i = 0; i < this->_chunks.size(); ++i)
+					this->_chunks[i]->optimize();
+				std::vector<unsigned short>(this->_keys).swap(this->_keys);
+				std::vector<RoaringContainer*>(this->_chunks).swap(this->_chunks);
+			}
+
+			size_t bytes_used() const
+			{
+				size_t bytes = sizeof(*this) + this->_keys.capacity() * sizeof(unsigned short)
+					+ this->_chunks.capacity() * sizeof(RoaringContainer*);
+				for (size_t i = 0; i < this->_chunks.size(); ++i)
+					bytes += this->_chunks[i]->bytes_used();
+				return (bytes);
+			}
+
+			// chunks stored as arrays, bitmaps and runs
+			void chunk_counts(size_t counts[3]) const
+			{
+				counts[0] = 0;
+				counts[1] = 0;
+				counts[2] = 0;
+				for (size_t i = 0; i < this->_chunks.size(); ++i)
+					++counts[this->_chunks[i]->kind()];
+			}
+
+			void clear()
+			{
+				for (size_t i = 0; i < this->_chunks.size(); ++i)
+					delete this->_chunks[i];
+				this->_chunks.clear();
+				this->_keys.clear();
+				this->_size = 0;
+			}
+
+			void swap(RoaringBitmap& x)
+			{
+				this->_keys.swap(x._keys);
+				this->_chunks.swap(x._chunks);
+				size_t size = this->_size;
+				this->_size = x._size;
+				x._size = size;
+			}
+	};
+}
+
+#endif
@@ -0,0 +1,679 @@
+#ifndef ROARINGCONTAINER_HPP
+# define ROARINGCONTAINER_HPP
+
+#include <cstddef>
+#include <vector>
+
+// no-alias promise on the bitmap word loops, which lets -O2 vectorize them
+#if defined(__GNUC__)
+# define FT_RESTRICT __restrict__
+#else
+# define FT_RESTRICT
+#endif
+
+namespace ft
+{
+	// set bits of a word, by halves (SWAR) rather than a builtin, so that loops over
+	// bitmap words stay vectorizable without -mpopcnt
+	inline unsigned int popcount64(unsigned long long x)
+	{
+		x -= (x >> 1) & 0x5555555555555555ULL;
+		x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+		x = (x + (x >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+		x += x >> 8;
+		x += x >> 16;
+		x += x >> 32;
+		return (static_cast<unsigned int>(x & 0x7f));
+	}
+
+	// index of the lowest set bit of a non-zero word
+	inline unsigned int lowest_bit(unsigned long long x)
+	{
+#if defined(__GNUC__)
+		return (static_cast<unsigned int>(__builtin_ctzll(x)));
+#else
+		unsigned int i = 0;
+		while (!(x & 1))
+		{
+			x >>= 1;
+			++i;
+		}
+		return (i);
+#endif
+	}
+
+	// index of the highest set bit of a non-zero word
+	inline unsigned int highest_bit(unsigned long long x)
+	{
+#if defined(__GNUC__)
+		return (63 - static_cast<unsigned int>(__builtin_clzll(x)));
+#else
+		unsigned int i = 63;
+		while (!(x >> i))
+			--i;
+		return (i);
+#endif
+	}
+
+	// the values of a roaring_set that share their high 16 bits, kept as their low 16 bits
+	// in one of three layouts: a sorted array up to ARRAY_MAX values (2 bytes each), a
+	// 65536-bit bitmap above that (8KB), or sorted runs of consecutive values (4 bytes a
+	// run), which optimize() picks where they are the smallest. A run container falls
+	// back to an array or bitmap once edits make it larger than those.
+	class RoaringContainer {
+		public :
+			enum Kind { ARRAY, BITMAP, RUN };
+			enum { ARRAY_MAX = 4096, WORDS = 1024 };
+
+		private :
+			Kind	_kind;
+			size_t	_card;
+			std::vector<unsigned short>		_values;	// ARRAY: the values; RUN: start, length - 1 pairs
+			std::vector<unsigned long long>	_bits;		// BITMAP: WORDS words
+
+		public :
+			RoaringContainer() : _kind(ARRAY), _card(0) {}
+
+			Kind kind() const
+			{
+				return (this->_kind);
+			}
+
+			size_t size() const
+			{
+				return (this->_card);
+			}
+
+			bool empty() const
+			{
+				return (this->_card == 0);
+			}
+
+			size_t bytes_used() const
+			{
+				return (sizeof(*this) + this->_values.capacity() * sizeof(unsigned short)
+					+ this->_bits.capacity() * sizeof(unsigned long long));
+			}
+
+			bool contains(unsigned int low) const
+			{
+				if (this->_kind == BITMAP)
+					return ((this->_bits[low >> 6] >> (low & 63)) & 1);
+				if (this->_kind == ARRAY)
+				{
+					size_t i = lower(low);
+					return (i < this->_card && this->_values[i] == low);
+				}
+				size_t r = runs_upto(low);
+				return (r > 0 && low <= run_end(r - 1));
+			}
+
+			// false when low was in already
+			bool add(unsigned int low)
+			{
+				if (this->_kind == BITMAP)
+				{
+					unsigned long long& word = this->_bits[low >> 6];
+					unsigned long long bit = 1ULL << (low & 63);
+					if (word & bit)
+						return (false);
+					word |= bit;
+					++this->_card;
+					return (true);
+				}
+				if (this->_kind == RUN)
+					return (add_to_run(low));
+				size_t i = lower(low);
+				if (i < this->_card && this->_values[i] == low)
+					return (false);
+				if (this->_card == ARRAY_MAX)
+				{
+					to_bitmap();
+					return (add(low));
+				}
+				this->_values.insert(this->_values.begin() + i, static_cast<unsigned short>(low));
+				++this->_card;
+				return (true);
+			}
+
+			// false when low was not in
+			bool remove(unsigned int low)
+			{
+				if (this->_kind == BITMAP)
+				{
+					unsigned long long& word = this->_bits[low >> 6];
+					unsigned long long bit = 1ULL << (low & 63);
+					if (!(word & bit))
+						return (false);
+					word &= ~bit;
+					if (--this->_card <= ARRAY_MAX)
+						to_array();
+					return (true);
+				}
+				if (this->_kind == RUN)
+					return (remove_from_run(low));
+				size_t i = lower(low);
+				if (i == this->_card || this->_values[i] != low)
+					return (false);
+				this->_values.erase(this->_values.begin() + i);
+				--this->_card;
+				return (true);
+			}
+
+			// ordered walk, on a position pos (an array or run index, unused by bitmaps) and
+			// the value low found there; the container must not be empty
+			void first(unsigned int& pos, unsigned int& low) const
+			{
+				seek(0, pos, low);
+			}
+
+			void last(unsigned int& pos, unsigned int& low) const
+			{
+				seek_back(0xffff, pos, low);
+			}
+
+			// to the next value, false past the last
+			bool next(unsigned int& pos, unsigned int& low) const
+			{
+				if (this->_kind == ARRAY)
+				{
+					if (pos + 1 >= this->_card)
+						return (false);
+					low = this->_values[++pos];
+					return (true);
+				}
+				if (this->_kind == RUN)
+				{
+					if (low < run_end(pos))
+						++low;
+					else if (2 * (pos + 1) < this->_values.size())
+						low = this->_values[2 * ++pos];
+					else
+						return (false);
+					return (true);
+				}
+				return (low < 0xffff && seek(low + 1, pos, low));
+			}
+
+			// to the previous value, false before the first
+			bool prev(unsigned int& pos, unsigned int& low) const
+			{
+				if (this->_kind == ARRAY)
+				{
+					if (pos == 0)
+						return (false);
+					low = this->_values[--pos];
+					return (true);
+				}
+				if (this->_kind == RUN)
+				{
+					if (low > this->_values[2 * pos])
+						--low;
+					else if (pos > 0)
+						low = run_end(--pos);
+					else
+						return (false);
+					return (true);
+				}
+				return (low > 0 && seek_back(low - 1, pos, low));
+			}
+
+			// to the first value not less than target, false if there is none
+			bool seek(unsigned int target, unsigned int& pos, unsigned int& low) const
+			{
+				if (this->_kind == ARRAY)
+				{
+					size_t i = lower(target);
+					if (i == this->_card)
+						return (false);
+					pos = static_cast<unsigned int>(i);
+					low = this->_values[i];
+					return (true);
+				}
+				if (this->_kind == RUN)
+				{
+					size_t r = runs_upto(target);
+					if (r > 0 && target <= run_end(r - 1))
+					{
+						pos = static_cast<unsigned int>(r - 1);
+						low = target;
+						return (true);
+					}
+					if (2 * r == this->_values.size())
+						return (false);
+					pos = static_cast<unsigned int>(r);
+					low = this->_values[2 * r];
+					return (true);
+				}
+				size_t w = target >> 6;
+				unsigned long long word = this->_bits[w] & (~0ULL << (target & 63));
+				while (word == 0)
+				{
+					if (++w == WORDS)
+						return (false);
+					word = this->_bits[w];
+				}
+				low = static_cast<unsigned int>(w * 64 + lowest_bit(word));
+				return (true);
+			}
+
+			// to the last value not greater than target, false if there is none
+			bool seek_back(unsigned int target, unsigned int& pos, unsigned int& low) const
+			{
+				if (this->_kind == ARRAY)
+				{
+					size_t i = lower(target + 1);
+					if (i == 0)
+						return (false);
+					pos = static_cast<unsigned int>(i - 1);
+					low = this->_values[i - 1];
+					return (true);
+				}
+				if (this->_kind == RUN)
+				{
+					size_t r = runs_upto(target);
+					if (r == 0)
+						return (false);
+					pos = static_cast<unsigned int>(r - 1);
+					low = (target <= run_end(r - 1) ? target : run_end(r - 1));
+					return (true);
+				}
+				size_t w = target >> 6;
+				unsigned long long word = this->_bits[w] & (~0ULL >> (63 - (target & 63)));
+				while (word == 0)
+				{
+					if (w-- == 0)
+						return (false);
+					word = this->_bits[w];
+				}
+				low = static_cast<unsigned int>(w * 64 + highest_bit(word));
+				return (true);
+			}
+
+			// this = this | x. Two bitmaps are or-ed word by word in a loop the compiler
+			// vectorizes, counting as it goes; arrays are merged, or set into a bitmap once
+			// the union may outgrow ARRAY_MAX.
+			void unite(const RoaringContainer& x)
+			{
+				if (x._kind == RUN)
+				{
+					RoaringContainer flat(x);
+					flat.flatten();
+					unite(flat);
+					return ;
+				}
+				flatten();
+				if (this->_kind == ARRAY && x._kind == BITMAP)
+				{
+					RoaringContainer res(x);
+					res.unite(*this);
+					swap(res);
+					return ;
+				}
+				if (this->_kind == ARRAY && this->_card + x._card > ARRAY_MAX)
+					to_bitmap();
+				if (this->_kind == ARRAY)
+				{
+					std::vector<unsigned short> res;
+					res.reserve(this->_card + x._card);
+					size_t i = 0;
+					size_t j = 0;
+					while (i < this->_card && j < x._card)
+					{
+						unsigned short a = this->_values[i];
+						unsigned short b = x._values[j];
+						res.push_back(a < b ? a : b);
+						i += (a <= b);
+						j += (b <= a);
+					}
+					res.insert(res.end(), this->_values.begin() + i, this->_values.end());
+					res.insert(res.end(), x._values.begin() + j, x._values.end());
+					this->_values.swap(res);
+					this->_card = this->_values.size();
+				}
+				else if (x._kind == ARRAY)
+				{
+					for (size_t j = 0; j < x._card; ++j)
+					{
+						unsigned long long& word = this->_bits[x._values[j] >> 6];
+						unsigned long long bit = 1ULL << (x._values[j] & 63);
+						this->_card += !(word & bit);
+						word |= bit;
+					}
+					// two arrays that overlap enough
+					if (this->_card <= ARRAY_MAX)
+						to_array();
+				}
+				else
+					this->_card = or_words(&this->_bits[0], &x._bits[0]);
+			}
+
+			// this = this & x, which may leave it empty. Two bitmaps are and-ed like unite()
+			// ors them; an array is filtered through a bitmap or merged with another array,
+			// by binary searches in the larger one when it is 32 times the size or more.
+			void intersect(const RoaringContainer& x)
+			{
+				if (x._kind == RUN)
+				{
+					RoaringContainer flat(x);
+					flat.flatten();
+					intersect(flat);
+					return ;
+				}
+				flatten();
+				if (this->_kind == BITMAP && x._kind == ARRAY)
+				{
+					RoaringContainer res(x);
+					res.intersect(*this);
+					swap(res);
+					return ;
+				}
+				if (this->_kind == ARRAY)
+				{
+					size_t out = 0;
+					if (x._kind == BITMAP)
+					{
+						for (size_t i = 0; i < this->_card; ++i)
+						{
+							unsigned short v = this->_values[i];
+							this->_values[out] = v;
+							out += (x._bits[v >> 6] >> (v & 63)) & 1;
+						}
+					}
+					else if (x._card >= 32 * this->_card)
+					{
+						for (size_t i = 0; i < this->_card; ++i)
+						{
+							this->_values[out] = this->_values[i];
+							out += x.contains(this->_values[i]);
+						}
+					}
+					else if (this->_card >= 32 * x._card)
+					{
+						for (size_t j = 0; j < x._card; ++j)
+						{
+							this->_values[out] = x._values[j];
+							out += contains(x._values[j]);
+						}
+					}
+					else
+					{
+						size_t i = 0;
+						size_t j = 0;
+						while (i < this->_card && j < x._card)
+						{
+							unsigned short a = this->_values[i];
+							unsigned short b = x._values[j];
+							this->_values[out] = a;
+							out += (a == b);
+							i += (a <= b);
+							j += (b <= a);
+						}
+					}
+					this->_values.resize(out);
+					this->_card = out;
+					return ;
+				}
+				this->_card = and_words(&this->_bits[0], &x._bits[0]);
+				if (this->_card <= ARRAY_MAX)
+					to_array();
+			}
+
+			// turns the container into runs where they take the least room, and gives back
+			// the spare capacity of arrays
+			void optimize()
+			{
+				if (this->_kind == RUN)
+					return ;
+				size_t runs = count_runs();
+				if (runs * 4 < (this->_kind == ARRAY ? this->_card * 2 : WORDS * 8))
+					to_runs();
+				else if (this->_kind == ARRAY && this->_values.capacity() > this->_card)
+					std::vector<unsigned short>(this->_values).swap(this->_values);
+			}
+
+			void swap(RoaringContainer& x)
+			{
+				Kind kind = this->_kind;
+				this->_kind = x._kind;
+				x._kind = kind;
+				size_t card = this->_card;
+				this->_card = x._card;
+				x._card = card;
+				this->_values.swap(x._values);
+				this->_bits.swap(x._bits);
+			}
+
+		private :
+			// a |= b over two distinct bitmaps, returning the bits set in a; two 64-bit
+			// lanes (or more, as the target allows) per instruction
+			static size_t or_words(unsigned long long* FT_RESTRICT a, const unsigned long long* FT_RESTRICT b)
+			{
+				size_t card = 0;
+				for (size_t w = 0; w < WORDS; ++w)
+				{
+					a[w] |= b[w];
+					card += popcount64(a[w]);
+				}
+				return (card);
+			}
+
+			static size_t and_words(unsigned long long* FT_RESTRICT a, const unsigned long long* FT_RESTRICT b)
+			{
+				size_t card = 0;
+				for (size_t w = 0; w < WORDS; ++w)
+				{
+					a[w] &= b[w];
+					card += popcount64(a[w]);
+				}
+				return (card);
+			}
+
+			// first array index whose value is not less than low
+			size_t lower(unsigned int low) const
+			{
+				size_t first = 0;
+				size_t count = this->_card;
+				while (count > 0)
+				{
+					size_t half = count / 2;
+					if (this->_values[first + half] < low)
+					{
+						first += half + 1;
+						count -= half + 1;
+					}
+					else
+						count = half;
+				}
+				return (first);
+			}
+
+			// how many runs start at or before low
+			size_t runs_upto(unsigned int low) const
+			{
+				size_t first = 0;
+				size_t count = this->_values.size() / 2;
+				while (count > 0)
+				{
+					size_t half = count / 2;
+					if (this->_values[2 * (first + half)] <= low)
+					{
+						first += half + 1;
+						count -= half + 1;
+					}
+					else
+						count = half;
+				}
+				return (first);
+			}
+
+			unsigned int run_end(size_t r) const
+			{
+				return (static_cast<unsigned int>(this->_values[2 * r]) + this->_values[2 * r + 1]);
+			}
+
+			bool add_to_run(unsigned int low)
+			{
+				size_t r = runs_upto(low);
+				if (r > 0 && low <= run_end(r - 1))
+					return (false);
+				bool after_prev = (r > 0 && run_end(r - 1) + 1 == low);
+				bool before_next = (2 * r < this->_values.size() && low + 1 == this->_values[2 * r]);
+				if (after_prev && before_next)
+				{
+					this->_values[2 * r - 1] = static_cast<unsigned short>(run_end(r) - this->_values[2 * r - 2]);
+					this->_values.erase(this->_values.begin() + 2 * r, this->_values.begin() + 2 * r + 2);
+				}
+				else if (after_prev)
+					++this->_values[2 * r - 1];
+				else if (before_next)
+				{
+					--this->_values[2 * r];
+					++this->_values[2 * r + 1];
+				}
+				else
+				{
+					unsigned short run[2] = { static_cast<unsigned short>(low), 0 };
+					this->_values.insert(this->_values.begin() + 2 * r, run, run + 2);
+				}
+				++this->_card;
+				fit();
+				return (true);
+			}
+
+			bool remove_from_run(unsigned int low)
+			{
+				size_t r = runs_upto(low);
+				if (r == 0 || low > run_end(r - 1))
+					return (false);
+				size_t at = 2 * (r - 1);
+				unsigned int start = this->_values[at];
+				unsigned int end = run_end(r - 1);
+				if (start == end)
+					this->_values.erase(this->_values.begin() + at, this->_values.begin() + at + 2);
+				else if (low == start)
+				{
+					++this->_values[at];
+					--this->_values[at + 1];
+				}
+				else if (low == end)
+					--this->_values[at + 1];
+				else
+				{
+					this->_values[at + 1] = static_cast<unsigned short>(low - 1 - start);
+					unsigned short run[2] = { static_cast<unsigned short>(low + 1), static_cast<unsigned short>(end - low - 1) };
+					this->_values.insert(this->_values.begin() + at + 2, run, run + 2);
+				}
+				--this->_card;
+				fit();
+				return (true);
+			}
+
+			// a run container that grew larger than an array or bitmap of its values
+			// becomes one
+			void fit()
+			{
+				size_t flat = (this->_card <= ARRAY_MAX ? this->_card * 2 : WORDS * 8);
+				if (this->_values.size() * 2 > flat)
+					flatten();
+			}
+
+			// runs to an array or a bitmap, whichever holds the values
+			void flatten()
+			{
+				if (this->_kind != RUN)
+					return ;
+				if (this->_card > ARRAY_MAX)
+				{
+					to_bitmap();
+					return ;
+				}
+				std::vector<unsigned short> values;
+				values.reserve(this->_card);
+				for (size_t r = 0; 2 * r < this->_values.size(); ++r)
+				{
+					for (unsigned int v = this->_values[2 * r]; v <= run_end(r); ++v)
+						values.push_back(static_cast<unsigned short>(v));
+				}
+				this->_values.swap(values);
+				this->_kind = ARRAY;
+			}
+
+			void to_bitmap()
+			{
+				std::vector<unsigned long long> bits(WORDS, 0);
+				if (this->_kind == ARRAY)
+				{
+					for (size_t i = 0; i < this->_card; ++i)
+						bits[this->_values[i] >> 6] |= 1ULL << (this->_values[i] & 63);
+				}
+				else
+				{
+					for (size_t r = 0; 2 * r < this->_values.size(); ++r)
+					{
+						for (unsigned int v = this->_values[2 * r]; v <= run_end(r); ++v)
+							bits[v >> 6] |= 1ULL << (v & 63);
+					}
+				}
+				this->_bits.swap(bits);
+				std::vector<unsigned short>().swap(this->_values);
+				this->_kind = BITMAP;
+			}
+
+			void to_array()
+			{
+				std::vector<unsigned short> values;
+				values.reserve(this->_card);
+				for (size_t w = 0; w < WORDS; ++w)
+				{
+					for (unsigned long long word = this->_bits[w]; word != 0; word &= word - 1)
+						values.push_back(static_cast<unsigned short>(w * 64 + lowest_bit(word)));
+				}
+				this->_values.swap(values);
+				std::vector<unsigned long long>().swap(this->_bits);
+				this->_kind = ARRAY;
+			}
+
+			size_t count_runs() const
+			{
+				size_t runs = 0;
+				if (this->_kind == ARRAY)
+				{
+					for (size_t i = 0; i < this->_card; ++i)
+						runs += (i == 0 || this->_values[i] != this->_values[i - 1] + 1);
+					return (runs);
+				}
+				// a run starts at each set bit whose lower neighbour is clear
+				unsigned long long carry = 0;
+				for (size_t w = 0; w < WORDS; ++w)
+				{
+					unsigned long long word = this->_bits[w];
+					runs += popcount64(word & ~((word << 1) | carry));
+					carry = word >> 63;
+				}
+				return (runs);
+			}
+
+			void to_runs()
+			{
+				std::vector<unsigned short> runs;
+				unsigned int pos = 0;
+				unsigned int low = 0;
+				bool more = seek(0, pos, low);
+				while (more)
+				{
+					unsigned int start = low;
+					unsigned int end = low;
+					while ((more = next(pos, low)) && low == end + 1)
+						end = low;
+					runs.push_back(static_cast<unsigned short>(start));
+					runs.push_back(static_cast<unsigned short>(end - start));
+				}
+				std::vector<unsigned short>(runs).swap(this->_values);
+				std::vector<unsigned long long>().swap(this->_bits);
+				this->_kind = RUN;
+			}
+	};
+}
+
+#endif
@@ -0,0 +1,102 @@
+#ifndef ROARINGITERATOR_HPP
+# define ROARINGITERATOR_HPP
+
+#include "iterator.hpp"
+#include "RoaringBitmap.hpp"
+
+namespace ft
+{
+	// iterator of roaring_set: a chunk index (chunks() is end()), the position in that
+	// chunk and the low 16 bits found there. Values are rebuilt from the chunk key, so
+	// they are returned by value.
+	class RoaringIterator : public ft::iterator<ft::bidirectional_iterator_tag, unsigned int>
+	{
+		public :
+			typedef unsigned int		value_type;
+			typedef const unsigned int*	pointer;
+			typedef unsigned int		reference;
+			typedef ft::iterator<ft::bidirectional_iterator_tag, unsigned int>::difference_type		difference_type;
+			typedef ft::iterator<ft::bidirectional_iterator_tag, unsigned int>::iterator_category	iterator_category;
+
+		protected :
+			const RoaringBitmap*	_bitmap;
+			size_t			_index;
+			unsigned int	_pos;
+			unsigned int	_low;
+
+		public:
+
+			RoaringIterator() : _bitmap(NULL), _index(0), _pos(0), _low(0) {}
+			RoaringIterator(const RoaringBitmap* bitmap, size_t index, unsigned int pos, unsigned int low)
+				: _bitmap(bitmap), _index(index), _pos(pos), _low(low) {}
+			RoaringIterator(const RoaringIterator& copy) : _bitmap(copy._bitmap), _index(copy._index), _pos(copy._pos), _low(copy._low) {}
+			RoaringIterator& operator=(const RoaringIterator& copy)
+			{
+				if (this != &copy)
+				{
+					this->_bitmap = copy._bitmap;
+					this->_index = copy._index;
+					this->_pos = copy._pos;
+					this->_low = copy._low;
+				}
+				return (*this);
+			}
+			virtual ~RoaringIterator() {}
+
+			reference operator*() const
+			{
+				return ((this->_bitmap->key(this->_index) << 16) | this->_low);
+			}
+
+			RoaringIterator& operator++()
+			{
+				if (!this->_bitmap->chunk(this->_index).next(this->_pos, this->_low))
+				{
+					if (++this->_index < this->_bitmap->chunks())
+						this->_bitmap->chunk(this->_index).first(this->_pos, this->_low);
+					else
+					{
+						this->_pos = 0;
+						this->_low = 0;
+					}
+				}
+				return (*this);
+			}
+
+			RoaringIterator operator++(int)
+			{
+				RoaringIterator tmp = *this;
+				++(*this);
+				return (tmp);
+			}
+
+			RoaringIterator& operator--()
+			{
+				if (this->_index == this->_bitmap->chunks() || !this->_bitmap->chunk(this->_index).prev(this->_pos, this->_low))
+				{
+					--this->_index;
+					this->_bitmap->chunk(this->_index).last(this->_pos, this->_low);
+				}
+				return (*this);
+			}
+
+			RoaringIterator operator--(int)
+			{
+				RoaringIterator tmp = *this;
+				--(*this);
+				return (tmp);
+			}
+
+			bool operator==(const RoaringIterator& x) const
+			{
+				return (this->_index == x._index && this->_low == x._low);
+			}
+
+			bool operator!=(const RoaringIterator& x) const
+			{
+				return (!(*this == x));
+			}
+	};
+}
+
+#endif
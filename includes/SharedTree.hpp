@@ -0,0 +1,137 @@
+#ifndef SHAREDTREE_HPP
+# define SHAREDTREE_HPP
+
+#include <cstddef>
+
+namespace ft
+{
+	// tree of a map/set with copy-on-write: once shared, the tree lives in a
+	// reference-counted body that copies point to, and the first edit() through a holder
+	// that is not alone clones it. The count is atomic so copies may be made, read and
+	// dropped on different threads; writing to one holder from two threads is a race as
+	// it is for a plain tree.
+	template <typename Tree>
+	class SharedTree {
+		private :
+			struct Body {
+				Tree	tree;
+				size_t	refs;
+
+				Body() : tree(), refs(1) {}
+			};
+
+			Tree	_own;	// the tree while not shared
+			Body*	_body;	// NULL while not shared
+
+		public :
+			SharedTree() : _own(), _body(NULL) {}
+
+			~SharedTree()
+			{
+				release();
+			}
+
+			const Tree& get() const
+			{
+				return (this->_body == NULL ? this->_own : this->_body->tree);
+			}
+
+			bool shared() const
+			{
+				return (this->_body != NULL);
+			}
+
+			// true when edit() is going to clone, i.e. another holder sees this tree
+			bool cloning() const
+			{
+				// atomic read; the count may move meanwhile, but not up from 1 unless this
+				// very holder is being copied
+				return (this->_body != NULL && __sync_fetch_and_add(&this->_body->refs, 0) > 1);
+			}
+
+			// the tree to mutate, cloned first when other holders share it: nodes move,
+			// so the caller drops its iterators and cached nodes when cloning() was true
+			Tree& edit()
+			{
+				if (this->_body == NULL)
+					return (this->_own);
+				if (cloning())
+				{
+					Body* body = new Body;
+					body->tree.copy(this->_body->tree);
+					body->tree.set_lazy_erase(this->_body->tree.lazy_erase());
+					release();
+					this->_body = body;
+				}
+				return (this->_body->tree);
+			}
+
+			// from now on copies of this tree share it
+			void share()
+			{
+				if (this->_body != NULL)
+					return ;
+				this->_body = new Body;
+				this->_body->tree.swap(this->_own);
+			}
+
+			// back to a tree of its own, cloned if other holders share it
+			void unshare()
+			{
+				if (this->_body == NULL)
+					return ;
+				this->_own.swap(edit());
+				release();
+			}
+
+			// x's tree is shared when x shares it, copied otherwise
+			void assign(const SharedTree& x)
+			{
+				if (x._body == NULL)
+				{
+					clear();
+					edit().copy(x._own);
+					return ;
+				}
+				__sync_fetch_and_add(&x._body->refs, 1);
+				release();
+				this->_own.clear();
+				this->_body = x._body;
+			}
+
+			// empties the tree; one shared with others is dropped rather than cloned
+			void clear()
+			{
+				if (!cloning())
+				{
+					edit().clear();
+					return ;
+				}
+				double max_dead = get().lazy_erase();
+				release();
+				this->_body = new Body;
+				this->_body->tree.set_lazy_erase(max_dead);
+			}
+
+			void swap(SharedTree& x)
+			{
+				this->_own.swap(x._own);
+				Body* body = this->_body;
+				this->_body = x._body;
+				x._body = body;
+			}
+
+		private :
+			SharedTree(const SharedTree&);
+			SharedTree& operator=(const SharedTree&);
+
+			void release()
+			{
+				if (this->_body != NULL && __sync_sub_and_fetch(&this->_body->refs, 1) == 0)
+					delete this->_body;
+				this->_body = NULL;
+			}
+	};
+}
+
+#endif
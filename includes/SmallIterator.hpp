@@ -0,0 +1,109 @@
+#ifndef SMALLITERATOR_HPP
+# define SMALLITERATOR_HPP
+
+#include "RBTreeIterator.hpp"
+
+namespace ft
+{
+	// iterator of small_map/small_set: walks the inline array while the container is small,
+	// the promoted RBTree afterwards (_elem is then NULL)
+	template <typename T, typename Pointer = T*, typename Reference = T&>
+	class SmallIterator : public ft::iterator<ft::bidirectional_iterator_tag, T>
+	{
+		public :
+			typedef const T		value_type;
+			typedef Pointer		pointer;
+			typedef Reference	reference;
+			typedef typename ft::iterator<ft::bidirectional_iterator_tag, T>::difference_type	difference_type;
+			typedef typename ft::iterator<ft::bidirectional_iterator_tag, T>::iterator_category	iterator_category;
+			typedef ft::RBTreeNode<T>	node_type;
+			typedef ft::RBTreeIterator<T, T*, T&>	tree_iterator;
+
+		protected :
+			T*			_elem;
+			node_type*	_node;
+
+		public:
+
+			SmallIterator() : _elem(NULL), _node(NULL) {}
+			explicit SmallIterator(T* elem) : _elem(elem), _node(NULL) {}
+			explicit SmallIterator(node_type* node) : _elem(NULL), _node(node) {}
+			SmallIterator(const SmallIterator& copy) : _elem(copy.elem()), _node(copy.node()) {}
+			// iterator to const_iterator
+			template <typename P>
+			SmallIterator(const SmallIterator<T, P, T&>& copy) : _elem(copy.elem()), _node(copy.node()) {}
+			SmallIterator& operator=(const SmallIterator& copy)
+			{
+				if (this != &copy)
+				{
+					this->_elem = copy.elem();
+					this->_node = copy.node();
+				}
+				return (*this);
+			}
+			virtual ~SmallIterator() {}
+
+			T* elem() const
+			{
+				return (this->_elem);
+			}
+
+			node_type* node() const
+			{
+				return (this->_node);
+			}
+
+			reference operator*() const
+			{
+				return (this->_node == NULL ? *this->_elem : *this->_node->value);
+			}
+			pointer operator->() const
+			{
+				return (&(operator*()));
+			}
+
+			SmallIterator& operator++()
+			{
+				if (this->_node == NULL)
+					++this->_elem;
+				else
+					this->_node = (++tree_iterator(this->_node)).base();
+				return (*this);
+			}
+
+			SmallIterator operator++(int)
+			{
+				SmallIterator tmp = *this;
+				++(*this);
+				return (tmp);
+			}
+
+			SmallIterator& operator--()
+			{
+				if (this->_node == NULL)
+					--this->_elem;
+				else
+					this->_node = (--tree_iterator(this->_node)).base();
+				return (*this);
+			}
+
+			SmallIterator operator--(int)
+			{
+				SmallIterator tmp = *this;
+				--(*this);
+				return (tmp);
+			}
+
+			bool operator==(const SmallIterator& iter) const
+			{
+				return (this->_elem == iter.elem() && this->_node == iter.node());
+			}
+
+			bool operator!=(const SmallIterator& iter) const
+			{
+				return (!(*this == iter));
+			}
+	};
+}
+
+#endif
@@ -0,0 +1,441 @@
+#ifndef BUFFERED_MAP_HPP
+# define BUFFERED_MAP_HPP
+
+#include <algorithm>
+#include <vector>
+#include "map.hpp"
+#include "BufferedIterator.hpp"
+
+namespace ft
+{
+	// map for insert-heavy ingestion: insert() only appends a ready-made node to a write
+	// buffer, and once buffer_size writes are pending they are sorted and linked into the
+	// tree in key order, each descent starting where the previous one ended. Lookups and
+	// iteration see buffer and tree as one map. A key already in the map, or earlier in
+	// the buffer, keeps its value, as with map::insert(). Const reads sort the pending
+	// writes into the buffer first, so unlike ft::map it must not be read from several
+	// threads at once while pending() is not 0: flush() before sharing it with readers.
+	template < class Key, class T, class Compare = ft::less<Key>, class Alloc = std::allocator< ft::pair<const Key, T> > >
+	class buffered_map {
+		public :
+			typedef const Key	key_type;
+			typedef T	mapped_type;
+			typedef ft::pair<key_type, mapped_type>	value_type;
+			typedef Compare	key_compare;
+			typedef typename ft::map<Key, T, Compare, Alloc>::value_compare	value_compare;
+			typedef Alloc	allocator_type;
+			typedef typename allocator_type::reference			reference;
+			typedef typename allocator_type::const_reference	const_reference;
+			typedef typename allocator_type::pointer			pointer;
+			typedef typename allocator_type::const_pointer		const_pointer;
+			typedef ft::BufferedIterator<value_type, value_compare>	iterator;
+			typedef iterator									const_iterator;
+			typedef ft::reverse_iterator<iterator>				reverse_iterator;
+			typedef ft::reverse_iterator<const_iterator>		const_reverse_iterator;
+			typedef typename allocator_type::difference_type	difference_type;
+			typedef typename allocator_type::size_type			size_type;
+			typedef ft::RBTree<value_type, value_compare, Alloc>	rb_tree;
+			typedef ft::RBTreeNode<value_type>					node_type;
+
+		private:
+			allocator_type				_alloc;
+			rb_tree						_tree;
+			// the buffer state const reads reorder; the tree itself is never written by them
+			mutable std::vector<node_type*>	_buffer;	// detached nodes, [0, _sorted) sorted, unique and not in _tree
+			mutable size_type			_sorted;
+			mutable std::vector<node_type*>	_dropped;	// duplicates taken out by a const read, freed by the next write
+			size_type					_buffer_size;
+			key_compare					_comp;
+
+		public:
+			// buffer_size pending writes trigger a flush(); larger buffers make the sorted
+			// descents closer together, 256K suits maps of a few million keys
+			explicit buffered_map (size_type buffer_size = 262144, const key_compare& comp = key_compare(),
+				const allocator_type& alloc = allocator_type()) : _alloc(alloc), _tree(), _sorted(0), _buffer_size(buffer_size), _comp(comp) {}
+
+			buffered_map (const buffered_map& x) : _alloc(x._alloc), _tree(), _sorted(0), _buffer_size(x._buffer_size), _comp(x._comp)
+			{
+				*this = x;
+			}
+
+			~buffered_map()
+			{
+				drop_buffer();
+			}
+
+			buffered_map& operator=(const buffered_map& x)
+			{
+				if (this != &x)
+				{
+					x.sync();
+					drop_buffer();
+					this->_tree.copy(x._tree);
+					for (size_type i = 0; i < x._buffer.size(); ++i)
+						this->_buffer.push_back(this->_tree.make_detached(*x._buffer[i]->value));
+					this->_sorted = this->_buffer.size();
+				}
+				return *this;
+			}
+
+			const_iterator begin() const
+			{
+				sync();
+				return (make_iterator(0, this->_tree.get_begin()));
+			}
+
+			const_iterator end() const
+			{
+				sync();
+				return (make_iterator(this->_buffer.size(), this->_tree.get_end()));
+			}
+
+			const_reverse_iterator rbegin() const
+			{
+				return const_reverse_iterator(end());
+			}
+
+			const_reverse_iterator rend() const
+			{
+				return const_reverse_iterator(begin());
+			}
+
+			bool empty() const
+			{
+				return (size() == 0);
+			}
+
+			// merges pending writes in to drop the ones already stored
+			size_type size() const
+			{
+				sync();
+				return (this->_tree.size() + this->_buffer.size());
+			}
+
+			size_type max_size() const
+			{
+				return (this->_tree.max_size());
+			}
+
+			void insert(const value_type& val)
+			{
+				free_dropped();
+				this->_buffer.push_back(this->_tree.make_detached(val));
+				if (this->_buffer.size() >= this->_buffer_size)
+					flush();
+			}
+
+			template <class InputIterator>
+			void insert(InputIterator first, InputIterator last,
+			typename ft::enable_if<!ft::is_integral<InputIterator>::value, InputIterator>::type* = NULL)
+			{
+				while (first != last)
+					insert(*first++);
+			}
+
+			size_type erase(const key_type& k)
+			{
+				sync();
+				free_dropped();
+				size_type pos = buffer_lower(k);
+				if (pos != this->_buffer.size() && !_comp(k, this->_buffer[pos]->value->first))
+				{
+					this->_tree.destroy_detached(this->_buffer[pos]);
+					this->_buffer.erase(this->_buffer.begin() + pos);
+					this->_sorted--;
+					return (1);
+				}
+				return (this->_tree.erase(this->_tree.find(k)));
+			}
+
+			void erase(iterator position)
+			{
+				erase(position->first);
+			}
+
+			void swap(buffered_map& x)
+			{
+				this->_tree.swap(x._tree);
+				this->_buffer.swap(x._buffer);
+				this->_dropped.swap(x._dropped);
+				std::swap(this->_sorted, x._sorted);
+				std::swap(this->_buffer_size, x._buffer_size);
+			}
+
+			void clear()
+			{
+				drop_buffer();
+				this->_tree.clear();
+			}
+
+			key_compare key_comp() const
+			{
+				return (key_compare());
+			}
+
+			value_compare value_comp() const
+			{
+				return (value_compare());
+			}
+
+			const_iterator find(const key_type& k) const
+			{
+				sync();
+				size_type pos = buffer_lower(k);
+				node_type* node = this->_tree.find(k);
+				if (node->value != NULL)
+					return (make_iterator(pos, node));
+				if (pos == this->_buffer.size() || _comp(k, this->_buffer[pos]->value->first))
+					return (end());
+				return (make_iterator(pos, this->_tree.lower_bound(k)));
+			}
+
+			// membership without merging the buffer while few writes are pending since the
+			// last read: the unsorted ones are scanned instead
+			size_type count(const key_type& k) const
+			{
+				if (this->_tree.find(k)->value != NULL)
+					return (1);
+				if (this->_buffer.size() - this->_sorted > 64)
+					sync();
+				size_type pos = buffer_lower(k);
+				if (pos != this->_sorted && !_comp(k, this->_buffer[pos]->value->first))
+					return (1);
+				for (size_type i = this->_sorted; i < this->_buffer.size(); ++i)
+				{
+					if (!_comp(k, this->_buffer[i]->value->first) && !_comp(this->_buffer[i]->value->first, k))
+						return (1);
+				}
+				return (0);
+			}
+
+			const_iterator lower_bound(const key_type& k) const
+			{
+				sync();
+				return (make_iterator(buffer_lower(k), this->_tree.lower_bound(k)));
+			}
+
+			const_iterator upper_bound(const key_type& k) const
+			{
+				sync();
+				return (make_iterator(buffer_upper(k), this->_tree.upper_bound(k)));
+			}
+
+			pair<const_iterator, const_iterator> equal_range(const key_type& k) const
+			{
+				return (ft::make_pair(lower_bound(k), upper_bound(k)));
+			}
+
+			allocator_type get_allocator() const
+			{
+				return (this->_alloc);
+			}
+
+			// links every pending write into the tree now
+			void flush()
+			{
+				free_dropped();
+				sort_buffer();
+				this->_tree.adopt_sorted(this->_buffer.begin(), this->_buffer.end());
+				this->_buffer.clear();
+				this->_sorted = 0;
+			}
+
+			void set_buffer_size(size_type buffer_size)
+			{
+				this->_buffer_size = buffer_size;
+				if (this->_buffer.size() >= this->_buffer_size)
+					flush();
+			}
+
+			size_type buffer_size() const
+			{
+				return (this->_buffer_size);
+			}
+
+			// writes not linked into the tree yet, duplicates included
+			size_type pending() const
+			{
+				return (this->_buffer.size());
+			}
+
+			RBTreeStats tree_stats() const
+			{
+				return (this->_tree.tree_stats());
+			}
+
+		private :
+			struct node_less {
+				value_compare	comp;
+
+				bool operator()(const node_type* a, const node_type* b) const
+				{
+					return (comp(*a->value, *b->value));
+				}
+			};
+
+			struct key_less {
+				Compare	comp;
+
+				key_less(const Compare& c) : comp(c) {}
+
+				bool operator()(const ft::pair<Key, node_type*>& a, const ft::pair<Key, node_type*>& b) const
+				{
+					return (comp(a.first, b.first));
+				}
+			};
+
+			// reads merge pending writes into the sorted part; the elements do not change
+			void sync() const
+			{
+				if (this->_sorted != this->_buffer.size())
+					normalize();
+			}
+
+			// drops unsorted writes whose key is stored or pending earlier, and merges the
+			// rest into the sorted part. Only mutable members change: the dropped nodes wait
+			// in _dropped for a write to give them back to the tree's allocator.
+			void normalize() const
+			{
+				size_type kept = this->_sorted;
+				for (size_type i = this->_sorted; i < this->_buffer.size(); ++i)
+				{
+					if (this->_tree.find(*this->_buffer[i]->value)->value != NULL)
+						this->_dropped.push_back(this->_buffer[i]);
+					else
+						this->_buffer[kept++] = this->_buffer[i];
+				}
+				this->_buffer.resize(kept);
+				sort_buffer();
+				kept = 0;
+				node_less less;
+				for (size_type i = 0; i < this->_buffer.size(); ++i)
+				{
+					if (kept != 0 && !less(this->_buffer[kept - 1], this->_buffer[i]))
+						this->_dropped.push_back(this->_buffer[i]);
+					else
+						this->_buffer[kept++] = this->_buffer[i];
+				}
+				this->_buffer.resize(kept);
+				this->_sorted = kept;
+			}
+
+			// stable, so the first of equal keys stays first. The unsorted keys are copied
+			// next to their node first: the sort then reads one array instead of chasing
+			// each comparison into two scattered nodes.
+			void sort_buffer() const
+			{
+				std::vector< ft::pair<Key, node_type*> > keyed;
+				keyed.reserve(this->_buffer.size() - this->_sorted);
+				for (size_type i = this->_sorted; i < this->_buffer.size(); ++i)
+					keyed.push_back(ft::pair<Key, node_type*>(this->_buffer[i]->value->first, this->_buffer[i]));
+				std::stable_sort(keyed.begin(), keyed.end(), key_less(this->_comp));
+				for (size_type i = 0; i < keyed.size(); ++i)
+					this->_buffer[this->_sorted + i] = keyed[i].second;
+				std::inplace_merge(this->_buffer.begin(), this->_buffer.begin() + this->_sorted, this->_buffer.end(), node_less());
+			}
+
+			void drop_buffer()
+			{
+				free_dropped();
+				for (size_type i = 0; i < this->_buffer.size(); ++i)
+					this->_tree.destroy_detached(this->_buffer[i]);
+				this->_buffer.clear();
+				this->_sorted = 0;
+			}
+
+			void free_dropped()
+			{
+				for (size_type i = 0; i < this->_dropped.size(); ++i)
+					this->_tree.destroy_detached(this->_dropped[i]);
+				this->_dropped.clear();
+			}
+
+			const_iterator make_iterator(size_type pos, node_type* node) const
+			{
+				node_type* const* buf = (this->_buffer.empty() ? NULL : &this->_buffer[0]);
+				return (const_iterator(buf, pos, this->_buffer.size(), node));
+			}
+
+			// binary searches over the sorted part of the buffer
+			size_type buffer_lower(const key_type& k) const
+			{
+				size_type first = 0;
+				size_type len = this->_sorted;
+				while (len > 0)
+				{
+					size_type half = len / 2;
+					if (_comp(this->_buffer[first + half]->value->first, k))
+					{
+						first += half + 1;
+						len -= half + 1;
+					}
+					else
+						len = half;
+				}
+				return (first);
+			}
+
+			size_type buffer_upper(const key_type& k) const
+			{
+				size_type first = 0;
+				size_type len = this->_sorted;
+				while (len > 0)
+				{
+					size_type half = len / 2;
+					if (!_comp(k, this->_buffer[first + half]->value->first))
+					{
+						first += half + 1;
+						len -= half + 1;
+					}
+					else
+						len = half;
+				}
+				return (first);
+			}
+	};
+
+
+	template <class Key, class T, class Compare, class Alloc>
+	bool operator==(const buffered_map<Key, T, Compare, Alloc>& lhs, const buffered_map<Key, T, Compare, Alloc>& rhs)
+	{
+		return (lhs.size() == rhs.size() && ft::equal(lhs.begin(), lhs.end(), rhs.begin()));
+	}
+
+	template <class Key, class T, class Compare, class Alloc>
+	bool operator!=(const buffered_map<Key, T, Compare, Alloc>& lhs, const buffered_map<Key, T, Compare, Alloc>& rhs)
+	{
+		return (!(lhs == rhs));
+	}
+
+	template <class Key, class T, class Compare, class Alloc>
+	bool operator<(const buffered_map<Key, T, Compare, Alloc>& lhs, const buffered_map<Key, T, Compare, Alloc>& rhs)
+	{
+		return (ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()));
+	}
+
+	template <class Key, class T, class Compare, class Alloc>
+	bool operator<=(const buffered_map<Key, T, Compare, Alloc>& lhs, const buffered_map<Key, T, Compare, Alloc>& rhs)
+	{
+		return (!(rhs < lhs));
+	}
+
+	template <class Key, class T, class Compare, class Alloc>
+	bool operator>(const buffered_map<Key, T, Compare, Alloc>& lhs, const buffered_map<Key, T, Compare, Alloc>& rhs)
+	{
+		return (rhs < lhs);
+	}
+
+	template <class Key, class T, class Compare, class Alloc>
+	bool operator>=(const buffered_map<Key, T, Compare, Alloc>& lhs, const buffered_map<Key, T, Compare, Alloc>& rhs)
+	{
+		return (!(lhs < rhs));
+	}
+
+	template <class Key, class T, class Compare, class Alloc>
+	void swap(buffered_map<Key, T, Compare, Alloc>& x, buffered_map<Key, T, Compare, Alloc>& y)
+	{
+		x.swap(y);
+	}
+}
+
+#endif
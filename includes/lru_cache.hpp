@@ -0,0 +1,477 @@
+#ifndef LRU_CACHE_HPP
+# define LRU_CACHE_HPP
+
+#include <memory>
+#include <new>
+#include <algorithm>
+#include "utils.hpp"
+#include "LruNode.hpp"
+#include "LruIterator.hpp"
+
+namespace ft
+{
+	// default lru_cache weigher: every entry weighs 1, so the capacity is an entry count
+	struct unit_weight {
+		template <class Key, class T>
+		size_t operator()(const Key&, const T&) const
+		{
+			return (1);
+		}
+	};
+
+	// cache of at most capacity() weight of entries that drops the least recently used
+	// ones to make room: get, put and erase are O(1), through a chained hash table (keys
+	// are compared with ==) and a recency list threaded through the same nodes, so each
+	// entry is a single allocation, and the node of an evicted entry is reused by the put
+	// that evicted it. The weigher gives each entry's weight (a byte size, say), 1 by
+	// default. Only get() and put() make an entry most recent and only get() counts hits
+	// and misses; iteration goes from the most to the least recent entry. Keys hash with
+	// ft::checked_hash unless another Hash is given: keys other than integers, pointers
+	// and strings do not compile without one.
+	template < class Key, class T, class Hash = ft::checked_hash<Key>, class Weigher = ft::unit_weight,
+		class Alloc = std::allocator< ft::pair<const Key, T> > >
+	class lru_cache {
+		public :
+			typedef Key		key_type;
+			typedef T		mapped_type;
+			typedef ft::pair<const key_type, mapped_type>	value_type;
+			typedef Hash	hasher;
+			typedef Weigher	weigher;
+			typedef Alloc	allocator_type;
+			typedef typename allocator_type::reference			reference;
+			typedef typename allocator_type::const_reference	const_reference;
+			typedef typename allocator_type::pointer			pointer;
+			typedef typename allocator_type::const_pointer		const_pointer;
+			typedef typename ft::LruIterator<value_type, value_type*, value_type&>	iterator;
+			typedef typename ft::LruIterator<value_type, const value_type*, const value_type&>	const_iterator;
+			typedef ft::reverse_iterator<iterator>				reverse_iterator;
+			typedef ft::reverse_iterator<const_iterator>		const_reverse_iterator;
+			typedef typename allocator_type::difference_type	difference_type;
+			typedef typename allocator_type::size_type			size_type;
+
+		private:
+			typedef ft::LruNode<value_type>	node_type;
+			typedef typename Alloc::template rebind<node_type>::other	node_allocator_type;
+
+			LruLink			_head;
+			node_type**		_buckets;
+			size_type		_bucket_count;
+			size_type		_shift;
+			size_type		_size;
+			size_type		_weight;
+			size_type		_capacity;
+			size_type		_hits;
+			size_type		_misses;
+			size_type		_evictions;
+			hasher			_hash;
+			weigher			_weigher;
+			node_allocator_type	_node_alloc;
+
+		public:
+			explicit lru_cache(size_type capacity, const hasher& hf = hasher(), const weigher& w = weigher(),
+					const allocator_type& alloc = allocator_type())
+				: _head(), _buckets(NULL), _bucket_count(0), _shift(0), _size(0), _weight(0), _capacity(capacity),
+				_hits(0), _misses(0), _evictions(0), _hash(hf), _weigher(w), _node_alloc(alloc) {}
+
+			// same entries in the same recency order, and the same counters
+			lru_cache(const lru_cache& x)
+				: _head(), _buckets(NULL), _bucket_count(0), _shift(0), _size(0), _weight(0), _capacity(x._capacity),
+				_hits(x._hits), _misses(x._misses), _evictions(x._evictions), _hash(x._hash), _weigher(x._weigher), _node_alloc(x._node_alloc)
+			{
+				copy_entries(x);
+			}
+
+			~lru_cache()
+			{
+				clear();
+				delete[] this->_buckets;
+			}
+
+			lru_cache& operator=(const lru_cache& x)
+			{
+				if (this != &x)
+				{
+					clear();
+					this->_capacity = x._capacity;
+					this->_hits = x._hits;
+					this->_misses = x._misses;
+					this->_evictions = x._evictions;
+					this->_hash = x._hash;
+					this->_weigher = x._weigher;
+					copy_entries(x);
+				}
+				return (*this);
+			}
+
+			iterator begin()
+			{
+				return (iterator(this->_head.next));
+			}
+
+			const_iterator begin() const
+			{
+				return (const_iterator(const_cast<LruLink*>(this->_head.next)));
+			}
+
+			iterator end()
+			{
+				return (iterator(&this->_head));
+			}
+
+			const_iterator end() const
+			{
+				return (const_iterator(const_cast<LruLink*>(&this->_head)));
+			}
+
+			reverse_iterator rbegin()
+			{
+				return (reverse_iterator(end()));
+			}
+
+			const_reverse_iterator rbegin() const
+			{
+				return (const_reverse_iterator(end()));
+			}
+
+			reverse_iterator rend()
+			{
+				return (reverse_iterator(begin()));
+			}
+
+			const_reverse_iterator rend() const
+			{
+				return (const_reverse_iterator(begin()));
+			}
+
+			bool empty() const
+			{
+				return (this->_size == 0);
+			}
+
+			size_type size() const
+			{
+				return (this->_size);
+			}
+
+			size_type max_size() const
+			{
+				return (this->_node_alloc.max_size());
+			}
+
+			size_type capacity() const
+			{
+				return (this->_capacity);
+			}
+
+			// total weight of the entries held, never above capacity()
+			size_type weight() const
+			{
+				return (this->_weight);
+			}
+
+			// the value for k, which becomes the most recent entry, or NULL (a miss); the
+			// pointer is good until that entry is erased or evicted
+			mapped_type* get(const key_type& k)
+			{
+				node_type* node = lookup(k, this->_hash(k));
+				if (node == NULL)
+				{
+					++this->_misses;
+					return (NULL);
+				}
+				++this->_hits;
+				touch(node);
+				return (&node->value.second);
+			}
+
+			// the value for k, or NULL, without making it recent or counting the lookup
+			const mapped_type* peek(const key_type& k) const
+			{
+				node_type* node = lookup(k, this->_hash(k));
+				return (node == NULL ? NULL : &node->value.second);
+			}
+
+			iterator find(const key_type& k)
+			{
+				node_type* node = lookup(k, this->_hash(k));
+				return (node == NULL ? end() : iterator(node));
+			}
+
+			const_iterator find(const key_type& k) const
+			{
+				node_type* node = lookup(k, this->_hash(k));
+				return (node == NULL ? end() : const_iterator(node));
+			}
+
+			size_type count(const key_type& k) const
+			{
+				return (lookup(k, this->_hash(k)) == NULL ? 0 : 1);
+			}
+
+			// stores v for k as the most recent entry, evicting least recent ones until its
+			// weight fits; true if k was not cached before. An entry weighing more than the
+			// whole capacity is not stored, and an older value for k is dropped.
+			bool put(const key_type& k, const mapped_type& v)
+			{
+				size_t h = this->_hash(k);
+				size_type w = this->_weigher(k, v);
+				node_type* node = lookup(k, h);
+				if (node != NULL)
+				{
+					if (w > this->_capacity)
+					{
+						release(detach(node));
+						return (false);
+					}
+					node->value.second = v;
+					this->_weight = this->_weight - node->weight + w;
+					node->weight = w;
+					touch(node);
+					release(make_room(0));
+					return (false);
+				}
+				if (w > this->_capacity)
+					return (false);
+				node_type* spare = make_room(w);
+				if (spare == NULL)
+					spare = this->_node_alloc.allocate(1);
+				try
+				{
+					::new (static_cast<void*>(spare)) node_type(k, v, h, w);
+				}
+				catch (...)
+				{
+					this->_node_alloc.deallocate(spare, 1);
+					throw ;
+				}
+				attach(spare);
+				return (true);
+			}
+
+			size_type erase(const key_type& k)
+			{
+				node_type* node = lookup(k, this->_hash(k));
+				if (node == NULL)
+					return (0);
+				release(detach(node));
+				return (1);
+			}
+
+			void erase(iterator position)
+			{
+				release(detach(static_cast<node_type*>(position.base())));
+			}
+
+			void clear()
+			{
+				LruLink* link = this->_head.next;
+				while (link != &this->_head)
+				{
+					node_type* node = static_cast<node_type*>(link);
+					link = link->next;
+					this->_node_alloc.destroy(node);
+					this->_node_alloc.deallocate(node, 1);
+				}
+				this->_head.prev = &this->_head;
+				this->_head.next = &this->_head;
+				for (size_type i = 0; i < this->_bucket_count; ++i)
+					this->_buckets[i] = NULL;
+				this->_size = 0;
+				this->_weight = 0;
+			}
+
+			// a smaller capacity evicts least recent entries until the rest fits
+			void set_capacity(size_type capacity)
+			{
+				this->_capacity = capacity;
+				release(make_room(0));
+			}
+
+			size_type hits() const
+			{
+				return (this->_hits);
+			}
+
+			size_type misses() const
+			{
+				return (this->_misses);
+			}
+
+			// entries dropped to make room, erase() and clear() do not count
+			size_type evictions() const
+			{
+				return (this->_evictions);
+			}
+
+			void reset_stats()
+			{
+				this->_hits = 0;
+				this->_misses = 0;
+				this->_evictions = 0;
+			}
+
+			void swap(lru_cache& x)
+			{
+				std::swap(this->_buckets, x._buckets);
+				std::swap(this->_bucket_count, x._bucket_count);
+				std::swap(this->_shift, x._shift);
+				std::swap(this->_size, x._size);
+				std::swap(this->_weight, x._weight);
+				std::swap(this->_capacity, x._capacity);
+				std::swap(this->_hits, x._hits);
+				std::swap(this->_misses, x._misses);
+				std::swap(this->_evictions, x._evictions);
+				std::swap(this->_hash, x._hash);
+				std::swap(this->_weigher, x._weigher);
+				std::swap(this->_node_alloc, x._node_alloc);
+				std::swap(this->_head, x._head);
+				this->adopt_list();
+				x.adopt_list();
+			}
+
+			hasher hash_function() const
+			{
+				return (this->_hash);
+			}
+
+			allocator_type get_allocator() const
+			{
+				return (allocator_type(this->_node_alloc));
+			}
+
+		private:
+			// Fibonacci hashing, as in FindCache: identity hashes of sequential keys spread
+			size_type index(size_t hash) const
+			{
+				const size_t golden = static_cast<size_t>(0x9e3779b97f4a7c15ULL);
+				return ((hash * golden) >> this->_shift);
+			}
+
+			node_type* lookup(const key_type& k, size_t hash) const
+			{
+				if (this->_size == 0)
+					return (NULL);
+				node_type* node = this->_buckets[index(hash)];
+				while (node != NULL && (node->hash != hash || !(node->value.first == k)))
+					node = node->chain;
+				return (node);
+			}
+
+			void touch(node_type* node)
+			{
+				if (this->_head.next == node)
+					return ;
+				node->unlink();
+				node->link_after(&this->_head);
+			}
+
+			// links a constructed node in as the most recent entry, growing the table so
+			// that chains stay about one node long
+			void attach(node_type* node)
+			{
+				if (this->_size >= this->_bucket_count)
+					rehash(this->_bucket_count == 0 ? 8 : this->_bucket_count * 2);
+				node_type** bucket = this->_buckets + index(node->hash);
+				node->chain = *bucket;
+				*bucket = node;
+				node->link_after(&this->_head);
+				++this->_size;
+				this->_weight += node->weight;
+			}
+
+			// unlinks and destroys an entry, giving back its memory
+			node_type* detach(node_type* node)
+			{
+				node_type** at = this->_buckets + index(node->hash);
+				while (*at != node)
+					at = &(*at)->chain;
+				*at = node->chain;
+				node->unlink();
+				--this->_size;
+				this->_weight -= node->weight;
+				this->_node_alloc.destroy(node);
+				return (node);
+			}
+
+			void release(node_type* node)
+			{
+				if (node != NULL)
+					this->_node_alloc.deallocate(node, 1);
+			}
+
+			// evicts least recent entries until extra more weight fits; the memory of the
+			// last one evicted is handed back to be reused rather than freed
+			node_type* make_room(size_type extra)
+			{
+				node_type* spare = NULL;
+				while (this->_size > 0 && this->_weight + extra > this->_capacity)
+				{
+					release(spare);
+					spare = detach(static_cast<node_type*>(this->_head.prev));
+					++this->_evictions;
+				}
+				return (spare);
+			}
+
+			void rehash(size_type count)
+			{
+				size_type bits = 0;
+				while ((static_cast<size_type>(1) << bits) < count)
+					++bits;
+				delete[] this->_buckets;
+				this->_bucket_count = static_cast<size_type>(1) << bits;
+				this->_shift = sizeof(size_t) * 8 - bits;
+				this->_buckets = new node_type*[this->_bucket_count];
+				for (size_type i = 0; i < this->_bucket_count; ++i)
+					this->_buckets[i] = NULL;
+				for (LruLink* link = this->_head.next; link != &this->_head; link = link->next)
+				{
+					node_type* node = static_cast<node_type*>(link);
+					node_type** bucket = this->_buckets + index(node->hash);
+					node->chain = *bucket;
+					*bucket = node;
+				}
+			}
+
+			// after _head was copied or swapped in: its neighbours point back at it
+			void adopt_list()
+			{
+				if (this->_size == 0)
+				{
+					this->_head.prev = &this->_head;
+					this->_head.next = &this->_head;
+					return ;
+				}
+				this->_head.next->prev = &this->_head;
+				this->_head.prev->next = &this->_head;
+			}
+
+			// x's entries from the least to the most recent, so they end up in its order
+			void copy_entries(const lru_cache& x)
+			{
+				for (const LruLink* link = x._head.prev; link != &x._head; link = link->prev)
+				{
+					const node_type* src = static_cast<const node_type*>(link);
+					node_type* node = this->_node_alloc.allocate(1);
+					try
+					{
+						::new (static_cast<void*>(node)) node_type(src->value, src->hash, src->weight);
+					}
+					catch (...)
+					{
+						this->_node_alloc.deallocate(node, 1);
+						throw ;
+					}
+					attach(node);
+				}
+			}
+	};
+
+	template <class Key, class T, class Hash, class Weigher, class Alloc>
+	void swap(lru_cache<Key, T, Hash, Weigher, Alloc>& x, lru_cache<Key, T, Hash, Weigher, Alloc>& y)
+	{
+		x.swap(y);
+	}
+}
+
+#endif
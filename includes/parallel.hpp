@@ -0,0 +1,297 @@
+#ifndef PARALLEL_HPP
+# define PARALLEL_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+#include <pthread.h>
+#include <unistd.h>
+
+namespace ft
+{
+	// worker threads used when a parallel call is given 0 threads
+	inline unsigned int hardware_threads()
+	{
+		long n = ::sysconf(_SC_NPROCESSORS_ONLN);
+		return (n > 0 ? static_cast<unsigned int>(n) : 1);
+	}
+
+	// runs job.run(i) for every i in [0, count) on up to threads pthreads; workers take
+	// the next index from a shared counter, so uneven tasks still balance. The calling
+	// thread is one of the workers. job.run must not throw.
+	template <typename Job>
+	class ParallelRunner {
+		private :
+			Job&			_job;
+			size_t			_count;
+			volatile size_t	_next;
+
+			static void* worker(void* arg)
+			{
+				static_cast<ParallelRunner*>(arg)->drain();
+				return (NULL);
+			}
+
+			void drain()
+			{
+				for (size_t i = __sync_fetch_and_add(&this->_next, 1); i < this->_count; i = __sync_fetch_and_add(&this->_next, 1))
+					this->_job.run(i);
+			}
+
+		public :
+			ParallelRunner(Job& job, size_t count) : _job(job), _count(count), _next(0) {}
+
+			void run(unsigned int threads)
+			{
+				if (threads == 0)
+					threads = hardware_threads();
+				if (threads > this->_count)
+					threads = static_cast<unsigned int>(this->_count);
+				std::vector<pthread_t> ids;
+				for (unsigned int i = 1; i < threads; ++i)
+				{
+					pthread_t id;
+					if (pthread_create(&id, NULL, &ParallelRunner::worker, this) != 0)
+						break ;
+					ids.push_back(id);
+				}
+				drain();
+				for (size_t i = 0; i < ids.size(); ++i)
+					pthread_join(ids[i], NULL);
+			}
+	};
+
+	// a piece of an in-order walk: one node, or a whole subtree
+	template <typename Node>
+	struct TreeTask {
+		Node*	node;
+		bool	subtree;
+
+		TreeTask(Node* n, bool s) : node(n), subtree(s) {}
+	};
+
+	// cuts the tree depth levels down into subtrees, keeping the cut nodes as single-node
+	// tasks between them so the list stays in key order
+	template <typename Node>
+	void split_tree(Node* node, size_t depth, std::vector< TreeTask<Node> >& out)
+	{
+		if (node->value == NULL)
+			return ;
+		if (depth == 0)
+		{
+			out.push_back(TreeTask<Node>(node, true));
+			return ;
+		}
+		split_tree(node->leftChild, depth - 1, out);
+		out.push_back(TreeTask<Node>(node, false));
+		split_tree(node->rightChild, depth - 1, out);
+	}
+
+	// one subtree per 2K nodes up to 64 of them, plenty to balance any thread count; it
+	// does not depend on the thread count, so a given tree splits the same way on every
+	// machine, but where the cuts land follows the tree's shape
+	inline size_t split_depth(size_t size)
+	{
+		size_t depth = 0;
+		while (depth < 6 && (static_cast<size_t>(1) << (depth + 11)) <= size)
+			++depth;
+		return (depth);
+	}
+
+	// in-order walk of the live values, tombstones of a lazy erase are skipped
+	template <typename Node, typename Function>
+	void visit_subtree(Node* node, Function& f)
+	{
+		while (node->value != NULL)
+		{
+			visit_subtree(node->leftChild, f);
+			if (!node->dead)
+				f(*node->value);
+			node = node->rightChild;
+		}
+	}
+
+	// hands values to f as const, for const containers and set
+	template <typename Function, typename T>
+	struct ConstVisitor {
+		Function&	f;
+
+		ConstVisitor(Function& fn) : f(fn) {}
+
+		void operator()(const T& val)
+		{
+			f(val);
+		}
+	};
+
+	template <typename Node, typename Function>
+	struct ForEachJob {
+		const std::vector< TreeTask<Node> >&	tasks;
+		Function&								f;
+
+		ForEachJob(const std::vector< TreeTask<Node> >& t, Function& fn) : tasks(t), f(fn) {}
+
+		void run(size_t i)
+		{
+			if (tasks[i].subtree)
+				visit_subtree(tasks[i].node, f);
+			else if (!tasks[i].node->dead)
+				f(*tasks[i].node->value);
+		}
+	};
+
+	// partial result of one task; the padding keeps workers off each other's cache line
+	// and keeps std::vector<bool> out of the way
+	template <typename T>
+	struct ReducePartial {
+		T		value;
+		char	pad[64];
+
+		ReducePartial(const T& init) : value(init) {}
+	};
+
+	// folds one task into its own partial, starting from init
+	template <typename Node, typename T, typename Reduce, typename Transform>
+	struct ReduceJob {
+		const std::vector< TreeTask<Node> >&		tasks;
+		std::vector< ReducePartial<T> >&			partials;
+		const Reduce&								reduce;
+		const Transform&							transform;
+
+		ReduceJob(const std::vector< TreeTask<Node> >& t, std::vector< ReducePartial<T> >& p, const Reduce& r, const Transform& tr)
+			: tasks(t), partials(p), reduce(r), transform(tr) {}
+
+		struct Folder {
+			ReduceJob&	job;
+			T&			acc;
+
+			Folder(ReduceJob& j, T& a) : job(j), acc(a) {}
+
+			void operator()(const typename Node::value_type& val)
+			{
+				acc = job.reduce(acc, job.transform(val));
+			}
+		};
+
+		void run(size_t i)
+		{
+			Folder folder(*this, partials[i].value);
+			if (tasks[i].subtree)
+				visit_subtree(tasks[i].node, folder);
+			else if (!tasks[i].node->dead)
+				folder(*tasks[i].node->value);
+		}
+	};
+
+	// f(value) for every node, concurrently: f is shared by the workers and must be safe
+	// to call from several threads on different values
+	template <typename Node, typename Function>
+	void parallel_for_each_node(Node* root, size_t size, Function& f, unsigned int threads)
+	{
+		std::vector< TreeTask<Node> > tasks;
+		split_tree(root, split_depth(size), tasks);
+		ForEachJob<Node, Function> job(tasks, f);
+		ParallelRunner< ForEachJob<Node, Function> >(job, tasks.size()).run(threads);
+	}
+
+	// reduce(... reduce(reduce(init, transform(v1)), transform(v2)) ...) with every task
+	// folded separately from init, then the partials folded from init in key order, so
+	// init must be an identity of reduce and reduce must be associative; the grouping
+	// follows the shape of the tree, never threads, so equal contents built in another
+	// order may group differently
+	template <typename Node, typename T, typename Reduce, typename Transform>
+	T parallel_reduce_nodes(Node* root, size_t size, T init, const Reduce& reduce, const Transform& transform, unsigned int threads)
+	{
+		std::vector< TreeTask<Node> > tasks;
+		split_tree(root, split_depth(size), tasks);
+		std::vector< ReducePartial<T> > partials(tasks.size(), ReducePartial<T>(init));
+		ReduceJob<Node, T, Reduce, Transform> job(tasks, partials, reduce, transform);
+		ParallelRunner< ReduceJob<Node, T, Reduce, Transform> >(job, tasks.size()).run(threads);
+		T res = init;
+		for (size_t i = 0; i < partials.size(); ++i)
+			res = reduce(res, partials[i].value);
+		return (res);
+	}
+
+	template <typename T, typename Less>
+	struct SortJob {
+		std::vector<T>&				v;
+		const std::vector<size_t>&	bounds;
+		const Less&					less;
+
+		SortJob(std::vector<T>& values, const std::vector<size_t>& b, const Less& l) : v(values), bounds(b), less(l) {}
+
+		void run(size_t i)
+		{
+			std::stable_sort(v.begin() + bounds[i], v.begin() + bounds[i + 1], less);
+		}
+	};
+
+	// merges runs i and i + width of from into to, for every i multiple of 2 * width
+	template <typename T, typename Less>
+	struct MergeJob {
+		const std::vector<T>&		from;
+		std::vector<T>&				to;
+		const std::vector<size_t>&	bounds;
+		size_t						width;
+		const Less&					less;
+
+		MergeJob(const std::vector<T>& f, std::vector<T>& t, const std::vector<size_t>& b, size_t w, const Less& l)
+			: from(f), to(t), bounds(b), width(w), less(l) {}
+
+		void run(size_t i)
+		{
+			size_t runs = bounds.size() - 1;
+			size_t lo = i * 2 * width;
+			size_t mid = std::min(lo + width, runs);
+			size_t hi = std::min(lo + 2 * width, runs);
+			std::merge(from.begin() + bounds[lo], from.begin() + bounds[mid], from.begin() + bounds[mid], from.begin() + bounds[hi],
+				to.begin() + bounds[lo], less);
+		}
+	};
+
+	// stable sort: one std::stable_sort per thread, then rounds of pairwise std::merge,
+	// which takes from the left run on ties, so equal elements keep their input order
+	template <typename T, typename Less>
+	void parallel_stable_sort(std::vector<T>& v, const Less& less, unsigned int threads)
+	{
+		if (threads == 0)
+			threads = hardware_threads();
+		size_t runs = std::min(static_cast<size_t>(threads), v.size() / 4096 + 1);
+		if (runs <= 1)
+		{
+			std::stable_sort(v.begin(), v.end(), less);
+			return ;
+		}
+		std::vector<size_t> bounds;
+		for (size_t i = 0; i <= runs; ++i)
+			bounds.push_back(v.size() * i / runs);
+		SortJob<T, Less> sort_job(v, bounds, less);
+		ParallelRunner< SortJob<T, Less> >(sort_job, runs).run(threads);
+
+		std::vector<T> tmp(v);
+		for (size_t width = 1; width < runs; width *= 2)
+		{
+			MergeJob<T, Less> merge_job(v, tmp, bounds, width, less);
+			ParallelRunner< MergeJob<T, Less> >(merge_job, (runs + 2 * width - 1) / (2 * width)).run(threads);
+			v.swap(tmp);
+		}
+	}
+
+	// drops every element equivalent to the one before it, keeping the first of each run
+	template <typename T, typename Less>
+	void unique_sorted(std::vector<T>& v, const Less& less)
+	{
+		if (v.empty())
+			return ;
+		size_t out = 0;
+		for (size_t i = 1; i < v.size(); ++i)
+		{
+			if (less(v[out], v[i]))
+				v[++out] = v[i];
+		}
+		v.erase(v.begin() + out + 1, v.end());
+	}
+}
+
+#endif
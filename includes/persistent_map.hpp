@@ -0,0 +1,228 @@
+#ifndef PERSISTENT_MAP_HPP
+# define PERSISTENT_MAP_HPP
+
+#include "map.hpp"
+#include "PersistentTree.hpp"
+#include "PersistentIterator.hpp"
+
+namespace ft
+{
+	// map whose tree lives in a file: reopening the file gives the same map back with no
+	// rebuild. Key and T must be plain data (no pointers, no owned memory) and Compare
+	// must order the same way in every process that opens the file. Writes reach the page
+	// cache right away and the disk on checkpoint(), on close or when the kernel flushes
+	// them. A crash in the middle of an insert or erase can leave the tree inconsistent:
+	// the file then stays marked dirty, and the next open verifies it and throws if so.
+	// Iterators stay valid across growth, references to values do not.
+	template < class Key, class T, class Compare = ft::less<Key> >
+	class persistent_map {
+		public :
+			typedef const Key	key_type;
+			typedef T	mapped_type;
+			typedef ft::pair<key_type, mapped_type>	value_type;
+			typedef Compare	key_compare;
+			typedef typename ft::map<Key, T, Compare>::value_compare	value_compare;
+			typedef value_type&			reference;
+			typedef const value_type&	const_reference;
+			typedef value_type*			pointer;
+			typedef const value_type*	const_pointer;
+			typedef ft::PersistentTree<value_type, value_compare>	tree_type;
+			typedef ft::PersistentIterator<tree_type, value_type, value_type*, value_type&>	iterator;
+			typedef ft::PersistentIterator<tree_type, value_type, const value_type*, const value_type&>	const_iterator;
+			typedef ft::reverse_iterator<iterator>				reverse_iterator;
+			typedef ft::reverse_iterator<const_iterator>		const_reverse_iterator;
+			typedef ptrdiff_t	difference_type;
+			typedef size_t		size_type;
+
+		private:
+			tree_type	_tree;
+
+			persistent_map(const persistent_map&);
+			persistent_map& operator=(const persistent_map&);
+
+		public:
+			// opens path, or creates it with room for capacity elements; throws
+			// std::runtime_error when the file cannot be mapped, holds another map type or
+			// was left inconsistent
+			explicit persistent_map(const std::string& path, size_type capacity = 1024) : _tree(path, capacity) {}
+
+			~persistent_map() {}
+
+			iterator begin()
+			{
+				return (iterator(&this->_tree, this->_tree.begin()));
+			}
+			const_iterator begin() const
+			{
+				return (const_iterator(&this->_tree, this->_tree.begin()));
+			}
+
+			iterator end()
+			{
+				return (iterator(&this->_tree, 0));
+			}
+			const_iterator end() const
+			{
+				return (const_iterator(&this->_tree, 0));
+			}
+
+			reverse_iterator rbegin()
+			{
+				return (reverse_iterator(end()));
+			}
+			const_reverse_iterator rbegin() const
+			{
+				return (const_reverse_iterator(end()));
+			}
+
+			reverse_iterator rend()
+			{
+				return (reverse_iterator(begin()));
+			}
+			const_reverse_iterator rend() const
+			{
+				return (const_reverse_iterator(begin()));
+			}
+
+			bool empty() const
+			{
+				return (this->_tree.size() == 0);
+			}
+			size_type size() const
+			{
+				return (this->_tree.size());
+			}
+			size_type capacity() const
+			{
+				return (this->_tree.capacity());
+			}
+
+			// grows the file up front, saving the doubling remaps of a large load
+			void reserve(size_type n)
+			{
+				this->_tree.reserve(n);
+			}
+
+			mapped_type& operator[](const key_type& k)
+			{
+				// one descent: insert hands back the slot of a key already there
+				return (this->_tree.value(this->_tree.insert(value_type(k, mapped_type())).first).second);
+			}
+
+			pair<iterator, bool> insert(const value_type& val)
+			{
+				ft::pair<size_t, bool> res = this->_tree.insert(val);
+				return (ft::make_pair(iterator(&this->_tree, res.first), res.second));
+			}
+
+			iterator insert(iterator, const value_type& val)
+			{
+				return (insert(val).first);
+			}
+
+			template <class InputIterator>
+			void insert(InputIterator first, InputIterator last,
+			typename ft::enable_if<!ft::is_integral<InputIterator>::value, InputIterator>::type* = NULL)
+			{
+				while (first != last)
+					this->_tree.insert(*first++);
+			}
+
+			void erase(iterator position)
+			{
+				this->_tree.erase(position.base());
+			}
+
+			size_type erase(const key_type& k)
+			{
+				size_t pos = this->_tree.find(k);
+				if (pos == 0)
+					return (0);
+				this->_tree.erase(pos);
+				return (1);
+			}
+
+			void erase(iterator first, iterator last)
+			{
+				while (first != last)
+					erase(first++);
+			}
+
+			void clear()
+			{
+				this->_tree.clear();
+			}
+
+			key_compare key_comp() const
+			{
+				return (key_compare());
+			}
+
+			value_compare value_comp() const
+			{
+				return (value_compare());
+			}
+
+			iterator find(const key_type& k)
+			{
+				return (iterator(&this->_tree, this->_tree.find(k)));
+			}
+
+			const_iterator find(const key_type& k) const
+			{
+				return (const_iterator(&this->_tree, this->_tree.find(k)));
+			}
+
+			size_type count(const key_type& k) const
+			{
+				return (this->_tree.find(k) != 0 ? 1 : 0);
+			}
+
+			iterator lower_bound(const key_type& k)
+			{
+				return (iterator(&this->_tree, this->_tree.lower_bound(k)));
+			}
+
+			const_iterator lower_bound(const key_type& k) const
+			{
+				return (const_iterator(&this->_tree, this->_tree.lower_bound(k)));
+			}
+
+			iterator upper_bound(const key_type& k)
+			{
+				return (iterator(&this->_tree, this->_tree.upper_bound(k)));
+			}
+
+			const_iterator upper_bound(const key_type& k) const
+			{
+				return (const_iterator(&this->_tree, this->_tree.upper_bound(k)));
+			}
+
+			pair<iterator, iterator> equal_range(const key_type& k)
+			{
+				return (ft::make_pair(lower_bound(k), upper_bound(k)));
+			}
+			pair<const_iterator, const_iterator> equal_range(const key_type& k) const
+			{
+				return (ft::make_pair(lower_bound(k), upper_bound(k)));
+			}
+
+			// blocks until every change so far is on disk (msync + fsync)
+			void checkpoint()
+			{
+				this->_tree.checkpoint();
+			}
+
+			const std::string& path() const
+			{
+				return (this->_tree.path());
+			}
+
+			bool verify() const
+			{
+				return (this->_tree.verify());
+			}
+	};
+}
+
+#endif
@@ -9,6 +9,17 @@
 #define C_RESET "\e[0m"
 
 namespace ft {
+// set keys are printed as is, map keys through their pair
+template < typename T >
+void printKey(std::ostream& os, const T& value) {
+  os << value;
+}
+
+template < typename T1, typename T2 >
+void printKey(std::ostream& os, const ft::pair< T1, T2 >& value) {
+  os << value.first;
+}
+
 template < typename T >
 void printMap(RBTreeNode< T >* node, int depth) {
   if (depth == 0) {
@@ -27,7 +38,9 @@ void printMap(RBTreeNode< T >* node, int depth) {
   }
   std::cout << (node->color ? C_RESET : C_RED)
             << (node->parent->value == NULL ? "Root" : (node->parent->leftChild == node ? "L" : "R"))
-            << " - key: " << node->value->first << C_RESET << std::endl;
+            << " - key: ";
+  printKey(std::cout, *node->value);
+  std::cout << C_RESET << std::endl;
   if (node->leftChild->value != NULL) {
     // std::cout << "left?" << std::endl;
     printMap(node->leftChild, depth + 1);
@@ -37,6 +50,39 @@ void printMap(RBTreeNode< T >* node, int depth) {
   }
   return;
 }
+
+// graphviz body: fill color follows the depth, outline follows the node color
+template < typename T >
+void printDotNode(std::ostream& os, RBTreeNode< T >* node, int depth) {
+  static const char* palette[] = {"#f7fbff", "#deebf7", "#c6dbef", "#9ecae1",
+                                  "#6baed6", "#4292c6", "#2171b5", "#08519c"};
+  const int palette_size = sizeof(palette) / sizeof(*palette);
+
+  os << "  n" << node << " [label=\"";
+  printKey(os, *node->value);
+  os << "\\nd" << depth << "\", style=filled, fillcolor=\""
+     << palette[depth < palette_size ? depth : palette_size - 1] << "\", color="
+     << (node->color ? "black" : "red") << ", fontcolor=" << (depth < 5 ? "black" : "white")
+     << "];" << std::endl;
+  if (node->leftChild->value != NULL) {
+    os << "  n" << node << " -> n" << node->leftChild << " [label=\"L\"];" << std::endl;
+    printDotNode(os, node->leftChild, depth + 1);
+  }
+  if (node->rightChild->value != NULL) {
+    os << "  n" << node << " -> n" << node->rightChild << " [label=\"R\"];" << std::endl;
+    printDotNode(os, node->rightChild, depth + 1);
+  }
+}
+
+template < typename T >
+void printDot(std::ostream& os, RBTreeNode< T >* root) {
+  os << "digraph RBTree {" << std::endl;
+  os << "  node [shape=circle, penwidth=2];" << std::endl;
+  if (root->value != NULL) {
+    printDotNode(os, root, 0);
+  }
+  os << "}" << std::endl;
+}
 }
 
 #endif
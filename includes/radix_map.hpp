@@ -0,0 +1,281 @@
+#ifndef RADIX_MAP_HPP
+# define RADIX_MAP_HPP
+
+#include "map.hpp"
+#include "RadixTree.hpp"
+#include "RadixIterator.hpp"
+
+namespace ft
+{
+	// ordered map over an adaptive radix tree, for integer and std::string keys: a lookup
+	// walks one node per key byte that tells keys apart (at most sizeof(Key) for
+	// integers) instead of comparing its way down ~log2(n) tree levels. Keys are ordered
+	// as by ft::less<Key>, i.e. like ft::map<Key, T>. Iterators and references stay
+	// valid until their element is erased.
+	template <class Key, class T>
+	class radix_map {
+		public :
+			typedef const Key	key_type;
+			typedef T	mapped_type;
+			typedef ft::pair<key_type, mapped_type>	value_type;
+			typedef ft::less<Key>	key_compare;
+			typedef typename ft::map<Key, T>::value_compare	value_compare;
+			typedef value_type&			reference;
+			typedef const value_type&	const_reference;
+			typedef value_type*			pointer;
+			typedef const value_type*	const_pointer;
+			typedef ft::RadixTree<Key, value_type>	tree_type;
+			typedef ft::RadixIterator<tree_type, value_type, value_type*, value_type&>	iterator;
+			typedef ft::RadixIterator<tree_type, value_type, const value_type*, const value_type&>	const_iterator;
+			typedef ft::reverse_iterator<iterator>				reverse_iterator;
+			typedef ft::reverse_iterator<const_iterator>		const_reverse_iterator;
+			typedef ptrdiff_t	difference_type;
+			typedef size_t		size_type;
+
+		private:
+			tree_type	_tree;
+
+		public:
+			radix_map() : _tree() {}
+
+			template <class InputIterator>
+			radix_map(InputIterator first, InputIterator last,
+					typename ft::enable_if<!ft::is_integral<InputIterator>::value, InputIterator>::type* = NULL) : _tree()
+			{
+				insert(first, last);
+			}
+
+			radix_map(const radix_map& x) : _tree()
+			{
+				*this = x;
+			}
+
+			~radix_map() {}
+
+			radix_map& operator=(const radix_map& x)
+			{
+				if (this != &x)
+				{
+					clear();
+					insert(x.begin(), x.end());
+				}
+				return (*this);
+			}
+
+			iterator begin()
+			{
+				return (iterator(&this->_tree, this->_tree.first()));
+			}
+			const_iterator begin() const
+			{
+				return (const_iterator(&this->_tree, this->_tree.first()));
+			}
+
+			iterator end()
+			{
+				return (iterator(&this->_tree, NULL));
+			}
+			const_iterator end() const
+			{
+				return (const_iterator(&this->_tree, NULL));
+			}
+
+			reverse_iterator rbegin()
+			{
+				return (reverse_iterator(end()));
+			}
+			const_reverse_iterator rbegin() const
+			{
+				return (const_reverse_iterator(end()));
+			}
+
+			reverse_iterator rend()
+			{
+				return (reverse_iterator(begin()));
+			}
+			const_reverse_iterator rend() const
+			{
+				return (const_reverse_iterator(begin()));
+			}
+
+			bool empty() const
+			{
+				return (this->_tree.size() == 0);
+			}
+			size_type size() const
+			{
+				return (this->_tree.size());
+			}
+			size_type max_size() const
+			{
+				return (std::allocator<typename tree_type::Leaf>().max_size());
+			}
+
+			mapped_type& operator[](const key_type& k)
+			{
+				typename tree_type::Leaf* leaf = this->_tree.find(k);
+				if (leaf == NULL)
+					leaf = this->_tree.insert(value_type(k, mapped_type())).first;
+				return (leaf->value.second);
+			}
+
+			pair<iterator, bool> insert(const value_type& val)
+			{
+				ft::pair<typename tree_type::Leaf*, bool> res = this->_tree.insert(val);
+				return (ft::make_pair(iterator(&this->_tree, res.first), res.second));
+			}
+
+			iterator insert(iterator, const value_type& val)
+			{
+				return (insert(val).first);
+			}
+
+			template <class InputIterator>
+			void insert(InputIterator first, InputIterator last,
+			typename ft::enable_if<!ft::is_integral<InputIterator>::value, InputIterator>::type* = NULL)
+			{
+				while (first != last)
+					this->_tree.insert(*first++);
+			}
+
+			void erase(iterator position)
+			{
+				this->_tree.erase(position.base());
+			}
+
+			size_type erase(const key_type& k)
+			{
+				typename tree_type::Leaf* leaf = this->_tree.find(k);
+				if (leaf == NULL)
+					return (0);
+				this->_tree.erase(leaf);
+				return (1);
+			}
+
+			void erase(iterator first, iterator last)
+			{
+				while (first != last)
+					erase(first++);
+			}
+
+			void swap(radix_map& x)
+			{
+				this->_tree.swap(x._tree);
+			}
+
+			void clear()
+			{
+				this->_tree.clear();
+			}
+
+			key_compare key_comp() const
+			{
+				return (key_compare());
+			}
+
+			value_compare value_comp() const
+			{
+				return (ft::map<Key, T>().value_comp());
+			}
+
+			iterator find(const key_type& k)
+			{
+				return (iterator(&this->_tree, this->_tree.find(k)));
+			}
+
+			const_iterator find(const key_type& k) const
+			{
+				return (const_iterator(&this->_tree, this->_tree.find(k)));
+			}
+
+			size_type count(const key_type& k) const
+			{
+				return (this->_tree.find(k) != NULL ? 1 : 0);
+			}
+
+			iterator lower_bound(const key_type& k)
+			{
+				return (iterator(&this->_tree, this->_tree.lower_bound(k)));
+			}
+
+			const_iterator lower_bound(const key_type& k) const
+			{
+				return (const_iterator(&this->_tree, this->_tree.lower_bound(k)));
+			}
+
+			iterator upper_bound(const key_type& k)
+			{
+				return (iterator(&this->_tree, this->_tree.upper_bound(k)));
+			}
+
+			const_iterator upper_bound(const key_type& k) const
+			{
+				return (const_iterator(&this->_tree, this->_tree.upper_bound(k)));
+			}
+
+			pair<iterator, iterator> equal_range(const key_type& k)
+			{
+				return (ft::make_pair(lower_bound(k), upper_bound(k)));
+			}
+			pair<const_iterator, const_iterator> equal_range(const key_type& k) const
+			{
+				return (ft::make_pair(lower_bound(k), upper_bound(k)));
+			}
+
+			// inner nodes with room for 4, 16, 48 and 256 children
+			void node_counts(size_type counts[4]) const
+			{
+				this->_tree.node_counts(counts);
+			}
+
+			bool verify() const
+			{
+				return (this->_tree.verify());
+			}
+	};
+
+
+	template <class Key, class T>
+	bool operator==(const radix_map<Key, T>& lhs, const radix_map<Key, T>& rhs)
+	{
+		return (lhs.size() == rhs.size() && ft::equal(lhs.begin(), lhs.end(), rhs.begin()));
+	}
+
+	template <class Key, class T>
+	bool operator!=(const radix_map<Key, T>& lhs, const radix_map<Key, T>& rhs)
+	{
+		return (!(lhs == rhs));
+	}
+
+	template <class Key, class T>
+	bool operator<(const radix_map<Key, T>& lhs, const radix_map<Key, T>& rhs)
+	{
+		return (ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()));
+	}
+
+	template <class Key, class T>
+	bool operator<=(const radix_map<Key, T>& lhs, const radix_map<Key, T>& rhs)
+	{
+		return (!(rhs < lhs));
+	}
+
+	template <class Key, class T>
+	bool operator>(const radix_map<Key, T>& lhs, const radix_map<Key, T>& rhs)
+	{
+		return (rhs < lhs);
+	}
+
+	template <class Key, class T>
+	bool operator>=(const radix_map<Key, T>& lhs, const radix_map<Key, T>& rhs)
+	{
+		return (!(lhs < rhs));
+	}
+
+	template <class Key, class T>
+	void swap(radix_map<Key, T>& x, radix_map<Key, T>& y)
+	{
+		x.swap(y);
+	}
+}
+
+#endif
@@ -0,0 +1,300 @@
+#ifndef ROARING_SET_HPP
+# define ROARING_SET_HPP
+
+#include <vector>
+#include <algorithm>
+#include "utils.hpp"
+#include "RoaringBitmap.hpp"
+#include "RoaringIterator.hpp"
+
+namespace ft
+{
+	// ordered set of 32-bit unsigned integers as a roaring bitmap: values are grouped by
+	// their high 16 bits and each group keeps the low 16 bits as a sorted array, a bitmap
+	// or runs (see RoaringContainer), about 2 bytes a value in sparse groups and 1 bit a
+	// possible value in dense ones, where ft::set spends a tree node each. |= and &= work
+	// group by group, on whole bitmap words where both sides are dense. Values are
+	// rebuilt on dereference, and insert and erase invalidate all iterators.
+	class roaring_set {
+		public :
+			typedef unsigned int	key_type;
+			typedef unsigned int	value_type;
+			typedef ft::less<unsigned int>	key_compare;
+			typedef ft::less<unsigned int>	value_compare;
+			typedef value_type			reference;
+			typedef value_type			const_reference;
+			typedef const value_type*	pointer;
+			typedef const value_type*	const_pointer;
+			typedef ft::RoaringIterator	iterator;
+			typedef ft::RoaringIterator	const_iterator;
+			typedef ft::reverse_iterator<iterator>	reverse_iterator;
+			typedef ft::reverse_iterator<iterator>	const_reverse_iterator;
+			typedef ptrdiff_t	difference_type;
+			typedef size_t		size_type;
+
+		private:
+			RoaringBitmap	_bitmap;
+
+		public:
+			roaring_set() : _bitmap() {}
+
+			template <class InputIterator>
+			roaring_set(InputIterator first, InputIterator last,
+					typename ft::enable_if<!ft::is_integral<InputIterator>::value, InputIterator>::type* = NULL) : _bitmap()
+			{
+				insert(first, last);
+			}
+
+			roaring_set(const roaring_set& x) : _bitmap(x._bitmap) {}
+
+			~roaring_set() {}
+
+			roaring_set& operator=(const roaring_set& x)
+			{
+				this->_bitmap = x._bitmap;
+				return (*this);
+			}
+
+			iterator begin() const
+			{
+				if (this->_bitmap.size() == 0)
+					return (end());
+				unsigned int pos = 0;
+				unsigned int low = 0;
+				this->_bitmap.chunk(0).first(pos, low);
+				return (iterator(&this->_bitmap, 0, pos, low));
+			}
+
+			iterator end() const
+			{
+				return (iterator(&this->_bitmap, this->_bitmap.chunks(), 0, 0));
+			}
+
+			reverse_iterator rbegin() const
+			{
+				return (reverse_iterator(end()));
+			}
+
+			reverse_iterator rend() const
+			{
+				return (reverse_iterator(begin()));
+			}
+
+			bool empty() const
+			{
+				return (this->_bitmap.size() == 0);
+			}
+			size_type size() const
+			{
+				return (this->_bitmap.size());
+			}
+			size_type max_size() const
+			{
+				return (static_cast<size_type>(0xffffffffUL) + 1);
+			}
+
+			pair<iterator, bool> insert(const value_type& val)
+			{
+				size_t index;
+				bool res = this->_bitmap.add(val, index);
+				return (ft::make_pair(at(index, val), res));
+			}
+
+			iterator insert(iterator, const value_type& val)
+			{
+				return (insert(val).first);
+			}
+
+			// the values are sorted first, so that each lands at the end of its group and of
+			// the group index rather than shifting them
+			template <class InputIterator>
+			void insert(InputIterator first, InputIterator last,
+			typename ft::enable_if<!ft::is_integral<InputIterator>::value, InputIterator>::type* = NULL)
+			{
+				std::vector<value_type> values;
+				for (; first != last; ++first)
+					values.push_back(*first);
+				std::sort(values.begin(), values.end());
+				size_t index;
+				for (size_t i = 0; i < values.size(); ++i)
+					this->_bitmap.add(values[i], index);
+			}
+
+			void erase(iterator position)
+			{
+				this->_bitmap.remove(*position);
+			}
+
+			size_type erase(const value_type& val)
+			{
+				return (this->_bitmap.remove(val) ? 1 : 0);
+			}
+
+			// the values are read out first, erasing invalidates the range
+			void erase(iterator first, iterator last)
+			{
+				if (first == begin() && last == end())
+				{
+					clear();
+					return ;
+				}
+				std::vector<value_type> values;
+				for (; first != last; ++first)
+					values.push_back(*first);
+				for (size_t i = 0; i < values.size(); ++i)
+					this->_bitmap.remove(values[i]);
+			}
+
+			void swap(roaring_set& x)
+			{
+				this->_bitmap.swap(x._bitmap);
+			}
+
+			void clear()
+			{
+				this->_bitmap.clear();
+			}
+
+			key_compare key_comp() const
+			{
+				return (key_compare());
+			}
+
+			value_compare value_comp() const
+			{
+				return (value_compare());
+			}
+
+			iterator find(const value_type& val) const
+			{
+				size_t index;
+				unsigned int pos = 0;
+				unsigned int low = 0;
+				if (!this->_bitmap.seek(val, index, pos, low) || ((this->_bitmap.key(index) << 16) | low) != val)
+					return (end());
+				return (iterator(&this->_bitmap, index, pos, low));
+			}
+
+			size_type count(const value_type& val) const
+			{
+				return (this->_bitmap.contains(val) ? 1 : 0);
+			}
+
+			iterator lower_bound(const value_type& val) const
+			{
+				size_t index;
+				unsigned int pos = 0;
+				unsigned int low = 0;
+				if (!this->_bitmap.seek(val, index, pos, low))
+					return (end());
+				return (iterator(&this->_bitmap, index, pos, low));
+			}
+
+			iterator upper_bound(const value_type& val) const
+			{
+				if (val == 0xffffffffU)
+					return (end());
+				return (lower_bound(val + 1));
+			}
+
+			pair<iterator, iterator> equal_range(const value_type& val) const
+			{
+				return (ft::make_pair(lower_bound(val), upper_bound(val)));
+			}
+
+			// this becomes the union of this and x
+			roaring_set& operator|=(const roaring_set& x)
+			{
+				this->_bitmap.unite(x._bitmap);
+				return (*this);
+			}
+
+			// this becomes the intersection of this and x
+			roaring_set& operator&=(const roaring_set& x)
+			{
+				this->_bitmap.intersect(x._bitmap);
+				return (*this);
+			}
+
+			// stores each group as runs where that is the smallest and trims spare capacity;
+			// worth calling once a set is built, for ranges of consecutive values
+			void optimize()
+			{
+				this->_bitmap.optimize();
+			}
+
+			// heap and inline bytes held
+			size_type bytes_used() const
+			{
+				return (sizeof(*this) - sizeof(this->_bitmap) + this->_bitmap.bytes_used());
+			}
+
+			// groups stored as arrays, bitmaps and runs
+			void chunk_counts(size_type counts[3]) const
+			{
+				this->_bitmap.chunk_counts(counts);
+			}
+
+		private:
+			// iterator to val, known to be in chunk index
+			iterator at(size_t index, value_type val) const
+			{
+				unsigned int pos = 0;
+				unsigned int low = 0;
+				this->_bitmap.chunk(index).seek(val & 0xffff, pos, low);
+				return (iterator(&this->_bitmap, index, pos, low));
+			}
+	};
+
+
+	inline bool operator==(const roaring_set& lhs, const roaring_set& rhs)
+	{
+		return (lhs.size() == rhs.size() && ft::equal(lhs.begin(), lhs.end(), rhs.begin()));
+	}
+
+	inline bool operator!=(const roaring_set& lhs, const roaring_set& rhs)
+	{
+		return (!(lhs == rhs));
+	}
+
+	inline bool operator<(const roaring_set& lhs, const roaring_set& rhs)
+	{
+		return (ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()));
+	}
+
+	inline bool operator<=(const roaring_set& lhs, const roaring_set& rhs)
+	{
+		return (!(rhs < lhs));
+	}
+
+	inline bool operator>(const roaring_set& lhs, const roaring_set& rhs)
+	{
+		return (rhs < lhs);
+	}
+
+	inline bool operator>=(const roaring_set& lhs, const roaring_set& rhs)
+	{
+		return (!(lhs < rhs));
+	}
+
+	inline roaring_set operator|(const roaring_set& lhs, const roaring_set& rhs)
+	{
+		roaring_set res(lhs);
+		res |= rhs;
+		return (res);
+	}
+
+	inline roaring_set operator&(const roaring_set& lhs, const roaring_set& rhs)
+	{
+		roaring_set res(lhs);
+		res &= rhs;
+		return (res);
+	}
+
+	inline void swap(roaring_set& x, roaring_set& y)
+	{
+		x.swap(y);
+	}
+}
+
+#endif
@@ -1,12 +1,17 @@
-#ifndef MAP_HPP
-# define MAP_HPP
+#ifndef SET_HPP
+# define SET_HPP
 
 #include "RBTree.hpp"
+#include "FindCache.hpp"
+#include "CountingBloom.hpp"
+#include "SharedTree.hpp"
+#include "parallel.hpp"
 
 namespace ft
 {
 
-	template < class Key, class Compare = ft::less<Key>, class Alloc = std::allocator<Key> >
+	// Balance selects the tree's rebalancing scheme: ft::RBBalance, ft::AVLBalance or ft::WBBalance
+	template < class Key, class Compare = ft::less<Key>, class Alloc = std::allocator<Key>, class Balance = ft::RBBalance >
 	class set {
 		public :
 
@@ -26,100 +31,127 @@ namespace ft
 			typedef ft::reverse_iterator<const_iterator>		const_reverse_iterator;
 			typedef typename allocator_type::difference_type	difference_type;
 			typedef typename allocator_type::size_type			size_type;
-			typedef ft::RBTree<value_type, value_compare>		rb_tree;
+			typedef ft::RBTree<value_type, value_compare, Alloc, Balance>	rb_tree;
 			typedef ft::RBTreeNode<value_type>					node_type;
 
 
 		private:
 			allocator_type	_alloc;
-			rb_tree			_tree;
+			SharedTree<rb_tree>	_tree;
+			mutable FindCache<node_type>	_cache;
+			mutable CountingBloom	_bloom;
+			mutable node_type*	_finger;	// where the last *_near search ended, NULL when unknown
 			key_compare		_comp;
 
 		public:
 
-			explicit set (const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type()) : _alloc(alloc), _tree(), _comp(comp) {}
+			explicit set (const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type()) : _alloc(alloc), _tree(), _finger(NULL), _comp(comp) {}
 
 			template <class InputIterator>
 			set (InputIterator first, InputIterator last,
 					const key_compare& comp = key_compare(),
 					const allocator_type& alloc = allocator_type(),
-					typename ft::enable_if<!ft::is_integral<InputIterator>::value, InputIterator>::type* = NULL) : _alloc(alloc), _tree(), _comp(comp)
+					typename ft::enable_if<!ft::is_integral<InputIterator>::value, InputIterator>::type* = NULL) : _alloc(alloc), _tree(), _finger(NULL), _comp(comp)
 			{
 				insert(first, last);
 			}
 
-			set (const set& x) : _alloc(x._alloc), _tree(), _comp(x._comp)
+			set (const set& x) : _alloc(x._alloc), _tree(), _finger(NULL), _comp(x._comp)
 			{
 				*this = x;
 			}
 
 			~set() {}
 
+#ifdef FT_CXX11
+			// x is left empty; its nodes change owner, no element is copied or moved
+			set (set&& x) : _alloc(x._alloc), _tree(), _finger(NULL), _comp(x._comp)
+			{
+				swap(x);
+			}
+
+			set& operator=(set&& x)
+			{
+				if (this != &x)
+				{
+					clear();
+					swap(x);
+				}
+				return *this;
+			}
+#endif
+
 			set& operator=(const set& x)
 			{
 				if (this != &x)
-					this->_tree.copy(x._tree);
+				{
+					this->_tree.assign(x._tree);
+					this->_bloom = x._bloom;
+					this->_cache.clear();
+					this->_finger = NULL;
+				}
 				return *this;
 			}
 
 			iterator begin()
 			{
-				return iterator(this->_tree.get_begin());
+				return iterator(edit_tree().get_begin());
 			}
 			const_iterator begin() const
 			{
-				return const_iterator(this->_tree.get_begin());
+				return const_iterator(tree().get_begin());
 			}
 
 			iterator end()
 			{
-				return iterator(this->_tree.get_end());
+				return iterator(edit_tree().get_end());
 			}
 			const_iterator end() const
 			{
-				return const_iterator(this->_tree.get_end());
+				return const_iterator(tree().get_end());
 			}
 
 			reverse_iterator rbegin()
 			{
-				return reverse_iterator(this->_tree.get_end());
+				return reverse_iterator(edit_tree().get_end());
 			}
 			const_reverse_iterator rbegin() const
 			{
-				return const_reverse_iterator(this->_tree.get_end());
+				return const_reverse_iterator(tree().get_end());
 			}
 
 			reverse_iterator rend()
 			{
-				return reverse_iterator(this->_tree.get_begin());
+				return reverse_iterator(edit_tree().get_begin());
 			}
 			const_reverse_iterator rend() const
 			{
-				return const_reverse_iterator(this->_tree.get_begin());
+				return const_reverse_iterator(tree().get_begin());
 			}
 
 			bool empty() const
 			{
-				return (this->_tree.empty());
+				return (tree().empty());
 			}
 			size_type size() const
 			{
-				return (this->_tree.size());
+				return (tree().size());
 			}
 			size_type max_size() const
 			{
-				return (this->_tree.max_size());
+				return (tree().max_size());
 			}
 
 			pair<iterator, bool> insert(const value_type& val)
 			{
-				ft::pair<node_type*, bool> res = _tree.insert(val);
+				ft::pair<node_type*, bool> res = added(edit_tree().insert(val));
 				return (ft::make_pair(iterator(res.first), res.second));
 			}
 
 			iterator insert(iterator position, const value_type& val)
 			{
-				return (iterator(this->_tree.insert(val, position.base()).first));
+				node_type* at = hint(position);
+				return (iterator(added(edit_tree().insert(val, at)).first));
 			}
 
 			template <class InputIterator>
@@ -127,21 +159,90 @@ namespace ft
 			typename ft::enable_if<!ft::is_integral<InputIterator>::value, InputIterator>::type* = NULL)
 			{
 				while (first != last)
-					this->_tree.insert(*first++);
+					added(edit_tree().insert(*first++));
+			}
+
+#ifdef FT_CXX11
+			pair<iterator, bool> insert(value_type&& val)
+			{
+				ft::pair<node_type*, bool> res = added(edit_tree().insert(std::move(val)));
+				return (ft::make_pair(iterator(res.first), res.second));
+			}
+
+			iterator insert(iterator position, value_type&& val)
+			{
+				node_type* at = hint(position);
+				return (iterator(added(edit_tree().insert(std::move(val), at)).first));
 			}
 
+			// the element is built once, in its node, from args
+			template <typename... Args>
+			pair<iterator, bool> emplace(Args&&... args)
+			{
+				ft::pair<node_type*, bool> res = added(edit_tree().emplace(NULL, std::forward<Args>(args)...));
+				return (ft::make_pair(iterator(res.first), res.second));
+			}
+
+			template <typename... Args>
+			iterator emplace_hint(iterator position, Args&&... args)
+			{
+				node_type* at = hint(position);
+				return (iterator(added(edit_tree().emplace(at, std::forward<Args>(args)...)).first));
+			}
+#endif
+
 			void erase(iterator position)
 			{
-				this->_tree.erase(position.base());
+				if (this->_tree.cloning())
+				{
+					// position is in the tree shared with copies, erase the clone's node
+					Key k(*position);
+					erase(k);
+					return ;
+				}
+				this->_cache.invalidate(ft::hash<Key>()(*position), position.base());
+				if (this->_bloom.enabled())
+					this->_bloom.remove(ft::hash<Key>()(*position));
+				if (position.base() == this->_finger)
+					this->_finger = NULL;
+				edit_tree().erase(position.base());
 			}
 
 			size_type erase(const key_type& k)
 			{
-				return (this->_tree.erase(_tree.find(value_type(k))));
+				if (this->_tree.cloning() && tree().find(k)->value == NULL)
+					return (0);
+				node_type* node = edit_tree().find(k);
+				this->_cache.invalidate(ft::hash<Key>()(k), node);
+				if (node == this->_finger)
+					this->_finger = NULL;
+				if (edit_tree().erase(node) == 0)
+					return (0);
+				if (this->_bloom.enabled())
+					this->_bloom.remove(ft::hash<Key>()(k));
+				return (1);
 			}
 
 			void erase(iterator first, iterator last)
 			{
+				if (first != last && this->_tree.cloning())
+				{
+					// the range is in the tree shared with copies, find it in the clone
+					Key from(*first);
+					if (last.base() == tree().get_end())
+					{
+						edit_tree();
+						first = lower_bound(from);
+						last = end();
+					}
+					else
+					{
+						Key to(*last);
+						edit_tree();
+						first = lower_bound(from);
+						last = lower_bound(to);
+					}
+				}
 				while (first != last)
 					erase(first++);
 			}
@@ -149,11 +250,19 @@ namespace ft
 			void swap(set& x)
 			{
 				this->_tree.swap(x._tree);
+				this->_cache.swap(x._cache);
+				this->_bloom.swap(x._bloom);
+				node_type* finger = this->_finger;
+				this->_finger = x._finger;
+				x._finger = finger;
 			}
 
 			void clear()
 			{
 				this->_tree.clear();
+				this->_bloom.clear();
+				this->_cache.clear();
+				this->_finger = NULL;
 			}
 
 			key_compare key_comp() const
@@ -168,17 +277,18 @@ namespace ft
 
 			iterator find(const key_type& k)
 			{
-				return (iterator(this->_tree.find(value_type(k))));
+				edit_tree();
+				return (iterator(find_node(k)));
 			}
 
 			const_iterator find(const key_type& k) const
 			{
-				return (const_iterator(this->_tree.find(value_type(k))));
+				return (const_iterator(find_node(k)));
 			}
 
 			size_type count(const key_type& k) const
 			{
-				if (this->_tree.find(value_type(k))->value != NULL)
+				if (find_node(k)->value != NULL)
 					return (1);
 				else
 					return (0);
@@ -187,22 +297,22 @@ namespace ft
 
 			iterator lower_bound(const key_type& k)
 			{
-				return (iterator(this->_tree.lower_bound(value_type(k))));
+				return (iterator(edit_tree().lower_bound(k)));
 			}
 
 			const_iterator lower_bound(const key_type& k) const
 			{
-				return (const_iterator(this->_tree.lower_bound(value_type(k))));
+				return (const_iterator(tree().lower_bound(k)));
 			}
 
 
 			iterator upper_bound(const key_type& k)
 			{
-				return (iterator(this->_tree.upper_bound(value_type(k))));
+				return (iterator(edit_tree().upper_bound(k)));
 			}
 			const_iterator upper_bound(const key_type& k) const
 			{
-				return (const_iterator(this->_tree.upper_bound(value_type(k))));
+				return (const_iterator(tree().upper_bound(k)));
 			}
 
 
@@ -211,6 +321,32 @@ namespace ft
 				return (ft::make_pair(lower_bound(k), upper_bound(k)));
 			}
 
+			// find() and lower_bound() searched from where the previous *_near call ended
+			// instead of from the root: O(log d) for a key d elements away, so worth it
+			// when successive keys are close; a far key costs at most two lookups. Const calls
+			// may run on several threads, each then starting from wherever another ended
+			iterator find_near(const key_type& k)
+			{
+				edit_tree();
+				return (iterator(find_near_node(k)));
+			}
+
+			const_iterator find_near(const key_type& k) const
+			{
+				return (const_iterator(find_near_node(k)));
+			}
+
+			iterator lower_bound_near(const key_type& k)
+			{
+				edit_tree();
+				return (iterator(lower_bound_near_node(k)));
+			}
+
+			const_iterator lower_bound_near(const key_type& k) const
+			{
+				return (const_iterator(lower_bound_near_node(k)));
+			}
+
 			allocator_type get_allocator() const
 			{
 				return (this->_alloc);
@@ -218,54 +354,315 @@ namespace ft
 
 			void showTree()
 			{
-				this->_tree.showMap();
+				tree().showMap();
+			}
+
+			void exportDot(std::ostream& os) const
+			{
+				tree().exportDot(os);
+			}
+
+			RBTreeStats tree_stats() const
+			{
+				return (tree().tree_stats());
+			}
+
+			bool verify() const
+			{
+				return (tree().verify());
+			}
+
+			HotCounters hot_counters() const
+			{
+				return (tree().hot_counters());
+			}
+
+			// the counts belong to the tree: copies sharing it read and reset the same ones,
+			// and resetting does not clone it
+			void reset_hot_counters()
+			{
+				tree().reset_hot_counters();
+			}
+
+			// opt-in cache of recently found nodes in front of find() and count(), worth it
+			// when a few keys take most lookups; slots is rounded up to a power of two and 0
+			// turns it off. ft::hash<Key> must give equivalent keys the same hash. Const
+			// lookups from several threads stay safe, the hit and miss counts may come out low.
+			void enable_find_cache(size_type slots)
+			{
+				this->_cache.enable(slots);
+			}
+
+			size_type find_cache_hits() const
+			{
+				return (this->_cache.hits());
+			}
+
+			size_type find_cache_misses() const
+			{
+				return (this->_cache.misses());
+			}
+
+			// opt-in copy-on-write: copies of this set, and their copies, share its tree until
+			// one of them is first modified (insert, erase, ...) or hands out an iterator
+			// that can write (non-const begin(), find(), ...), which clones it for that set
+			// alone; a copy only read through a const reference costs O(1). That clone
+			// invalidates the set's iterators and references, and one taken before the set
+			// was copied must not write after. false unshares it.
+			void enable_copy_on_write(bool on = true)
+			{
+				if (!on && this->_tree.cloning())
+				{
+					this->_cache.clear();
+					this->_finger = NULL;
+				}
+				if (on)
+					this->_tree.share();
+				else
+					this->_tree.unshare();
+			}
+
+			bool shares_tree() const
+			{
+				return (this->_tree.cloning());
+			}
+
+			// opt-in counting Bloom filter in front of find() and count() (and find_near()),
+			// worth it when most lookups miss: a miss it catches costs a few hashed probes
+			// instead of a tree descent. Sized for expected keys at per_key one-byte counters
+			// each (10: about 1% false positives); it is refilled at twice the size whenever
+			// size() outgrows it. 0 turns it off. ft::hash<Key> must tell keys apart, keys it
+			// hashes alike are never rejected. Const lookups from several threads stay safe,
+			// bloom_rejections() may come out low.
+			void enable_bloom_filter(size_type expected, size_type per_key = 10)
+			{
+				if (expected == 0 || per_key == 0)
+					this->_bloom.enable(0, 0);
+				else
+				{
+					this->_bloom.enable(0, per_key);
+					refill_bloom(expected);
+				}
+			}
+
+			size_type bloom_rejections() const
+			{
+				return (this->_bloom.rejected());
+			}
+
+			// opt-in lazy erase for delete-heavy use: erase() only marks the element dead,
+			// which iterators, lookups and size() skip, and the tree is rebuilt in one pass
+			// once dead elements are more than max_dead (0 to 1) of all nodes. 0 turns it
+			// off and drops the dead elements now. Iterators to live elements survive.
+			void enable_lazy_erase(double max_dead)
+			{
+				edit_tree().set_lazy_erase(max_dead);
+			}
+
+			// moves all nodes and values into one contiguous block, in key order for scans
+			// or ft::VEB_ORDER for lookups; invalidates iterators and references
+			void compact(CompactOrder order = IN_ORDER)
+			{
+				edit_tree().compact(order);
+				this->_cache.clear();
+				this->_finger = NULL;
+			}
+
+			// in-order compact() done budget nodes per call to bound the pause, true when
+			// the pass is over; every call invalidates iterators and references
+			bool compact_step(size_type budget)
+			{
+				this->_cache.clear();
+				this->_finger = NULL;
+				return (edit_tree().compact_step(budget));
+			}
+
+			// replaces the content with [first, last), which must be sorted with no
+			// duplicates; no comparison is made and the tree comes out perfectly balanced
+			template <class RandomIt>
+			void assign_sorted(RandomIt first, RandomIt last, unsigned int threads = 1)
+			{
+				edit_tree().build_sorted(first, static_cast<size_type>(last - first), threads);
+				this->_cache.clear();
+				this->_finger = NULL;
+				if (this->_bloom.enabled())
+					refill_bloom(this->_bloom.capacity());
+			}
+
+			// same result as insert(first, last) on large unsorted input, with the elements
+			// stable-sorted on up to threads pthreads (0: one per core) and the tree rebuilt
+			// with assign_sorted
+			template <class InputIterator>
+			void bulk_load(InputIterator first, InputIterator last, unsigned int threads = 0)
+			{
+				std::vector<Key> buf;
+				buf.reserve(size());
+				for (const_iterator it(tree().get_begin()); it != const_iterator(tree().get_end()); ++it)
+					buf.push_back(*it);
+				for (; first != last; ++first)
+					buf.push_back(*first);
+				ft::parallel_stable_sort(buf, this->_comp, threads);
+				ft::unique_sorted(buf, this->_comp);
+				assign_sorted(buf.begin(), buf.end(), threads);
+			}
+
+			// erases every element pred(element) holds for in one pass and returns how many;
+			// a large share of victims is dropped at once and the survivors relinked in
+			// linear time rather than rebalanced after each. Iterators to survivors stay valid.
+			template <class Predicate>
+			size_type erase_if(Predicate pred)
+			{
+				size_type res = edit_tree().erase_if(pred);
+				if (res == 0)
+					return (0);
+				this->_cache.clear();
+				this->_finger = NULL;
+				if (this->_bloom.enabled())
+					refill_bloom(this->_bloom.capacity());
+				return (res);
+			}
+
+			// f(element) for every element on up to threads pthreads (0: one per core); f
+			// runs concurrently on different elements and must not throw
+			template <class Function>
+			void parallel_for_each(Function f, unsigned int threads = 0) const
+			{
+				ft::ConstVisitor<Function, value_type> visitor(f);
+				ft::parallel_for_each_node(tree().get_root(), this->size(), visitor, threads);
+			}
+
+			// reduce over transform(element) split across threads; init must be an identity
+			// of the associative reduce. Partials are combined in key order with a grouping
+			// set by the tree's shape, so the result does not change with threads; equal
+			// contents built in another order may group differently, which shows with a
+			// reduce that is not exactly associative, such as floating-point addition.
+			template <class U, class Reduce, class Transform>
+			U parallel_reduce(U init, Reduce reduce, Transform transform, unsigned int threads = 0) const
+			{
+				return (ft::parallel_reduce_nodes(tree().get_root(), this->size(), init, reduce, transform, threads));
+			}
+
+		private :
+			const rb_tree& tree() const
+			{
+				return (this->_tree.get());
+			}
+
+			// the tree to modify, cloned first while copies share it
+			rb_tree& edit_tree()
+			{
+				if (this->_tree.cloning())
+				{
+					this->_cache.clear();
+					this->_finger = NULL;
+				}
+				return (this->_tree.edit());
+			}
+
+			// a hint into a tree about to be cloned is no use; taken before edit_tree()
+			node_type* hint(iterator position) const
+			{
+				return (this->_tree.cloning() ? NULL : position.base());
+			}
+
+			// keeps the Bloom filter in step with a successful insert
+			ft::pair<node_type*, bool> added(ft::pair<node_type*, bool> res)
+			{
+				if (res.second && this->_bloom.enabled() && this->_bloom.add(ft::hash<Key>()(*res.first->value)))
+					refill_bloom(this->_bloom.capacity() * 2);
+				return (res);
+			}
+
+			void refill_bloom(size_type capacity)
+			{
+				if (capacity < size())
+					capacity = size();
+				this->_bloom.enable(capacity, this->_bloom.per_key());
+				for (const_iterator it(tree().get_begin()); it != const_iterator(tree().get_end()); ++it)
+					this->_bloom.add(ft::hash<Key>()(*it));
+			}
+
+			node_type* find_node(const key_type& k) const
+			{
+				if (this->_bloom.enabled() && !this->_bloom.may_contain(ft::hash<Key>()(k)))
+					return (tree().get_end());
+				if (!this->_cache.enabled())
+					return (tree().find(k));
+				return (this->_cache.find(tree(), k, ft::hash<Key>()(k)));
+			}
+
+			node_type* lower_bound_near_node(const key_type& k) const
+			{
+				// relaxed, so const calls on several threads do not race: any live node is a
+				// valid finger
+				node_type* res = tree().lower_bound_from(ft::relaxed_load(this->_finger), k);
+				if (res->value != NULL)
+					ft::relaxed_store(this->_finger, res);
+				return (res);
+			}
+
+			node_type* find_near_node(const key_type& k) const
+			{
+				if (this->_bloom.enabled() && !this->_bloom.may_contain(ft::hash<Key>()(k)))
+					return (tree().get_end());
+				node_type* res = lower_bound_near_node(k);
+				if (res->value == NULL || !tree().equivalent(k, res))
+					return (tree().get_end());
+				return (res);
 			}
 
 
 	};
 
 
-	template <class Key, class Compare, class Alloc>
-	bool operator==(const set<Key, Compare, Alloc>& lhs, const set<Key, Compare, Alloc>& rhs)
+	template <class Key, class Compare, class Alloc, class Balance>
+	bool operator==(const set<Key, Compare, Alloc, Balance>& lhs, const set<Key, Compare, Alloc, Balance>& rhs)
 	{
 		return (lhs.size() == rhs.size() && ft::equal(lhs.begin(), lhs.end(), rhs.begin()));
 	}
 
-	template <class Key, class Compare, class Alloc>
-	bool operator!=(const set<Key, Compare, Alloc>& lhs, const set<Key, Compare, Alloc>& rhs)
+	template <class Key, class Compare, class Alloc, class Balance>
+	bool operator!=(const set<Key, Compare, Alloc, Balance>& lhs, const set<Key, Compare, Alloc, Balance>& rhs)
 	{
 		return (!(lhs == rhs));
 	}
 
-	template <class Key, class Compare, class Alloc>
-	bool operator<(const set<Key, Compare, Alloc>& lhs, const set<Key, Compare, Alloc>& rhs)
+	template <class Key, class Compare, class Alloc, class Balance>
+	bool operator<(const set<Key, Compare, Alloc, Balance>& lhs, const set<Key, Compare, Alloc, Balance>& rhs)
 	{
 		return (ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()));
 	}
 
-	template <class Key, class Compare, class Alloc>
-	bool operator<=(const set<Key, Compare, Alloc>& lhs, const set<Key, Compare, Alloc>& rhs)
+	template <class Key, class Compare, class Alloc, class Balance>
+	bool operator<=(const set<Key, Compare, Alloc, Balance>& lhs, const set<Key, Compare, Alloc, Balance>& rhs)
 	{
 		return (!(rhs < lhs));
 	}
 
-	template <class Key, class Compare, class Alloc>
-	bool operator>(const set<Key, Compare, Alloc>& lhs, const set<Key, Compare, Alloc>& rhs)
+	template <class Key, class Compare, class Alloc, class Balance>
+	bool operator>(const set<Key, Compare, Alloc, Balance>& lhs, const set<Key, Compare, Alloc, Balance>& rhs)
 	{
 		return (rhs < lhs);
 	}
 
-	template <class Key, class Compare, class Alloc>
-	bool operator>=(const set<Key, Compare, Alloc>& lhs, const set<Key, Compare, Alloc>& rhs)
+	template <class Key, class Compare, class Alloc, class Balance>
+	bool operator>=(const set<Key, Compare, Alloc, Balance>& lhs, const set<Key, Compare, Alloc, Balance>& rhs)
 	{
 		return (!(lhs < rhs));
 	}
 
-	template <class Key, class Compare, class Alloc>
-	void swap(set<Key, Compare, Alloc>& x, set<Key, Compare, Alloc>& y)
+	template <class Key, class Compare, class Alloc, class Balance>
+	void swap(set<Key, Compare, Alloc, Balance>& x, set<Key, Compare, Alloc, Balance>& y)
 	{
 		x.swap(y);
 	}
+
+	// std::erase_if of C++20
+	template <class Key, class Compare, class Alloc, class Balance, class Predicate>
+	typename set<Key, Compare, Alloc, Balance>::size_type erase_if(set<Key, Compare, Alloc, Balance>& c, Predicate pred)
+	{
+		return (c.erase_if(pred));
+	}
 }
 
 #endif
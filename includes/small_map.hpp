@@ -0,0 +1,455 @@
+#ifndef SMALL_MAP_HPP
+# define SMALL_MAP_HPP
+
+#include "map.hpp"
+#include "SmallIterator.hpp"
+
+namespace ft
+{
+	// map keeping up to N elements in a sorted array inside the object: no sentinel and no
+	// allocation until the N+1th insert, which moves everything into an RBTree for good
+	template < class Key, class T, size_t N = 16, class Compare = ft::less<Key>, class Alloc = std::allocator< ft::pair<const Key, T> > >
+	class small_map {
+		public :
+			typedef const Key	key_type;
+			typedef T	mapped_type;
+			typedef ft::pair<key_type, mapped_type>	value_type;
+			typedef Compare	key_compare;
+			typedef typename ft::map<Key, T, Compare, Alloc>::value_compare	value_compare;
+			typedef Alloc	allocator_type;
+			typedef typename allocator_type::reference			reference;
+			typedef typename allocator_type::const_reference	const_reference;
+			typedef typename allocator_type::pointer			pointer;
+			typedef typename allocator_type::const_pointer		const_pointer;
+			typedef typename ft::SmallIterator<value_type, value_type*, value_type&>	iterator;
+			typedef typename ft::SmallIterator<value_type, const value_type*, const value_type&>	const_iterator;
+			typedef ft::reverse_iterator<iterator>				reverse_iterator;
+			typedef ft::reverse_iterator<const_iterator>		const_reverse_iterator;
+			typedef typename allocator_type::difference_type	difference_type;
+			typedef typename allocator_type::size_type			size_type;
+			typedef ft::RBTree<value_type, value_compare, Alloc>	rb_tree;
+			typedef ft::RBTreeNode<value_type>					node_type;
+
+		private:
+			union storage_type {
+				char		buf[N * sizeof(value_type)];
+				long double	align_ld;
+				long long	align_ll;
+				void*		align_ptr;
+			};
+
+			allocator_type	_alloc;
+			storage_type	_storage;
+			size_type		_count;
+			rb_tree*		_tree;
+			key_compare		_comp;
+
+		public:
+			explicit small_map (const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type()) : _alloc(alloc), _count(0), _tree(NULL), _comp(comp) {}
+
+			template <class InputIterator>
+			small_map (InputIterator first, InputIterator last,
+					const key_compare& comp = key_compare(),
+					const allocator_type& alloc = allocator_type(),
+					typename ft::enable_if<!ft::is_integral<InputIterator>::value, InputIterator>::type* = NULL) : _alloc(alloc), _count(0), _tree(NULL), _comp(comp)
+			{
+				insert(first, last);
+			}
+
+			small_map (const small_map& x) : _alloc(x._alloc), _count(0), _tree(NULL), _comp(x._comp)
+			{
+				*this = x;
+			}
+
+			~small_map()
+			{
+				clear();
+			}
+
+			small_map& operator=(const small_map& x)
+			{
+				if (this != &x)
+				{
+					clear();
+					if (x._tree != NULL)
+						this->_tree = new rb_tree(*x._tree);
+					else
+					{
+						while (this->_count < x._count)
+						{
+							_alloc.construct(elems() + this->_count, x.elems()[this->_count]);
+							this->_count++;
+						}
+					}
+				}
+				return *this;
+			}
+
+			iterator begin()
+			{
+				if (this->_tree != NULL)
+					return (iterator(this->_tree->get_begin()));
+				return (iterator(elems()));
+			}
+			const_iterator begin() const
+			{
+				if (this->_tree != NULL)
+					return (const_iterator(this->_tree->get_begin()));
+				return (const_iterator(elems()));
+			}
+
+			iterator end()
+			{
+				if (this->_tree != NULL)
+					return (iterator(this->_tree->get_end()));
+				return (iterator(elems() + this->_count));
+			}
+			const_iterator end() const
+			{
+				if (this->_tree != NULL)
+					return (const_iterator(this->_tree->get_end()));
+				return (const_iterator(elems() + this->_count));
+			}
+
+			reverse_iterator rbegin()
+			{
+				return reverse_iterator(end());
+			}
+			const_reverse_iterator rbegin() const
+			{
+				return const_reverse_iterator(end());
+			}
+
+			reverse_iterator rend()
+			{
+				return reverse_iterator(begin());
+			}
+			const_reverse_iterator rend() const
+			{
+				return const_reverse_iterator(begin());
+			}
+
+			bool empty() const
+			{
+				return (size() == 0);
+			}
+			size_type size() const
+			{
+				if (this->_tree != NULL)
+					return (this->_tree->size());
+				return (this->_count);
+			}
+			size_type max_size() const
+			{
+				return (this->_alloc.max_size());
+			}
+
+			// true while the elements still live in the inline array
+			bool is_small() const
+			{
+				return (this->_tree == NULL);
+			}
+
+			mapped_type& operator[](const key_type& k)
+			{
+				return ((*insert(ft::make_pair(k, mapped_type())).first).second);
+			}
+
+			pair<iterator, bool> insert(const value_type& val)
+			{
+				if (this->_tree != NULL)
+				{
+					ft::pair<node_type*, bool> res = this->_tree->insert(val);
+					return (ft::make_pair(iterator(res.first), res.second));
+				}
+				size_type pos = lower_index(val.first);
+				if (pos != this->_count && !_comp(val.first, elems()[pos].first))
+					return (ft::make_pair(iterator(elems() + pos), false));
+				if (this->_count == N)
+				{
+					promote();
+					return (insert(val));
+				}
+				value_type* tmp = elems() + this->_count;
+				while (tmp != elems() + pos)
+				{
+					_alloc.construct(tmp, *(tmp - 1));
+					_alloc.destroy(--tmp);
+				}
+				_alloc.construct(tmp, val);
+				this->_count++;
+				return (ft::make_pair(iterator(tmp), true));
+			}
+
+			iterator insert(iterator position, const value_type& val)
+			{
+				if (this->_tree != NULL)
+					return (iterator(this->_tree->insert(val, position.node()).first));
+				return (insert(val).first);
+			}
+
+			template <class InputIterator>
+			void insert(InputIterator first, InputIterator last,
+			typename ft::enable_if<!ft::is_integral<InputIterator>::value, InputIterator>::type* = NULL)
+			{
+				while (first != last)
+					insert(*first++);
+			}
+
+			void erase(iterator position)
+			{
+				if (this->_tree != NULL)
+				{
+					this->_tree->erase(position.node());
+					return ;
+				}
+				value_type* tmp = position.elem();
+				value_type* last = elems() + this->_count - 1;
+				_alloc.destroy(tmp);
+				while (tmp != last)
+				{
+					_alloc.construct(tmp, *(tmp + 1));
+					_alloc.destroy(++tmp);
+				}
+				this->_count--;
+			}
+
+			size_type erase(const key_type& k)
+			{
+				iterator it = find(k);
+				if (it == end())
+					return (0);
+				erase(it);
+				return (1);
+			}
+
+			void erase(iterator first, iterator last)
+			{
+				if (this->_tree != NULL)
+				{
+					while (first != last)
+						erase(first++);
+					return ;
+				}
+				// array elements move down on every erase, so erase from the back
+				while (first != last)
+					erase(--last);
+			}
+
+			// promoted trees change hands in O(1), inline elements are copied over: at most
+			// N per side and no tree is copied. Iterators to inline elements are invalidated.
+			void swap(small_map& x)
+			{
+				if (this->_tree == NULL && x._tree == NULL)
+				{
+					small_map tmp;
+					tmp.take_elems(x);
+					x.take_elems(*this);
+					take_elems(tmp);
+					return ;
+				}
+				if (this->_tree == NULL)
+					x.take_elems(*this);
+				else if (x._tree == NULL)
+					take_elems(x);
+				rb_tree* tree = this->_tree;
+				this->_tree = x._tree;
+				x._tree = tree;
+			}
+
+			// drops the promoted tree too, the map is small again afterwards
+			void clear()
+			{
+				if (this->_tree != NULL)
+				{
+					delete this->_tree;
+					this->_tree = NULL;
+				}
+				while (this->_count != 0)
+					_alloc.destroy(elems() + --this->_count);
+			}
+
+			key_compare key_comp() const
+			{
+				return (key_compare());
+			}
+
+			value_compare value_comp() const
+			{
+				return (value_compare());
+			}
+
+			iterator find(const key_type& k)
+			{
+				if (this->_tree != NULL)
+					return (iterator(this->_tree->find(k)));
+				size_type pos = lower_index(k);
+				if (pos == this->_count || _comp(k, elems()[pos].first))
+					return (end());
+				return (iterator(elems() + pos));
+			}
+
+			const_iterator find(const key_type& k) const
+			{
+				if (this->_tree != NULL)
+					return (const_iterator(this->_tree->find(k)));
+				size_type pos = lower_index(k);
+				if (pos == this->_count || _comp(k, elems()[pos].first))
+					return (end());
+				return (const_iterator(elems() + pos));
+			}
+
+			size_type count(const key_type& k) const
+			{
+				return (find(k) == end() ? 0 : 1);
+			}
+
+			iterator lower_bound(const key_type& k)
+			{
+				if (this->_tree != NULL)
+					return (iterator(this->_tree->lower_bound(k)));
+				return (iterator(elems() + lower_index(k)));
+			}
+
+			const_iterator lower_bound(const key_type& k) const
+			{
+				if (this->_tree != NULL)
+					return (const_iterator(this->_tree->lower_bound(k)));
+				return (const_iterator(elems() + lower_index(k)));
+			}
+
+			iterator upper_bound(const key_type& k)
+			{
+				if (this->_tree != NULL)
+					return (iterator(this->_tree->upper_bound(k)));
+				return (iterator(elems() + upper_index(k)));
+			}
+			const_iterator upper_bound(const key_type& k) const
+			{
+				if (this->_tree != NULL)
+					return (const_iterator(this->_tree->upper_bound(k)));
+				return (const_iterator(elems() + upper_index(k)));
+			}
+
+			pair<iterator, iterator> equal_range(const key_type& k)
+			{
+				return (ft::make_pair(lower_bound(k), upper_bound(k)));
+			}
+			pair<const_iterator, const_iterator> equal_range(const key_type& k) const
+			{
+				return (ft::make_pair(lower_bound(k), upper_bound(k)));
+			}
+
+			allocator_type get_allocator() const
+			{
+				return (this->_alloc);
+			}
+
+		private:
+			value_type* elems() const
+			{
+				return (reinterpret_cast<value_type*>(const_cast<char*>(this->_storage.buf)));
+			}
+
+			size_type lower_index(const key_type& k) const
+			{
+				size_type first = 0;
+				size_type len = this->_count;
+				while (len > 0)
+				{
+					size_type half = len / 2;
+					if (_comp(elems()[first + half].first, k))
+					{
+						first += half + 1;
+						len -= half + 1;
+					}
+					else
+						len = half;
+				}
+				return (first);
+			}
+
+			size_type upper_index(const key_type& k) const
+			{
+				size_type first = 0;
+				size_type len = this->_count;
+				while (len > 0)
+				{
+					size_type half = len / 2;
+					if (!_comp(k, elems()[first + half].first))
+					{
+						first += half + 1;
+						len -= half + 1;
+					}
+					else
+						len = half;
+				}
+				return (first);
+			}
+
+			// copies from's inline elements into this one's empty array, then empties from's
+			void take_elems(small_map& from)
+			{
+				for (; this->_count < from._count; ++this->_count)
+					_alloc.construct(elems() + this->_count, from.elems()[this->_count]);
+				while (from._count != 0)
+					_alloc.destroy(from.elems() + --from._count);
+			}
+
+			// sorted input, so every insert takes the end() hint
+			void promote()
+			{
+				rb_tree* tree = new rb_tree();
+				for (size_type i = 0; i < this->_count; ++i)
+					tree->insert(elems()[i], tree->get_end());
+				while (this->_count != 0)
+					_alloc.destroy(elems() + --this->_count);
+				this->_tree = tree;
+			}
+	};
+
+
+	template <class Key, class T, size_t N, class Compare, class Alloc>
+	bool operator==(const small_map<Key, T, N, Compare, Alloc>& lhs, const small_map<Key, T, N, Compare, Alloc>& rhs)
+	{
+		return (lhs.size() == rhs.size() && ft::equal(lhs.begin(), lhs.end(), rhs.begin()));
+	}
+
+	template <class Key, class T, size_t N, class Compare, class Alloc>
+	bool operator!=(const small_map<Key, T, N, Compare, Alloc>& lhs, const small_map<Key, T, N, Compare, Alloc>& rhs)
+	{
+		return (!(lhs == rhs));
+	}
+
+	template <class Key, class T, size_t N, class Compare, class Alloc>
+	bool operator<(const small_map<Key, T, N, Compare, Alloc>& lhs, const small_map<Key, T, N, Compare, Alloc>& rhs)
+	{
+		return (ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()));
+	}
+
+	template <class Key, class T, size_t N, class Compare, class Alloc>
+	bool operator<=(const small_map<Key, T, N, Compare, Alloc>& lhs, const small_map<Key, T, N, Compare, Alloc>& rhs)
+	{
+		return (!(rhs < lhs));
+	}
+
+	template <class Key, class T, size_t N, class Compare, class Alloc>
+	bool operator>(const small_map<Key, T, N, Compare, Alloc>& lhs, const small_map<Key, T, N, Compare, Alloc>& rhs)
+	{
+		return (rhs < lhs);
+	}
+
+	template <class Key, class T, size_t N, class Compare, class Alloc>
+	bool operator>=(const small_map<Key, T, N, Compare, Alloc>& lhs, const small_map<Key, T, N, Compare, Alloc>& rhs)
+	{
+		return (!(lhs < rhs));
+	}
+
+	template <class Key, class T, size_t N, class Compare, class Alloc>
+	void swap(small_map<Key, T, N, Compare, Alloc>& x, small_map<Key, T, N, Compare, Alloc>& y)
+	{
+		x.swap(y);
+	}
+}
+
+#endif
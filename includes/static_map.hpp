@@ -0,0 +1,335 @@
+#ifndef STATIC_MAP_HPP
+# define STATIC_MAP_HPP
+
+#include "utils.hpp"
+
+#ifdef FT_CXX14
+
+#include <cstddef>
+#include <stdexcept>
+
+namespace ft
+{
+	// orders C strings by content, usable at compile time: the comparison for static_map
+	// and static_set keys that are string literals
+	struct cstr_less {
+		constexpr bool operator()(const char* x, const char* y) const
+		{
+			while (*x != '\0' && *x == *y)
+			{
+				++x;
+				++y;
+			}
+			return (static_cast<unsigned char>(*x) < static_cast<unsigned char>(*y));
+		}
+	};
+
+	template <typename T>
+	constexpr void static_swap(T& a, T& b)
+	{
+		T tmp = a;
+		a = b;
+		b = tmp;
+	}
+
+	// moves items[i] down the max-heap items[0, n)
+	template <typename T, typename KeyOf, typename Compare>
+	constexpr void static_sift_down(T* items, size_t i, size_t n, KeyOf key_of, Compare comp)
+	{
+		while (2 * i + 1 < n)
+		{
+			size_t c = 2 * i + 1;
+			if (c + 1 < n && comp(key_of(items[c]), key_of(items[c + 1])))
+				++c;
+			if (!comp(key_of(items[i]), key_of(items[c])))
+				return ;
+			ft::static_swap(items[i], items[c]);
+			i = c;
+		}
+	}
+
+	// sorts items[0, n) by key_of(item) at compile time (heapsort, so large tables stay
+	// within the compiler's constexpr step limit) and refuses equal keys, which in a
+	// constant expression is a compile error
+	template <typename T, typename KeyOf, typename Compare>
+	constexpr void static_sort(T* items, size_t n, KeyOf key_of, Compare comp)
+	{
+		for (size_t i = n / 2; i-- > 0;)
+			ft::static_sift_down(items, i, n, key_of, comp);
+		for (size_t end = n; end-- > 1;)
+		{
+			ft::static_swap(items[0], items[end]);
+			ft::static_sift_down(items, 0, end, key_of, comp);
+		}
+		for (size_t i = 1; i < n; ++i)
+		{
+			if (!comp(key_of(items[i - 1]), key_of(items[i])))
+				throw std::logic_error("ft::static_map: duplicate key");
+		}
+	}
+
+	// first of items[0, n), sorted by key_of, whose key is not less than k: a binary
+	// search whose steps compile to conditional moves, with no branch to mispredict
+	template <typename T, typename KeyOf, typename Compare, typename Key>
+	constexpr const T* static_lower_bound(const T* items, size_t n, KeyOf key_of, Compare comp, const Key& k)
+	{
+		if (n == 0)
+			return (items);
+		while (n > 1)
+		{
+			size_t half = n / 2;
+			items = (comp(key_of(items[half]), k) ? items + half : items);
+			n -= half;
+		}
+		return (items + comp(key_of(*items), k));
+	}
+
+	struct static_first {
+		template <typename P>
+		constexpr const typename P::first_type& operator()(const P& p) const
+		{
+			return (p.first);
+		}
+	};
+
+	struct static_self {
+		template <typename K>
+		constexpr const K& operator()(const K& k) const
+		{
+			return (k);
+		}
+	};
+
+	// read-only map of N entries fixed when it is built, in a constexpr sorted array: built
+	// by make_static_map from a list of pairs in any order, at compile time when declared
+	// constexpr, so it costs no allocation and no startup work, and its lookups can run
+	// in constant expressions too. The lookup interface is map's; keys are not const in
+	// value_type, as the entries are sorted in place, but only const access is given.
+	template <class Key, class T, size_t N, class Compare = ft::less<Key> >
+	class static_map {
+		public :
+			typedef Key	key_type;
+			typedef T	mapped_type;
+			typedef ft::pair<Key, T>	value_type;
+			typedef Compare	key_compare;
+			typedef const value_type&	reference;
+			typedef const value_type&	const_reference;
+			typedef const value_type*	pointer;
+			typedef const value_type*	const_pointer;
+			typedef const value_type*	iterator;
+			typedef const value_type*	const_iterator;
+			typedef ft::reverse_iterator<const_iterator>	reverse_iterator;
+			typedef ft::reverse_iterator<const_iterator>	const_reverse_iterator;
+			typedef ptrdiff_t	difference_type;
+			typedef size_t		size_type;
+
+		private:
+			value_type	_items[N == 0 ? 1 : N];
+			key_compare	_comp;
+
+		public:
+			constexpr static_map(const value_type* items, const key_compare& comp = key_compare()) : _items(), _comp(comp)
+			{
+				for (size_t i = 0; i < N; ++i)
+					this->_items[i] = items[i];
+				ft::static_sort(this->_items, N, static_first(), this->_comp);
+			}
+
+			constexpr const_iterator begin() const
+			{
+				return (this->_items);
+			}
+
+			constexpr const_iterator end() const
+			{
+				return (this->_items + N);
+			}
+
+			const_reverse_iterator rbegin() const
+			{
+				return (const_reverse_iterator(end()));
+			}
+
+			const_reverse_iterator rend() const
+			{
+				return (const_reverse_iterator(begin()));
+			}
+
+			constexpr bool empty() const
+			{
+				return (N == 0);
+			}
+
+			constexpr size_type size() const
+			{
+				return (N);
+			}
+
+			constexpr size_type max_size() const
+			{
+				return (N);
+			}
+
+			constexpr key_compare key_comp() const
+			{
+				return (this->_comp);
+			}
+
+			constexpr const_iterator find(const key_type& k) const
+			{
+				const_iterator it = lower_bound(k);
+				return ((it == end() || this->_comp(k, it->first)) ? end() : it);
+			}
+
+			constexpr size_type count(const key_type& k) const
+			{
+				return (find(k) != end());
+			}
+
+			// throws std::out_of_range for a missing key, like vector::at for an index
+			constexpr const mapped_type& at(const key_type& k) const
+			{
+				const_iterator it = find(k);
+				if (it == end())
+					throw std::out_of_range("Error: ft::static_map::at");
+				return (it->second);
+			}
+
+			constexpr const_iterator lower_bound(const key_type& k) const
+			{
+				return (ft::static_lower_bound(this->_items, N, static_first(), this->_comp, k));
+			}
+
+			constexpr const_iterator upper_bound(const key_type& k) const
+			{
+				const_iterator it = lower_bound(k);
+				return ((it != end() && !this->_comp(k, it->first)) ? it + 1 : it);
+			}
+
+			constexpr ft::pair<const_iterator, const_iterator> equal_range(const key_type& k) const
+			{
+				return (ft::pair<const_iterator, const_iterator>(lower_bound(k), upper_bound(k)));
+			}
+	};
+
+	// read-only set counterpart of static_map
+	template <class Key, size_t N, class Compare = ft::less<Key> >
+	class static_set {
+		public :
+			typedef Key	key_type;
+			typedef Key	value_type;
+			typedef Compare	key_compare;
+			typedef Compare	value_compare;
+			typedef const value_type&	reference;
+			typedef const value_type&	const_reference;
+			typedef const value_type*	pointer;
+			typedef const value_type*	const_pointer;
+			typedef const value_type*	iterator;
+			typedef const value_type*	const_iterator;
+			typedef ft::reverse_iterator<const_iterator>	reverse_iterator;
+			typedef ft::reverse_iterator<const_iterator>	const_reverse_iterator;
+			typedef ptrdiff_t	difference_type;
+			typedef size_t		size_type;
+
+		private:
+			value_type	_items[N == 0 ? 1 : N];
+			key_compare	_comp;
+
+		public:
+			constexpr static_set(const value_type* items, const key_compare& comp = key_compare()) : _items(), _comp(comp)
+			{
+				for (size_t i = 0; i < N; ++i)
+					this->_items[i] = items[i];
+				ft::static_sort(this->_items, N, static_self(), this->_comp);
+			}
+
+			constexpr const_iterator begin() const
+			{
+				return (this->_items);
+			}
+
+			constexpr const_iterator end() const
+			{
+				return (this->_items + N);
+			}
+
+			const_reverse_iterator rbegin() const
+			{
+				return (const_reverse_iterator(end()));
+			}
+
+			const_reverse_iterator rend() const
+			{
+				return (const_reverse_iterator(begin()));
+			}
+
+			constexpr bool empty() const
+			{
+				return (N == 0);
+			}
+
+			constexpr size_type size() const
+			{
+				return (N);
+			}
+
+			constexpr size_type max_size() const
+			{
+				return (N);
+			}
+
+			constexpr key_compare key_comp() const
+			{
+				return (this->_comp);
+			}
+
+			constexpr value_compare value_comp() const
+			{
+				return (this->_comp);
+			}
+
+			constexpr const_iterator find(const key_type& k) const
+			{
+				const_iterator it = lower_bound(k);
+				return ((it == end() || this->_comp(k, *it)) ? end() : it);
+			}
+
+			constexpr size_type count(const key_type& k) const
+			{
+				return (find(k) != end());
+			}
+
+			constexpr const_iterator lower_bound(const key_type& k) const
+			{
+				return (ft::static_lower_bound(this->_items, N, static_self(), this->_comp, k));
+			}
+
+			constexpr const_iterator upper_bound(const key_type& k) const
+			{
+				const_iterator it = lower_bound(k);
+				return ((it != end() && !this->_comp(k, *it)) ? it + 1 : it);
+			}
+
+			constexpr ft::pair<const_iterator, const_iterator> equal_range(const key_type& k) const
+			{
+				return (ft::pair<const_iterator, const_iterator>(lower_bound(k), upper_bound(k)));
+			}
+	};
+
+	// constexpr auto codes = ft::make_static_map<int, const char*>({ { 404, "Not Found" }, { 200, "OK" } });
+	template <class Key, class T, class Compare = ft::less<Key>, size_t N>
+	constexpr static_map<Key, T, N, Compare> make_static_map(const ft::pair<Key, T> (&items)[N], const Compare& comp = Compare())
+	{
+		return (static_map<Key, T, N, Compare>(items, comp));
+	}
+
+	template <class Key, class Compare = ft::less<Key>, size_t N>
+	constexpr static_set<Key, N, Compare> make_static_set(const Key (&items)[N], const Compare& comp = Compare())
+	{
+		return (static_set<Key, N, Compare>(items, comp));
+	}
+}
+
+#endif
+
+#endif
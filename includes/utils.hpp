@@ -1,8 +1,24 @@
 #ifndef UTILS_HPP
 # define UTILS_HPP
 
+#include <string>
 #include "iterator.hpp"
 
+// C++11 and later builds (make CXXSTD=c++11) add move and emplace overloads
+# if __cplusplus >= 201103L
+#  define FT_CXX11 1
+#  include <utility>
+# endif
+
+// C++14 and later builds (make CXXSTD=c++14) add ft::static_map and ft::static_set, which
+// need pairs and comparisons usable in constant expressions
+# if __cplusplus >= 201402L
+#  define FT_CXX14 1
+#  define FT_CONSTEXPR constexpr
+# else
+#  define FT_CONSTEXPR
+# endif
+
 
 namespace ft
 {
@@ -79,6 +95,24 @@ namespace ft
 	template <typename T>
 	struct is_integral : public is_integral_type<T> {};
 
+	typedef integral_traits<true, bool>	true_type;
+	typedef integral_traits<false, bool>	false_type;
+
+	template <typename>
+	struct is_floating_point_type : public false_type {};
+
+	template <>
+	struct is_floating_point_type<float> : public true_type {};
+
+	template <>
+	struct is_floating_point_type<double> : public true_type {};
+
+	template <>
+	struct is_floating_point_type<long double> : public true_type {};
+
+	template <typename T>
+	struct is_arithmetic : public integral_traits<is_integral<T>::value || is_floating_point_type<T>::value, bool> {};
+
 	template <class InputIterator1, class InputIterator2>
 	bool equal (InputIterator1 first1, InputIterator1 last1, InputIterator2 first2)
 	{
@@ -151,10 +185,10 @@ namespace ft
 			first_type first;
 			second_type second;
 
-			pair() : first(), second() {}
+			FT_CONSTEXPR pair() : first(), second() {}
 			template<class U, class V> pair (const pair<U, V>& pr) : first(pr.first), second(pr.second) {}
-			pair(const first_type& a, const second_type& b) : first(a), second(b) {}
-			pair& operator= (const pair& pr)
+			FT_CONSTEXPR pair(const first_type& a, const second_type& b) : first(a), second(b) {}
+			FT_CONSTEXPR pair& operator= (const pair& pr)
 			{
 				if (this != &pr)
 				{
@@ -163,13 +197,29 @@ namespace ft
 				}
 				return (*this);
 			}
+#ifdef FT_CXX11
+			pair(const pair&) = default;
+			pair(pair&&) = default;
+			template<class U, class V> pair (pair<U, V>&& pr) : first(std::forward<U>(pr.first)), second(std::forward<V>(pr.second)) {}
+			template<class U, class V> FT_CONSTEXPR pair(U&& a, V&& b) : first(std::forward<U>(a)), second(std::forward<V>(b)) {}
+			FT_CONSTEXPR pair& operator= (pair&& pr)
+			{
+				this->first = std::move(pr.first);
+				this->second = std::move(pr.second);
+				return (*this);
+			}
+#endif
 	};
 
 
 	template <class T1, class T2>
 	pair<T1, T2> make_pair(T1 x, T2 y)
 	{
+#ifdef FT_CXX11
+		return (pair<T1, T2>(std::move(x), std::move(y)));
+#else
 		return (pair<T1, T2>(x,y));
+#endif
 	};
 
 	template <class T1, class T2>
@@ -221,11 +271,154 @@ namespace ft
 	template <class T>
 	struct less : binary_function<T, T, bool>
 	{
-		bool operator()(const T& x, const T& y) const
+		// arithmetic keys get a branch-free three-way compare, see is_three_way
+		typedef ft::is_arithmetic<T>	is_three_way;
+
+		FT_CONSTEXPR bool operator()(const T& x, const T& y) const
 		{
 			return (x < y);
 		}
+
+		int compare(const T& x, const T& y) const
+		{
+			return ((y < x) - (x < y));
+		}
 	};
+
+
+	template <class Compare>
+	struct has_three_way_typedef
+	{
+		template <class U>
+		static char test(typename U::is_three_way*);
+		template <class U>
+		static long test(...);
+
+		static const bool value = (sizeof(test<Compare>(NULL)) == sizeof(char));
+	};
+
+	// a comparator is three-way when it defines is_three_way as a true trait and
+	// int compare(x, y) returning <0, 0 or >0; RBTree then compares once per level
+	template <class Compare, bool = has_three_way_typedef<Compare>::value>
+	struct is_three_way : public false_type {};
+
+	template <class Compare>
+	struct is_three_way<Compare, true> : public integral_traits<Compare::is_three_way::value, bool> {};
+
+
+	// turns a less-style comparator into a three-way one
+	template <class Compare>
+	struct three_way : public Compare
+	{
+		typedef true_type	is_three_way;
+
+		three_way() : Compare() {}
+		three_way(const Compare& comp) : Compare(comp) {}
+
+		template <class T>
+		int compare(const T& x, const T& y) const
+		{
+			if ((*this)(x, y))
+				return (-1);
+			return ((*this)(y, x) ? 1 : 0);
+		}
+	};
+
+	template <>
+	struct three_way< less<std::string> > : public less<std::string>
+	{
+		typedef true_type	is_three_way;
+
+		int compare(const std::string& x, const std::string& y) const
+		{
+			return (x.compare(y));
+		}
+	};
+
+	// key hash used by the opt-in lookup caches: integral values and pointers hash to
+	// themselves (the cache scrambles the bits), strings use FNV-1a. Other keys all hash
+	// to 0 and share one cache slot until ft::hash is specialized for them.
+	template <class T, bool = is_integral<T>::value>
+	struct hash
+	{
+		size_t operator()(const T&) const
+		{
+			return (0);
+		}
+	};
+
+	template <class T>
+	struct hash<T, true>
+	{
+		size_t operator()(const T& x) const
+		{
+			return (static_cast<size_t>(x));
+		}
+	};
+
+	template <class T>
+	struct hash<T*, false>
+	{
+		size_t operator()(T* x) const
+		{
+			return (reinterpret_cast<size_t>(x));
+		}
+	};
+
+	template <>
+	struct hash<std::string, false>
+	{
+		size_t operator()(const std::string& x) const
+		{
+			size_t res = static_cast<size_t>(2166136261u);
+			for (std::string::size_type i = 0; i < x.size(); ++i)
+			{
+				res ^= static_cast<unsigned char>(x[i]);
+				res *= static_cast<size_t>(16777619u);
+			}
+			return (res);
+		}
+	};
+
+	// whether ft::hash spreads T out rather than sending it to 0; specialize it to true
+	// along with ft::hash for a key type of your own
+	template <class T>
+	struct is_hashed : public integral_traits<is_integral<T>::value, bool> {};
+
+	template <class T>
+	struct is_hashed<T*> : public true_type {};
+
+	template <>
+	struct is_hashed<std::string> : public true_type {};
+
+	// ft::hash for the hash tables, where a key hashing to 0 makes every lookup a scan
+	// of one chain: the primary is only declared, so such keys do not compile and need
+	// a Hash of their own. FindCache keeps ft::hash, a collision only costs it a miss.
+	template <class T, bool = is_hashed<T>::value>
+	struct checked_hash;
+
+	template <class T>
+	struct checked_hash<T, true> : public hash<T> {};
+
+	// loads and stores of a word that lookups through a const container write (caches,
+	// statistics), so that concurrent readers do not race: no ordering, plain moves on
+	// most targets, and an increment made of the two may be lost to another reader's
+	template <class T>
+	inline T relaxed_load(const T& x)
+	{
+		return (__atomic_load_n(&x, __ATOMIC_RELAXED));
+	}
+
+	template <class T>
+	inline void relaxed_store(T& x, T val)
+	{
+		__atomic_store_n(&x, val, __ATOMIC_RELAXED);
+	}
+
+	inline void relaxed_increment(size_t& x)
+	{
+		relaxed_store(x, relaxed_load(x) + 1);
+	}
 }
 
 #endif
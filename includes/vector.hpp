@@ -5,11 +5,12 @@
 #include <stdexcept>
 #include "VectorIterator.hpp"
 #include "utils.hpp"
+#include "HotCounters.hpp"
 
 namespace ft
 {
 	template < typename T, typename Allocator = std::allocator<T> >
-	class vector
+	class vector : private ft::DefaultCountingPolicy
 	{
 		public:
 
@@ -34,6 +35,8 @@ namespace ft
 
 		public:
 
+			using ft::DefaultCountingPolicy::hot_counters;
+			using ft::DefaultCountingPolicy::reset_hot_counters;
 
 		explicit vector(const allocator_type &alloc = allocator_type())
 		: _alloc(alloc), _start(NULL), _end(NULL), _end_of_capacity(NULL){}
@@ -169,6 +172,8 @@ namespace ft
 				pointer prev_end = this->_end;
 				pointer prev_end_of_capacity = this->_end_of_capacity;
 
+				this->count_reallocation();
+				this->count_copy(prev_end - prev_start);
 				this->_start = this->_alloc.allocate(n);
 				this->_end = this->_start;
 				this->_end_of_capacity = this->_start + n;
@@ -241,6 +246,7 @@ namespace ft
 				pointer prev_start = this->_start;
 				pointer prev_end_of_capacity = this->_end_of_capacity;
 
+				this->count_reallocation();
 				this->_start = this->_alloc.allocate(n);
 				this->_end = this->_start;
 				this->_end_of_capacity = this->_start + n;
@@ -264,6 +270,7 @@ namespace ft
 				pointer prev_start = this->_start;
 				pointer prev_end_of_capacity = this->_end_of_capacity;
 
+				this->count_reallocation();
 				this->_start = this->_alloc.allocate(n);
 				this->_end = this->_start;
 				this->_end_of_capacity = this->_start + n;
@@ -304,6 +311,7 @@ namespace ft
 			{
 				pointer val_tmp = this->_end;
 				size_type range = this->_end - &(*position);
+				this->count_copy(range);
 				this->_end += n;
 				pointer tmp = this->_end;
 				while (range--)
@@ -317,6 +325,8 @@ namespace ft
 				size_type _size = n + this->size();
 				size_type front_tmp = &(*position) - this->_start;
 				size_type back_tmp = _end - &(*position);
+				this->count_reallocation();
+				this->count_copy(front_tmp + back_tmp);
 				this->_start = _alloc.allocate(_size);
 				this->_end = _start;
 				this->_end_of_capacity = this->_start + _size;
@@ -344,6 +354,7 @@ namespace ft
 			{
 				pointer val_tmp = this->_end;
 				size_type range = this->_end - &(*position);
+				this->count_copy(range);
 				this->_end += n;
 				pointer tmp = this->_end;
 				while (range--)
@@ -357,6 +368,8 @@ namespace ft
 				size_type _size = n + this->size();
 				size_type front_tmp = &(*position) - this->_start;
 				size_type back_tmp = this->_end - &(*position);
+				this->count_reallocation();
+				this->count_copy(front_tmp + back_tmp);
 				this->_start = this->_alloc.allocate(_size);
 				this->_end = this->_start;
 				this->_end_of_capacity = this->_start + _size;
@@ -380,6 +393,7 @@ namespace ft
 			this->_alloc.destroy(&(*position));
 			size_type n = this->_end - &(*position) - 1;
 			pointer tmp = &(*position);
+			this->count_copy(n);
 
 			while (n--)
 			{
@@ -398,6 +412,7 @@ namespace ft
 			size_type n = this->_end - &(*last);
 			size_type range = ft::distance(first, last);
 			tmp = &(*first);
+			this->count_copy(n);
 			while (n--)
 			{
 				_alloc.construct(tmp, *last++);
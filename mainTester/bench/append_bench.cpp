@@ -0,0 +1,67 @@
+#include "map.hpp"
+#include <cstdlib>
+#include <iostream>
+#include <sys/time.h>
+
+// time-series ingestion: N strictly increasing keys inserted into ft::map, plain, with an
+// end() hint and with operator[], against the same keys inserted in decreasing order
+// (the mirror image, which still descends from the root every time) and in random
+// order. Wall-clock time; N is the first argument (default 2M).
+
+double now_ms()
+{
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+	return (tv.tv_sec * 1000.0 + tv.tv_usec / 1000.0);
+}
+
+void report(const char* label, const ft::map<long, int>& mp, size_t n, double start)
+{
+	double ms = now_ms() - start;
+	std::cout << label << "\t" << ms << " ms\t(" << static_cast<long>(n / ms * 1000) << " inserts/s, " << mp.size() << " keys, last "
+		<< mp.rbegin()->first << ")" << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+	size_t n = (argc > 1 ? static_cast<size_t>(std::atol(argv[1])) : 2000000);
+	long base = 1700000000000L;
+	std::cout << n << " keys" << std::endl;
+	{
+		ft::map<long, int> mp;
+		double start = now_ms();
+		for (size_t i = 0; i < n; ++i)
+			mp.insert(ft::make_pair(base + static_cast<long>(i) * 3, static_cast<int>(i)));
+		report("increasing, insert\t", mp, n, start);
+	}
+	{
+		ft::map<long, int> mp;
+		double start = now_ms();
+		for (size_t i = 0; i < n; ++i)
+			mp.insert(mp.end(), ft::make_pair(base + static_cast<long>(i) * 3, static_cast<int>(i)));
+		report("increasing, end() hint", mp, n, start);
+	}
+	{
+		ft::map<long, int> mp;
+		double start = now_ms();
+		for (size_t i = 0; i < n; ++i)
+			mp[base + static_cast<long>(i) * 3] = static_cast<int>(i);
+		report("increasing, operator[]", mp, n, start);
+	}
+	{
+		ft::map<long, int> mp;
+		double start = now_ms();
+		for (size_t i = n; i > 0; --i)
+			mp.insert(ft::make_pair(base + static_cast<long>(i - 1) * 3, static_cast<int>(i)));
+		report("decreasing, insert\t", mp, n, start);
+	}
+	{
+		ft::map<long, int> mp;
+		srand(42);
+		double start = now_ms();
+		for (size_t i = 0; i < n; ++i)
+			mp.insert(ft::make_pair(base + static_cast<long>(rand() % (n * 3)), static_cast<int>(i)));
+		report("random, insert\t\t", mp, n, start);
+	}
+	return (0);
+}
@@ -0,0 +1,86 @@
+#include "map.hpp"
+#include <ctime>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// read/write mix matrix per balancing policy: every row runs the same random key stream,
+// a write is an insert or an erase half the time each; height is printed after the run.
+// Rows run in forked children so no policy inherits the heap left by the previous one.
+
+#define N 200000
+#define OPS 2000000
+
+struct Op {
+	int	kind;	// 0 find, 1 insert, 2 erase
+	int	key;
+};
+
+std::vector<Op> make_ops(int read_percent, unsigned int seed)
+{
+	std::vector<Op> ops;
+	srand(seed);
+	for (int i = 0; i < OPS; ++i)
+	{
+		Op op;
+		op.key = rand() % (N * 2);
+		if (rand() % 100 < read_percent)
+			op.kind = 0;
+		else
+			op.kind = 1 + rand() % 2;
+		ops.push_back(op);
+	}
+	return (ops);
+}
+
+template <typename Map>
+void run(const char* name, const std::vector<Op>& ops)
+{
+	pid_t pid = fork();
+	if (pid != 0)
+	{
+		waitpid(pid, NULL, 0);
+		return ;
+	}
+	Map mp;
+	srand(1);
+	for (int i = 0; i < N; ++i)
+		mp.insert(ft::make_pair(rand() % (N * 2), i));
+
+	clock_t start = clock();
+	size_t found = 0;
+	for (size_t i = 0; i < ops.size(); ++i)
+	{
+		if (ops[i].kind == 0)
+			found += (mp.find(ops[i].key) != mp.end());
+		else if (ops[i].kind == 1)
+			mp.insert(ft::make_pair(ops[i].key, 0));
+		else
+			mp.erase(ops[i].key);
+	}
+	double ms = static_cast<double>(clock() - start) * 1000 / CLOCKS_PER_SEC;
+	ft::RBTreeStats stats = mp.tree_stats();
+
+	std::cout << name << "\t" << ms << " ms\t" << (ms * 1e6 / ops.size()) << " ns/op"
+		<< "\theight " << stats.height << "\tavg depth " << stats.average_depth
+		<< "\t(hits " << found << ")" << std::endl;
+	_exit(0);
+}
+
+typedef std::allocator< ft::pair<const int, int> >	alloc_type;
+
+int main()
+{
+	const int mixes[] = { 100, 95, 80, 50, 20, 0 };
+	for (size_t m = 0; m < sizeof(mixes) / sizeof(mixes[0]); ++m)
+	{
+		std::vector<Op> ops = make_ops(mixes[m], 42);
+		std::cout << "=== " << mixes[m] << "% reads ===" << std::endl;
+		run< ft::map<int, int, ft::less<int>, alloc_type, ft::RBBalance> >("red-black      ", ops);
+		run< ft::map<int, int, ft::less<int>, alloc_type, ft::AVLBalance> >("avl            ", ops);
+		run< ft::map<int, int, ft::less<int>, alloc_type, ft::WBBalance> >("weight-balanced", ops);
+	}
+	return (0);
+}
@@ -0,0 +1,86 @@
+#include "map.hpp"
+#include "set.hpp"
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+#include <sys/time.h>
+
+// set::count and map::find at hit ratios from 0% to 100%, without and with the Bloom
+// filter (10 counters per key, sized for the set). N keys, the first argument (default
+// 1M), 4M lookups per row; keys are even, misses odd.
+
+double now_ms()
+{
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+	return (tv.tv_sec * 1000.0 + tv.tv_usec / 1000.0);
+}
+
+std::vector<int> lookups(const std::vector<int>& keys, int hit_percent)
+{
+	std::vector<int> res;
+	for (int i = 0; i < 4000000; ++i)
+	{
+		int k = keys[static_cast<size_t>(rand()) % keys.size()];
+		res.push_back(rand() % 100 < hit_percent ? k : k + 1);
+	}
+	return (res);
+}
+
+template <typename Set>
+double count_ms(const Set& st, const std::vector<int>& keys, size_t& found)
+{
+	double start = now_ms();
+	found = 0;
+	for (size_t i = 0; i < keys.size(); ++i)
+		found += st.count(keys[i]);
+	return (now_ms() - start);
+}
+
+template <typename Map>
+double find_ms(const Map& mp, const std::vector<int>& keys, size_t& found)
+{
+	double start = now_ms();
+	found = 0;
+	for (size_t i = 0; i < keys.size(); ++i)
+		found += (mp.find(keys[i]) != mp.end());
+	return (now_ms() - start);
+}
+
+int main(int argc, char** argv)
+{
+	int n = (argc > 1 ? std::atoi(argv[1]) : 1000000);
+	std::vector<int> keys;
+	srand(42);
+	ft::set<int> plain_set;
+	ft::set<int> bloom_set;
+	ft::map<int, int> plain_map;
+	ft::map<int, int> bloom_map;
+	bloom_set.enable_bloom_filter(n);
+	bloom_map.enable_bloom_filter(n);
+	for (int i = 0; i < n; ++i)
+	{
+		keys.push_back((rand() % 1000000000) * 2);
+		plain_set.insert(keys.back());
+		bloom_set.insert(keys.back());
+		plain_map.insert(ft::make_pair(keys.back(), i));
+		bloom_map.insert(ft::make_pair(keys.back(), i));
+	}
+	std::cout << plain_set.size() << " keys, 4M lookups per row" << std::endl;
+	int hits[] = { 0, 10, 50, 90, 100 };
+	for (size_t h = 0; h < sizeof(hits) / sizeof(hits[0]); ++h)
+	{
+		std::vector<int> probes = lookups(keys, hits[h]);
+		size_t found[4];
+		double plain_count = count_ms(plain_set, probes, found[0]);
+		double bloom_count = count_ms(bloom_set, probes, found[1]);
+		double plain_find = find_ms(plain_map, probes, found[2]);
+		double bloom_find = find_ms(bloom_map, probes, found[3]);
+		std::cout << hits[h] << "% hits\tset::count " << plain_count << " ms, filtered " << bloom_count << " ms (x"
+			<< plain_count / bloom_count << ")\tmap::find " << plain_find << " ms, filtered " << bloom_find << " ms (x"
+			<< plain_find / bloom_find << ")\t(" << found[0] << "/" << found[1] << "/" << found[2] << "/" << found[3] << ")" << std::endl;
+	}
+	std::cout << "false positives: " << 100.0 - 100.0 * bloom_set.bloom_rejections() / (4000000.0 * (100 + 90 + 50 + 10) / 100)
+		<< "% of misses" << std::endl;
+	return (0);
+}
@@ -0,0 +1,65 @@
+#include "buffered_map.hpp"
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+#include <sys/time.h>
+
+// ingestion: N random-key inserts into ft::map against buffered_map at a few buffer
+// sizes, final flush included, then 1M lookups on the result. Wall-clock time; N is the
+// first argument (default 2M).
+
+double now_ms()
+{
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+	return (tv.tv_sec * 1000.0 + tv.tv_usec / 1000.0);
+}
+
+template <typename Map>
+size_t lookups(const Map& mp, const std::vector<int>& keys)
+{
+	size_t found = 0;
+	for (size_t i = 0; i < 1000000; ++i)
+		found += mp.count(keys[(i * 7919) % keys.size()] + static_cast<int>(i % 2));
+	return (found);
+}
+
+template <typename Map>
+void report(const char* label, Map& mp, const std::vector<int>& keys, double start)
+{
+	double ingest = now_ms() - start;
+	start = now_ms();
+	size_t found = lookups(mp, keys);
+	std::cout << label << "\tinsert " << ingest << " ms (" << static_cast<long>(keys.size() / ingest * 1000) << "/s)\tlookups "
+		<< now_ms() - start << " ms\t(" << mp.size() << " keys, hits " << found << ")" << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+	size_t n = (argc > 1 ? static_cast<size_t>(std::atol(argv[1])) : 2000000);
+	std::vector<int> keys;
+	srand(42);
+	for (size_t i = 0; i < n; ++i)
+		keys.push_back((rand() % 1000000000) * 2);
+	std::cout << n << " random inserts" << std::endl;
+
+	{
+		double start = now_ms();
+		ft::map<int, int> mp;
+		for (size_t i = 0; i < n; ++i)
+			mp.insert(ft::make_pair(keys[i], static_cast<int>(i)));
+		report("ft::map\t\t", mp, keys, start);
+	}
+	size_t sizes[] = { 4096, 65536, 262144 };
+	for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s)
+	{
+		double start = now_ms();
+		ft::buffered_map<int, int> mp(sizes[s]);
+		for (size_t i = 0; i < n; ++i)
+			mp.insert(ft::make_pair(keys[i], static_cast<int>(i)));
+		mp.flush();
+		std::cout << "buffer " << sizes[s];
+		report("\t", mp, keys, start);
+	}
+	return (0);
+}
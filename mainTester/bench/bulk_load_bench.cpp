@@ -0,0 +1,46 @@
+#include "map.hpp"
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+#include <sys/time.h>
+
+// building a map from unsorted pairs: insert(first, last) against bulk_load at 1, 2, 4, ...
+// threads up to the core count; wall-clock time. The input size is the first argument
+// (default 5M, about 10% duplicate keys).
+
+double now_ms()
+{
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+	return (tv.tv_sec * 1000.0 + tv.tv_usec / 1000.0);
+}
+
+int main(int argc, char** argv)
+{
+	size_t n = (argc > 1 ? static_cast<size_t>(std::atol(argv[1])) : 5000000);
+	std::vector< ft::pair<int, int> > input;
+	srand(42);
+	for (size_t i = 0; i < n; ++i)
+		input.push_back(ft::make_pair(static_cast<int>((static_cast<size_t>(rand()) * 7919) % (n * 10 / 9 + 1)), static_cast<int>(i)));
+	unsigned int cores = ft::hardware_threads();
+	std::cout << n << " pairs, " << cores << " cores" << std::endl;
+
+	double base;
+	{
+		ft::map<int, int> mp;
+		double start = now_ms();
+		mp.insert(input.begin(), input.end());
+		base = now_ms() - start;
+		std::cout << "insert(first, last)\t" << base << " ms\t(" << mp.size() << " keys, height " << mp.tree_stats().height << ")" << std::endl;
+	}
+	for (unsigned int threads = 1; threads <= cores || threads == 1; threads *= 2)
+	{
+		ft::map<int, int> mp;
+		double start = now_ms();
+		mp.bulk_load(input.begin(), input.end(), threads);
+		double ms = now_ms() - start;
+		std::cout << "bulk_load " << threads << " threads\t" << ms << " ms (x" << base / ms << ")\t(" << mp.size()
+			<< " keys, height " << mp.tree_stats().height << ")" << std::endl;
+	}
+	return (0);
+}
@@ -0,0 +1,80 @@
+#include "map.hpp"
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+#include <sys/time.h>
+
+// periodic checkpoints of a large map: each round writes or erases a share of the keys at
+// random and then copies the records to save into a buffer, every element (what a
+// snapshot writer must do without change tracking) or what changes_since() reports since
+// the last checkpoint. Then the cost of tracking itself, random operator[] writes with
+// it off and on. The map size is the first argument (default 2M).
+
+double now_ms()
+{
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+	return (tv.tv_sec * 1000.0 + tv.tv_usec / 1000.0);
+}
+
+int main(int argc, char** argv)
+{
+	int n = (argc > 1 ? std::atoi(argv[1]) : 2000000);
+	ft::map<int, int> mp;
+	srand(42);
+	for (int i = 0; i < n; ++i)
+		mp[i * 2] = i;
+	mp.enable_change_tracking();
+	unsigned long version = mp.checkpoint();
+	std::cout << mp.size() << " keys" << std::endl;
+
+	std::vector< std::pair<int, int> > out;
+	double shares[] = { 0.0001, 0.001, 0.01, 0.1 };
+	for (size_t s = 0; s < sizeof(shares) / sizeof(shares[0]); ++s)
+	{
+		int changes = static_cast<int>(n * shares[s]);
+		for (int i = 0; i < changes; ++i)
+		{
+			int k = rand() % (n * 2);
+			if (i % 4 == 0)
+				mp.erase(k);
+			else
+				mp[k] = i;
+		}
+		out.clear();
+		double start = now_ms();
+		for (ft::map<int, int>::const_iterator it = mp.begin(); it != mp.end(); ++it)
+			out.push_back(std::make_pair(it->first, it->second));
+		double scan = now_ms() - start;
+		size_t full = out.size();
+		out.clear();
+		start = now_ms();
+		std::vector<ft::map<int, int>::const_iterator> written;
+		std::vector<int> erased;
+		mp.changes_since(version, written, erased);
+		for (size_t i = 0; i < written.size(); ++i)
+			out.push_back(std::make_pair(written[i]->first, written[i]->second));
+		for (size_t i = 0; i < erased.size(); ++i)
+			out.push_back(std::make_pair(erased[i], -1));
+		double incremental = now_ms() - start;
+		unsigned long next = mp.checkpoint();
+		mp.forget_changes_before(next);
+		version = next;
+		std::cout << shares[s] * 100 << "% changed\tfull scan " << scan << " ms, changes_since " << incremental << " ms (x"
+			<< scan / incremental << ")\t(" << full << " records, " << written.size() << " written, " << erased.size() << " erased)"
+			<< std::endl;
+	}
+
+	std::vector<int> keys;
+	for (int i = 0; i < n; ++i)
+		keys.push_back(rand() % (n * 2));
+	for (int on = 0; on < 2; ++on)
+	{
+		mp.enable_change_tracking(on != 0);
+		double start = now_ms();
+		for (size_t i = 0; i < keys.size(); ++i)
+			mp[keys[i]] = static_cast<int>(i);
+		std::cout << "operator[] writes, tracking " << (on ? "on " : "off") << "\t" << now_ms() - start << " ms" << std::endl;
+	}
+	return (0);
+}
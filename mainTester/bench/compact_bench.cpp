@@ -0,0 +1,76 @@
+#include "map.hpp"
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+#include <sys/time.h>
+
+// a map churned by random inserts and erases until its nodes are scattered over the heap,
+// then a full scan and random finds before compaction, after compact_step in bounded
+// slices (with the longest slice), after compact(IN_ORDER) and after compact(VEB_ORDER).
+// The map size is the first argument (default 1M).
+
+double now_ms()
+{
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+	return (tv.tv_sec * 1000.0 + tv.tv_usec / 1000.0);
+}
+
+void measure(const char* label, const ft::map<int, long>& mp, const std::vector<int>& keys)
+{
+	double start = now_ms();
+	long sum = 0;
+	for (ft::map<int, long>::const_iterator it = mp.begin(); it != mp.end(); ++it)
+		sum += it->second;
+	double scan = now_ms() - start;
+	start = now_ms();
+	size_t found = 0;
+	for (size_t i = 0; i < keys.size(); ++i)
+		found += (mp.find(keys[i]) != mp.end());
+	double finds = now_ms() - start;
+	std::cout << label << "\tscan " << scan << " ms\t" << keys.size() << " finds " << finds << " ms\t(sum " << sum
+		<< ", hits " << found << ")" << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+	int n = (argc > 1 ? std::atoi(argv[1]) : 1000000);
+	ft::map<int, long> mp;
+	srand(42);
+	for (int i = 0; i < n; ++i)
+		mp[rand() % (n * 4)] = i;
+	for (int round = 0; round < 3 * n; ++round)
+	{
+		mp.erase(rand() % (n * 4));
+		mp[rand() % (n * 4)] = round;
+	}
+	std::vector<int> keys;
+	for (int i = 0; i < 1000000; ++i)
+		keys.push_back(rand() % (n * 4));
+	std::cout << mp.size() << " entries after churn" << std::endl;
+
+	measure("churned\t", mp, keys);
+
+	double longest = 0;
+	double start = now_ms();
+	for (size_t moved = 0; moved < mp.size(); moved += 4096)
+	{
+		double step = now_ms();
+		mp.compact_step(4096);
+		if (now_ms() - step > longest)
+			longest = now_ms() - step;
+	}
+	std::cout << "compact_step(4096) total " << now_ms() - start << " ms, longest slice " << longest << " ms" << std::endl;
+	measure("stepped\t", mp, keys);
+
+	start = now_ms();
+	mp.compact(ft::IN_ORDER);
+	std::cout << "compact(IN_ORDER) " << now_ms() - start << " ms" << std::endl;
+	measure("in order", mp, keys);
+
+	start = now_ms();
+	mp.compact(ft::VEB_ORDER);
+	std::cout << "compact(VEB_ORDER) " << now_ms() - start << " ms" << std::endl;
+	measure("vEB order", mp, keys);
+	return (0);
+}
@@ -0,0 +1,75 @@
+#include "map.hpp"
+#include <ctime>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// lookups per comparator flavour; build with CFLAGS+=-DFT_HOT_COUNTERS to also get
+// the comparator calls per lookup
+
+#define N 200000
+#define ROUNDS 5
+
+template <typename Key>
+Key make_key(int i);
+
+template <>
+int make_key<int>(int i) { return (i * 7919 % (N * 2)); }
+
+template <>
+std::string make_key<std::string>(int i)
+{
+	std::ostringstream os;
+	os << "user:session:" << (i * 7919 % (N * 2));
+	return (os.str());
+}
+
+template <typename Map>
+size_t comparisons(const Map& mp) { return (mp.hot_counters().comparisons); }
+
+template <typename K, typename V, typename C>
+size_t comparisons(const std::map<K, V, C>&) { return (0); }
+
+template <typename Map, typename Key>
+void run(const char* name, const std::vector<Key>& keys)
+{
+	Map mp;
+	for (size_t i = 0; i < keys.size(); i += 2)
+		mp.insert(typename Map::value_type(keys[i], static_cast<int>(i)));
+	size_t before = comparisons(mp);
+
+	clock_t start = clock();
+	size_t found = 0;
+	for (int r = 0; r < ROUNDS; ++r)
+		for (size_t i = 0; i < keys.size(); ++i)
+			found += (mp.find(keys[i]) != mp.end());
+	double ms = static_cast<double>(clock() - start) * 1000 / CLOCKS_PER_SEC;
+	size_t lookups = keys.size() * ROUNDS;
+
+	std::cout << name << "\t" << ms << " ms\t" << (ms * 1e6 / lookups) << " ns/find";
+	if (comparisons(mp) != before)
+		std::cout << "\t" << static_cast<double>(comparisons(mp) - before) / lookups << " cmp/find";
+	std::cout << "\t(hits " << found / ROUNDS << ")" << std::endl;
+}
+
+int main()
+{
+	std::vector<int> ikeys;
+	std::vector<std::string> skeys;
+	for (int i = 0; i < N; ++i)
+	{
+		ikeys.push_back(make_key<int>(i));
+		skeys.push_back(make_key<std::string>(i));
+	}
+	std::cout << "=== int keys, half hits ===" << std::endl;
+	run< ft::map<int, int> >("ft::less<int> (three-way, branch-free)", ikeys);
+	run< std::map<int, int> >("std::map", ikeys);
+	std::cout << "=== string keys, half hits ===" << std::endl;
+	run< ft::map<std::string, int> >("ft::less<string> (one less per level)", skeys);
+	run< ft::map<std::string, int, ft::three_way< ft::less<std::string> > > >("ft::three_way<ft::less<string>>", skeys);
+	run< std::map<std::string, int> >("std::map", skeys);
+	return (0);
+}
@@ -0,0 +1,86 @@
+#include "map.hpp"
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+#include <pthread.h>
+#include <sys/time.h>
+
+// fan-out: a map of N keys (first argument, default 1M) is copied by value into each of
+// 16 reader tasks run on pthreads, 4 at a time. Each reader does 10K lookups through a
+// const reference; in the "some write" rows one reader in four also writes once. Deep
+// copies against copy-on-write copies, wall-clock time including the copies.
+
+typedef ft::map<int, int> int_map;
+
+double now_ms()
+{
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+	return (tv.tv_sec * 1000.0 + tv.tv_usec / 1000.0);
+}
+
+struct Task {
+	const int_map*	source;
+	int				id;
+	bool			writes;
+	long			sum;
+};
+
+void* reader(void* arg)
+{
+	Task* task = static_cast<Task*>(arg);
+	int_map copy(*task->source);
+	const int_map& view = copy;
+	long sum = 0;
+	int n = static_cast<int>(view.size());
+	for (int i = 0; i < 10000; ++i)
+	{
+		int_map::const_iterator it = view.find((i * 7919 + task->id) % (n * 2));
+		if (it != view.end())
+			sum += it->second;
+	}
+	if (task->writes && task->id % 4 == 0)
+		copy[-1] = task->id;
+	task->sum = sum + static_cast<long>(copy.size());
+	return (NULL);
+}
+
+void run(const char* label, const int_map& source, bool writes)
+{
+	Task tasks[16];
+	double start = now_ms();
+	for (int batch = 0; batch < 16; batch += 4)
+	{
+		pthread_t threads[4];
+		for (int i = 0; i < 4; ++i)
+		{
+			Task& task = tasks[batch + i];
+			task.source = &source;
+			task.id = batch + i;
+			task.writes = writes;
+			pthread_create(&threads[i], NULL, reader, &task);
+		}
+		for (int i = 0; i < 4; ++i)
+			pthread_join(threads[i], NULL);
+	}
+	long sum = 0;
+	for (int i = 0; i < 16; ++i)
+		sum += tasks[i].sum;
+	std::cout << label << "\t" << now_ms() - start << " ms\t(" << sum << ")" << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+	int n = (argc > 1 ? std::atoi(argv[1]) : 1000000);
+	int_map source;
+	srand(42);
+	for (int i = 0; i < n; ++i)
+		source.insert(ft::make_pair(rand() % (n * 2), i));
+	std::cout << source.size() << " keys, 16 readers" << std::endl;
+	run("deep copies, read only", source, false);
+	run("deep copies, some write", source, true);
+	source.enable_copy_on_write();
+	run("copy-on-write, read only", source, false);
+	run("copy-on-write, some write", source, true);
+	return (0);
+}
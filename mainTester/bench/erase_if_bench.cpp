@@ -0,0 +1,75 @@
+#include "map.hpp"
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+#include <sys/time.h>
+
+// periodic cleanup: removing every element matching a predicate from a map of N random
+// keys, by walking it with erase(iterator) against erase_if, for a range of removed
+// fractions. Wall-clock time of the removal only; N is the first argument (default 1M).
+// Each run starts and ends with a 4 KB allocation: glibc coalesces the small blocks freed
+// before on the next large request, and that work belongs to the run that freed them.
+
+double now_ms()
+{
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+	return (tv.tv_sec * 1000.0 + tv.tv_usec / 1000.0);
+}
+
+// true for about permille / 1000 of the values, spread over the whole key range
+struct Expired {
+	int	permille;
+
+	Expired(int p) : permille(p) {}
+
+	bool operator()(const ft::pair<const int, int>& val) const
+	{
+		return (static_cast<unsigned int>(val.second) % 1000 < static_cast<unsigned int>(permille));
+	}
+};
+
+int main(int argc, char** argv)
+{
+	size_t n = (argc > 1 ? static_cast<size_t>(std::atol(argv[1])) : 1000000);
+	ft::map<int, int> base;
+	srand(42);
+	while (base.size() < n)
+		base.insert(ft::make_pair(rand(), rand()));
+	std::cout << n << " keys" << std::endl;
+
+	int fractions[] = { 1, 10, 50, 100, 250, 500, 750, 900, 990 };
+	for (size_t f = 0; f < sizeof(fractions) / sizeof(fractions[0]); ++f)
+	{
+		Expired expired(fractions[f]);
+		double walk_ms = 0;
+		double erase_if_ms = 0;
+		size_t removed = 0;
+		// both copies are made before either run, so neither gets nodes the other freed
+		ft::map<int, int> walked(base);
+		ft::map<int, int> filtered(base);
+		{
+			std::vector<char> settled(4096);
+			double start = now_ms();
+			for (ft::map<int, int>::iterator it = walked.begin(); it != walked.end();)
+			{
+				if (expired(*it))
+					walked.erase(it++);
+				else
+					++it;
+			}
+			std::vector<char> settle(4096);
+			walk_ms = now_ms() - start;
+		}
+		{
+			std::vector<char> settled(4096);
+			double start = now_ms();
+			removed = filtered.erase_if(expired);
+			std::vector<char> settle(4096);
+			erase_if_ms = now_ms() - start;
+		}
+		std::cout << fractions[f] / 10.0 << "% removed\terase loop " << walk_ms << " ms\terase_if " << erase_if_ms << " ms (x"
+			<< walk_ms / erase_if_ms << ")\t(" << removed << ", " << (walked == filtered ? "same" : "DIFFERENT") << ")" << std::endl;
+	}
+	return (0);
+}
@@ -0,0 +1,88 @@
+#include "map.hpp"
+#include <cmath>
+#include <ctime>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// find() on Zipf-distributed keys with and without the find cache; s is the Zipf
+// exponent, around 1 about 1% of the keys take 80% of the lookups
+
+#define N 200000
+#define LOOKUPS 4000000
+
+// LOOKUPS ranks drawn from Zipf(s) over [0, N) by inverting the cumulative weights
+std::vector<int> zipf_ranks(double s, unsigned int seed)
+{
+	std::vector<double> cdf(N);
+	double total = 0;
+	for (int i = 0; i < N; ++i)
+	{
+		total += 1.0 / std::pow(i + 1.0, s);
+		cdf[i] = total;
+	}
+	std::vector<int> res;
+	srand(seed);
+	for (int i = 0; i < LOOKUPS; ++i)
+	{
+		double u = (static_cast<double>(rand()) / RAND_MAX) * total;
+		res.push_back(static_cast<int>(std::lower_bound(cdf.begin(), cdf.end(), u) - cdf.begin()));
+	}
+	return (res);
+}
+
+template <typename Key>
+Key make_key(int i);
+
+template <>
+int make_key<int>(int i) { return (i * 7919 % (N * 2)); }
+
+template <>
+std::string make_key<std::string>(int i)
+{
+	std::ostringstream os;
+	os << "user:session:" << (i * 7919 % (N * 2));
+	return (os.str());
+}
+
+template <typename Key>
+void run(const char* name, const std::vector<int>& ranks, size_t slots)
+{
+	ft::map<Key, int> mp;
+	std::vector<Key> keys;
+	for (int i = 0; i < N; ++i)
+	{
+		keys.push_back(make_key<Key>(i));
+		mp.insert(ft::make_pair(keys.back(), i));
+	}
+	mp.enable_find_cache(slots);
+
+	clock_t start = clock();
+	size_t found = 0;
+	for (size_t i = 0; i < ranks.size(); ++i)
+		found += (mp.find(keys[ranks[i]]) != mp.end());
+	double ms = static_cast<double>(clock() - start) * 1000 / CLOCKS_PER_SEC;
+
+	std::cout << name << "\t" << slots << " slots\t" << ms << " ms\t" << (ms * 1e6 / ranks.size()) << " ns/find";
+	if (slots != 0)
+		std::cout << "\thit rate " << 100.0 * mp.find_cache_hits() / (mp.find_cache_hits() + mp.find_cache_misses()) << "%";
+	std::cout << "\t(hits " << found << ")" << std::endl;
+}
+
+int main()
+{
+	const double exponents[] = { 0.8, 1.0, 1.2 };
+	const size_t slots[] = { 0, 256, 4096 };
+	for (size_t e = 0; e < sizeof(exponents) / sizeof(exponents[0]); ++e)
+	{
+		std::vector<int> ranks = zipf_ranks(exponents[e], 42);
+		std::cout << "=== zipf s=" << exponents[e] << " ===" << std::endl;
+		for (size_t i = 0; i < sizeof(slots) / sizeof(slots[0]); ++i)
+			run<int>("int keys   ", ranks, slots[i]);
+		for (size_t i = 0; i < sizeof(slots) / sizeof(slots[0]); ++i)
+			run<std::string>("string keys", ranks, slots[i]);
+	}
+	return (0);
+}
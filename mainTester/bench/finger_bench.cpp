@@ -0,0 +1,79 @@
+#include "map.hpp"
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+#include <sys/time.h>
+
+// lookups that walk the key space in small steps (average gap given, one random jump per
+// 1000), answered by find/lower_bound from the root and by the finger-search variants;
+// a fully random stream shows what the finger costs when it does not help. The map size
+// is the first argument (default 2M), 2M lookups per row.
+
+double now_ms()
+{
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+	return (tv.tv_sec * 1000.0 + tv.tv_usec / 1000.0);
+}
+
+std::vector<int> walk(int n, int gap)
+{
+	std::vector<int> keys;
+	int k = 0;
+	for (int i = 0; i < 2000000; ++i)
+	{
+		if (gap == 0 || i % 1000 == 0)
+			k = rand() % (n * 2);
+		else
+			k = (k + rand() % (2 * gap + 1)) % (n * 2);
+		keys.push_back(k);
+	}
+	return (keys);
+}
+
+void row(const char* label, ft::map<int, int>& mp, const std::vector<int>& keys)
+{
+	long sum[4] = { 0, 0, 0, 0 };
+	double ms[4];
+	double start = now_ms();
+	for (size_t i = 0; i < keys.size(); ++i)
+		sum[0] += (mp.find(keys[i]) != mp.end());
+	ms[0] = now_ms() - start;
+	start = now_ms();
+	for (size_t i = 0; i < keys.size(); ++i)
+		sum[1] += (mp.find_near(keys[i]) != mp.end());
+	ms[1] = now_ms() - start;
+	start = now_ms();
+	for (size_t i = 0; i < keys.size(); ++i)
+		sum[2] += mp.lower_bound(keys[i])->second;
+	ms[2] = now_ms() - start;
+	start = now_ms();
+	for (size_t i = 0; i < keys.size(); ++i)
+		sum[3] += mp.lower_bound_near(keys[i])->second;
+	ms[3] = now_ms() - start;
+	std::cout << label << "\tfind " << ms[0] << " ms, find_near " << ms[1] << " ms (x" << ms[0] / ms[1] << ")\tlower_bound "
+		<< ms[2] << " ms, lower_bound_near " << ms[3] << " ms (x" << ms[2] / ms[3] << ")\t(" << sum[0] << "/" << sum[1]
+		<< ", " << sum[2] - sum[3] << ")" << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+	int n = (argc > 1 ? std::atoi(argv[1]) : 2000000);
+	ft::map<int, int> mp;
+	srand(42);
+	for (int i = 0; i < n; ++i)
+		mp.insert(ft::make_pair(rand() % (n * 2), i));
+	mp[n * 2] = 0;
+	std::cout << mp.size() << " keys in [0, " << n * 2 << "]" << std::endl;
+
+	int gaps[] = { 1, 16, 256, 4096 };
+	for (size_t g = 0; g < sizeof(gaps) / sizeof(gaps[0]); ++g)
+	{
+		std::vector<int> keys = walk(n, gaps[g]);
+		std::cout << "gap " << gaps[g];
+		row("\t", mp, keys);
+	}
+	std::vector<int> keys = walk(n, 0);
+	row("random\t", mp, keys);
+	return (0);
+}
@@ -0,0 +1,332 @@
+#include "map.hpp"
+#include <algorithm>
+#include <ctime>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// insert and erase throughput of red-black maps whose fix-ups are the loops of RBBalance,
+// against the chain of recursive insert_case / delete_case calls it had before (kept
+// below as RecursiveRBBalance; both build the same trees). N keys are inserted in random
+// or ascending order, then all erased in random or ascending order; every row runs in a
+// forked child, as in balance_bench. N is the first argument (default 1M; try 4096 for a
+// tree that stays in cache).
+
+struct RecursiveRBBalance : public ft::TreeRotation {
+	template <typename Node>
+	static void init_node(Node* node)
+	{
+		node->color = ft::RED;
+	}
+
+	template <typename Node, typename Counter>
+	static void insert_fixup(Node* node, Node*& root, const Counter& counter)
+	{
+		insert_case1(node, root, counter);
+	}
+
+	template <typename Node, typename Counter>
+	static void erase_fixup(Node* target, Node* child, Node*& root, const Counter& counter)
+	{
+		if (target->color == ft::BLACK)
+		{
+			if (child->color == ft::RED)
+			{
+				counter.count_recolor(1);
+				child->color = ft::BLACK;
+			}
+			else
+				delete_case1(child, root, counter);
+		}
+	}
+
+	template <typename Node>
+	static void build_node(Node* node, size_t depth, size_t max_depth)
+	{
+		ft::RBBalance::build_node(node, depth, max_depth);
+	}
+
+	template <typename Node>
+	static bool verify(Node* root)
+	{
+		return (ft::RBBalance::verify(root));
+	}
+
+	template <typename Node>
+	static size_t black_height(Node* node)
+	{
+		return (ft::RBBalance::black_height(node));
+	}
+
+	private :
+		template <typename Node>
+		static Node* get_grandparent(Node* node)
+		{
+			if (node != NULL && node->parent != NULL)
+				return (node->parent->parent);
+			else
+				return (NULL);
+		}
+
+		template <typename Node>
+		static Node* get_uncle(Node* node)
+		{
+			Node* grand = get_grandparent(node);
+			if (grand == NULL)
+				return (NULL);
+			if (grand->leftChild == node->parent)
+				return (grand->rightChild);
+			else
+				return (grand->leftChild);
+		}
+
+		template <typename Node>
+		static Node* get_sibling(Node* node)
+		{
+			if (node == node->parent->leftChild)
+				return (node->parent->rightChild);
+			else
+				return (node->parent->leftChild);
+		}
+
+		template <typename Node, typename Counter>
+		static void insert_case1(Node* node, Node*& root, const Counter& counter)
+		{
+			if (node->parent->value != NULL)
+				insert_case2(node, root, counter);
+			else
+			{
+				counter.count_recolor(1);
+				node->color = ft::BLACK;
+			}
+		}
+
+		template <typename Node, typename Counter>
+		static void insert_case2(Node* node, Node*& root, const Counter& counter)
+		{
+			if (node->parent->color == ft::RED)
+				insert_case3(node, root, counter);
+		}
+
+		template <typename Node, typename Counter>
+		static void insert_case3(Node* node, Node*& root, const Counter& counter)
+		{
+			Node* uncle = get_uncle(node);
+			Node* grand;
+			if (uncle->value != NULL && uncle->color == ft::RED)
+			{
+				counter.count_recolor(3);
+				node->parent->color = ft::BLACK;
+				uncle->color = ft::BLACK;
+				grand = get_grandparent(node);
+				grand->color = ft::RED;
+				insert_case1(grand, root, counter);
+			}
+			else
+				insert_case4(node, root, counter);
+		}
+
+		template <typename Node, typename Counter>
+		static void insert_case4(Node* node, Node*& root, const Counter& counter)
+		{
+
+			Node* grand = get_grandparent(node);
+			if (node == node->parent->rightChild && node->parent == grand->leftChild)
+			{
+				rotate_left(node->parent, root, counter);
+				node = node->leftChild;
+			}
+			else if (node == node->parent->leftChild && node->parent == grand->rightChild)
+			{
+				rotate_right(node->parent, root, counter);
+				node = node->rightChild;
+			}
+			insert_case5(node, root, counter);
+		}
+
+		template <typename Node, typename Counter>
+		static void insert_case5(Node* node, Node*& root, const Counter& counter)
+		{
+
+			Node* grand = get_grandparent(node);
+			counter.count_recolor(2);
+			node->parent->color = ft::BLACK;
+			grand->color = ft::RED;
+			if (node == node->parent->leftChild)
+				rotate_right(grand, root, counter);
+			else
+				rotate_left(grand, root, counter);
+		}
+
+		template <typename Node, typename Counter>
+		static void delete_case1(Node* node, Node*& root, const Counter& counter)
+		{
+
+			if (node->parent->value != NULL)
+				delete_case2(node, root, counter);
+		}
+
+		template <typename Node, typename Counter>
+		static void delete_case2(Node* node, Node*& root, const Counter& counter)
+		{
+
+			Node* sibling = get_sibling(node);
+			if (sibling->color == ft::RED)
+			{
+				counter.count_recolor(2);
+				node->parent->color = ft::RED;
+				sibling->color = ft::BLACK;
+				if (node == node->parent->leftChild)
+					rotate_left(node->parent, root, counter);
+				else
+					rotate_right(node->parent, root, counter);
+			}
+			delete_case3(node, root, counter);
+		}
+
+
+		template <typename Node, typename Counter>
+		static void delete_case3(Node* node, Node*& root, const Counter& counter)
+		{
+
+			Node* sibling = get_sibling(node);
+			if (node->parent->color == ft::BLACK && sibling->color == ft::BLACK && sibling->leftChild->color == ft::BLACK && sibling->rightChild->color == ft::BLACK)
+			{
+				counter.count_recolor(1);
+				sibling->color = ft::RED;
+				delete_case1(node->parent, root, counter);
+			}
+			else
+				delete_case4(node, root, counter);
+		}
+
+
+		template <typename Node, typename Counter>
+		static void delete_case4(Node* node, Node*& root, const Counter& counter)
+		{
+
+			Node* sibling = get_sibling(node);
+			if (node->parent->color == ft::RED && sibling->color == ft::BLACK && sibling->leftChild->color == ft::BLACK && sibling->rightChild->color == ft::BLACK)
+			{
+				counter.count_recolor(2);
+				sibling->color = ft::RED;
+				node->parent->color = ft::BLACK;
+			}
+			else
+				delete_case5(node, root, counter);
+		}
+
+		template <typename Node, typename Counter>
+		static void delete_case5(Node* node, Node*& root, const Counter& counter)
+		{
+
+			Node* sibling = get_sibling(node);
+
+			if (sibling->color == ft::BLACK)
+			{
+				if (node == node->parent->leftChild && sibling->rightChild->color == ft::BLACK && sibling->leftChild->color == ft::RED)
+				{
+					counter.count_recolor(2);
+					sibling->color = ft::RED;
+					sibling->leftChild->color = ft::BLACK;
+					rotate_right(sibling, root, counter);
+				}
+				else if (node == node->parent->rightChild && sibling->leftChild->color == ft::BLACK && sibling->rightChild->color == ft::RED)
+				{
+					counter.count_recolor(2);
+					sibling->color = ft::RED;
+					sibling->rightChild->color = ft::BLACK;
+					rotate_left(sibling, root, counter);
+				}
+			}
+			delete_case6(node, root, counter);
+		}
+
+		template <typename Node, typename Counter>
+		static void delete_case6(Node* node, Node*& root, const Counter& counter)
+		{
+
+			Node* sibling = get_sibling(node);
+			counter.count_recolor(3);
+			sibling->color = node->parent->color;
+			node->parent->color = ft::BLACK;
+			if (node == node->parent->leftChild)
+			{
+				sibling->rightChild->color = ft::BLACK;
+				rotate_left(node->parent, root, counter);
+			}
+			else
+			{
+				sibling->leftChild->color = ft::BLACK;
+				rotate_right(node->parent, root, counter);
+			}
+		}
+};
+
+typedef std::allocator< ft::pair<const int, int> >	alloc_type;
+
+double elapsed_ms(clock_t start)
+{
+	return (static_cast<double>(clock() - start) * 1000 / CLOCKS_PER_SEC);
+}
+
+template <typename Map>
+void run(const char* name, const std::vector<int>& inserts, const std::vector<int>& erases, size_t rounds)
+{
+	pid_t pid = fork();
+	if (pid != 0)
+	{
+		waitpid(pid, NULL, 0);
+		return ;
+	}
+	Map mp;
+	double insert = 0;
+	double erase = 0;
+	size_t height = 0;
+	for (size_t r = 0; r < rounds; ++r)
+	{
+		clock_t start = clock();
+		for (size_t i = 0; i < inserts.size(); ++i)
+			mp.insert(ft::make_pair(inserts[i], 0));
+		insert += elapsed_ms(start);
+		height = mp.tree_stats().height;
+		start = clock();
+		for (size_t i = 0; i < erases.size(); ++i)
+			mp.erase(erases[i]);
+		erase += elapsed_ms(start);
+	}
+	double ops = static_cast<double>(inserts.size()) * rounds;
+	std::cout << "  " << name << "\tinsert " << insert << " ms (" << ops / insert / 1000 << " M/s)\terase " << erase
+		<< " ms (" << ops / erase / 1000 << " M/s)\theight " << height << "\t(" << mp.size() << ")" << std::endl;
+	_exit(0);
+}
+
+int main(int argc, char** argv)
+{
+	size_t n = (argc > 1 ? static_cast<size_t>(std::atol(argv[1])) : 1000000);
+	std::vector<int> ascending;
+	for (size_t i = 0; i < n; ++i)
+		ascending.push_back(static_cast<int>(i));
+	srand(42);
+	std::vector<int> random_a(ascending);
+	std::random_shuffle(random_a.begin(), random_a.end());
+	std::vector<int> random_b(ascending);
+	std::random_shuffle(random_b.begin(), random_b.end());
+
+	const char* labels[] = { "random insert, random erase", "ascending insert, ascending erase", "ascending insert, random erase" };
+	const std::vector<int>* inserts[] = { &random_a, &ascending, &ascending };
+	const std::vector<int>* erases[] = { &random_b, &ascending, &random_b };
+	// small trees are filled and emptied again until about 2M keys went through, so that
+	// they stay in cache and the fix-ups weigh more against the descent
+	size_t rounds = (n < 2000000 ? 2000000 / n : 1);
+	std::cout << n << " keys, " << rounds << " rounds" << std::endl;
+	for (size_t w = 0; w < 3; ++w)
+	{
+		std::cout << labels[w] << std::endl;
+		run< ft::map<int, int, ft::less<int>, alloc_type, RecursiveRBBalance> >("recursive cases", *inserts[w], *erases[w], rounds);
+		run< ft::map<int, int, ft::less<int>, alloc_type, ft::RBBalance> >("iterative loops", *inserts[w], *erases[w], rounds);
+	}
+	return (0);
+}
@@ -0,0 +1,76 @@
+#include "map.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include <vector>
+
+// delete-heavy workload: a map of N keys loses 3/4 of them in random order, with one
+// lookup and one insert of a fresh key per 4 erases. Each key is found first and only
+// erase(iterator) is timed, so the distribution shows the unlinking and fix-up work lazy
+// erase saves and, in the tail, the rebuilds it costs. Eager erase against lazy erase at
+// a few rebuild thresholds; N is the first argument (default 1M).
+
+long now_ns()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (ts.tv_sec * 1000000000L + ts.tv_nsec);
+}
+
+long percentile(const std::vector<long>& sorted, double p)
+{
+	return (sorted[static_cast<size_t>(p * (sorted.size() - 1))]);
+}
+
+void run(const char* label, double max_dead, const std::vector<int>& keys, const std::vector<int>& order)
+{
+	ft::map<int, int> mp;
+	for (size_t i = 0; i < keys.size(); ++i)
+		mp.insert(mp.end(), ft::make_pair(keys[i], static_cast<int>(i)));
+	mp.enable_lazy_erase(max_dead);
+
+	std::vector<long> lat;
+	lat.reserve(order.size());
+	size_t found = 0;
+	long total = now_ns();
+	for (size_t i = 0; i < order.size(); ++i)
+	{
+		ft::map<int, int>::iterator it = mp.find(keys[order[i]]);
+		long start = now_ns();
+		mp.erase(it);
+		lat.push_back(now_ns() - start);
+		if (i % 4 == 3)
+		{
+			found += mp.count(keys[rand() % keys.size()]);
+			mp[static_cast<int>(keys.size() * 2 + i)] = 0;
+		}
+	}
+	total = now_ns() - total;
+	std::sort(lat.begin(), lat.end());
+	std::cout << label << "\ttotal " << total / 1000000 << " ms\terase p50 " << percentile(lat, 0.5) << " ns, p99 "
+		<< percentile(lat, 0.99) << " ns, p99.9 " << percentile(lat, 0.999) << " ns, max " << lat.back() / 1000
+		<< " us\t(" << mp.size() << " left, " << mp.tree_stats().tombstones << " tombstones, hits " << found << ")" << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+	size_t n = (argc > 1 ? static_cast<size_t>(std::atol(argv[1])) : 1000000);
+	std::vector<int> keys;
+	for (size_t i = 0; i < n; ++i)
+		keys.push_back(static_cast<int>(i * 2));
+	std::vector<int> order;
+	for (size_t i = 0; i < n; ++i)
+		order.push_back(static_cast<int>(i));
+	srand(42);
+	for (size_t i = n; i > 1; --i)
+		std::swap(order[i - 1], order[rand() % i]);
+	order.resize(n * 3 / 4);
+	std::cout << n << " keys, " << order.size() << " erases" << std::endl;
+
+	run("eager\t", 0, keys, order);
+	run("lazy 0.10", 0.10, keys, order);
+	run("lazy 0.25", 0.25, keys, order);
+	run("lazy 0.50", 0.50, keys, order);
+	return (0);
+}
@@ -0,0 +1,179 @@
+#include "lru_cache.hpp"
+#include "map.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include <list>
+#include <memory>
+#include <vector>
+
+// a read-through cache in front of a million keys drawn from a Zipf distribution (s = 1,
+// a few keys are hot and a long tail is cold), as a service sees it: get(), and put() on
+// a miss. ft::lru_cache against the hand-rolled ft::map of std::list positions it replaces,
+// with capacities giving hit rates from about 50% to 95%: time per request, heap
+// allocations per request and the hit rate each reports.
+
+#define KEYS 1000000
+#define REQUESTS 5000000
+
+static size_t allocations = 0;
+
+// std::allocator that counts the allocations made through it and its rebinds
+template <typename T>
+struct CountingAllocator : public std::allocator<T> {
+	template <typename U>
+	struct rebind {
+		typedef CountingAllocator<U>	other;
+	};
+
+	CountingAllocator() {}
+	CountingAllocator(const CountingAllocator&) : std::allocator<T>() {}
+	template <typename U>
+	CountingAllocator(const CountingAllocator<U>&) : std::allocator<T>() {}
+
+	T* allocate(size_t n, const void* = 0)
+	{
+		++allocations;
+		return (std::allocator<T>().allocate(n));
+	}
+};
+
+struct Record {
+	long	fields[4];
+};
+
+Record load(int key)
+{
+	Record res;
+	for (int i = 0; i < 4; ++i)
+		res.fields[i] = key + i;
+	return (res);
+}
+
+// the ft::map plus side list every service writes: a map node, its value and a list node
+// for each entry
+class MapListCache {
+	private:
+		typedef std::list< std::pair<int, Record>, CountingAllocator< std::pair<int, Record> > >	list_type;
+		typedef ft::map<int, list_type::iterator, ft::less<int>, CountingAllocator< ft::pair<const int, list_type::iterator> > >	index_type;
+
+		list_type	_list;
+		index_type	_index;
+		size_t		_capacity;
+		size_t		_hits;
+		size_t		_misses;
+
+	public:
+		explicit MapListCache(size_t capacity) : _capacity(capacity), _hits(0), _misses(0) {}
+
+		Record* get(int k)
+		{
+			index_type::iterator found = this->_index.find(k);
+			if (found == this->_index.end())
+			{
+				++this->_misses;
+				return (NULL);
+			}
+			++this->_hits;
+			this->_list.splice(this->_list.begin(), this->_list, found->second);
+			return (&found->second->second);
+		}
+
+		void put(int k, const Record& v)
+		{
+			if (this->_list.size() == this->_capacity)
+			{
+				this->_index.erase(this->_list.back().first);
+				this->_list.pop_back();
+			}
+			this->_list.push_front(std::make_pair(k, v));
+			this->_index.insert(ft::make_pair(k, this->_list.begin()));
+		}
+
+		size_t hits() const
+		{
+			return (this->_hits);
+		}
+
+		size_t misses() const
+		{
+			return (this->_misses);
+		}
+};
+
+std::vector<int> zipf_trace(size_t keys, size_t requests, double s)
+{
+	std::vector<double> cdf(keys);
+	double sum = 0;
+	for (size_t i = 0; i < keys; ++i)
+	{
+		sum += 1.0 / std::pow(static_cast<double>(i + 1), s);
+		cdf[i] = sum;
+	}
+	// ranks are scattered over the key space, so hot keys are not neighbours
+	std::vector<int> ids(keys);
+	for (size_t i = 0; i < keys; ++i)
+		ids[i] = static_cast<int>(i);
+	std::random_shuffle(ids.begin(), ids.end());
+	std::vector<int> trace;
+	trace.reserve(requests);
+	for (size_t i = 0; i < requests; ++i)
+	{
+		double u = (static_cast<double>(rand()) / RAND_MAX) * sum;
+		size_t rank = std::lower_bound(cdf.begin(), cdf.end(), u) - cdf.begin();
+		trace.push_back(ids[std::min(rank, keys - 1)]);
+	}
+	return (trace);
+}
+
+template <typename Cache>
+void run(const char* label, size_t capacity, const std::vector<int>& trace)
+{
+	Cache cache(capacity);
+	// one pass to warm up, then the measured one
+	for (size_t i = 0; i < trace.size(); ++i)
+	{
+		if (cache.get(trace[i]) == NULL)
+			cache.put(trace[i], load(trace[i]));
+	}
+	size_t hits = cache.hits();
+	size_t misses = cache.misses();
+	size_t before = allocations;
+	clock_t start = clock();
+	long sum = 0;
+	for (size_t i = 0; i < trace.size(); ++i)
+	{
+		Record* rec = cache.get(trace[i]);
+		if (rec == NULL)
+		{
+			Record fresh = load(trace[i]);
+			cache.put(trace[i], fresh);
+			sum += fresh.fields[1];
+		}
+		else
+			sum += rec->fields[1];
+	}
+	double ms = static_cast<double>(clock() - start) * 1000 / CLOCKS_PER_SEC;
+	size_t allocs = allocations - before;
+	hits = cache.hits() - hits;
+	misses = cache.misses() - misses;
+	std::cout << "  " << label << "\t" << ms * 1e6 / trace.size() << " ns/request\t" << static_cast<double>(allocs) / trace.size()
+		<< " allocs/request\thit rate " << 100.0 * hits / (hits + misses) << "%\t(" << sum % 1000 << ")" << std::endl;
+}
+
+int main()
+{
+	srand(42);
+	std::vector<int> trace = zipf_trace(KEYS, REQUESTS, 1.0);
+	size_t capacities[] = { 1000, 10000, 100000, 500000 };
+	std::cout << REQUESTS << " requests over " << KEYS << " keys" << std::endl;
+	for (size_t i = 0; i < sizeof(capacities) / sizeof(capacities[0]); ++i)
+	{
+		std::cout << "capacity " << capacities[i] << std::endl;
+		run<MapListCache>("ft::map + std::list", capacities[i], trace);
+		run< ft::lru_cache<int, Record, ft::checked_hash<int>, ft::unit_weight, CountingAllocator< ft::pair<const int, Record> > > >("ft::lru_cache\t", capacities[i], trace);
+	}
+	return (0);
+}
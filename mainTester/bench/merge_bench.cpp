@@ -0,0 +1,72 @@
+#include "map.hpp"
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+#include <sys/time.h>
+
+// combining k partial maps (32, 64 and 256 shards of random keys over a shared key space,
+// so keys recur across shards and values are summed) into one: every element inserted
+// into the result by hand against assign_merged on one thread and on one per core.
+// Wall-clock time; the total element count is the first argument (default 4M).
+
+double now_ms()
+{
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+	return (tv.tv_sec * 1000.0 + tv.tv_usec / 1000.0);
+}
+
+struct Add {
+	long operator()(long a, long b) const { return (a + b); }
+};
+
+long checksum(const ft::map<int, long>& mp)
+{
+	long sum = 0;
+	for (ft::map<int, long>::const_iterator it = mp.begin(); it != mp.end(); ++it)
+		sum += it->second ^ it->first;
+	return (sum);
+}
+
+int main(int argc, char** argv)
+{
+	size_t n = (argc > 1 ? static_cast<size_t>(std::atol(argv[1])) : 4000000);
+	size_t shards[] = { 32, 64, 256 };
+	srand(42);
+	for (size_t s = 0; s < sizeof(shards) / sizeof(shards[0]); ++s)
+	{
+		std::vector< ft::map<int, long> > parts(shards[s]);
+		for (size_t i = 0; i < n; ++i)
+			parts[i % shards[s]][rand() % static_cast<int>(n)] += 1;
+		size_t total = 0;
+		for (size_t p = 0; p < parts.size(); ++p)
+			total += parts[p].size();
+		std::cout << shards[s] << " shards, " << total << " elements" << std::endl;
+
+		double start = now_ms();
+		ft::map<int, long> naive;
+		for (size_t p = 0; p < parts.size(); ++p)
+		{
+			for (ft::map<int, long>::iterator it = parts[p].begin(); it != parts[p].end(); ++it)
+			{
+				ft::pair<ft::map<int, long>::iterator, bool> res = naive.insert(*it);
+				if (!res.second)
+					res.first->second += it->second;
+			}
+		}
+		double ms = now_ms() - start;
+		std::cout << "  insert\t\t" << ms << " ms\t(" << naive.size() << " keys, " << checksum(naive) << ")" << std::endl;
+
+		unsigned int threads[] = { 1, 0 };
+		for (size_t t = 0; t < 2; ++t)
+		{
+			start = now_ms();
+			ft::map<int, long> merged;
+			merged.assign_merged(parts.begin(), parts.end(), Add(), threads[t]);
+			double merge_ms = now_ms() - start;
+			std::cout << "  assign_merged " << (threads[t] == 1 ? "1 thread" : "all cores") << "\t" << merge_ms << " ms (x" << ms / merge_ms
+				<< ")\t(" << merged.size() << " keys, " << checksum(merged) << ")" << std::endl;
+		}
+	}
+	return (0);
+}
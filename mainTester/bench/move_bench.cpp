@@ -0,0 +1,81 @@
+#include "map.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <sys/time.h>
+
+// inserting heavy elements (string keys, 64-int vector payloads): copy insert against
+// move insert and emplace, each into an empty map. Needs CXXSTD=c++11; N is the first
+// argument (default 500K).
+
+#if __cplusplus < 201103L
+int main()
+{
+	std::cout << "move_bench needs a C++11 build: make bench BENCH=move_bench CXXSTD=c++11" << std::endl;
+	return (0);
+}
+#else
+
+typedef ft::map<std::string, std::vector<int> > heavy_map;
+
+double now_ms()
+{
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+	return (tv.tv_sec * 1000.0 + tv.tv_usec / 1000.0);
+}
+
+std::vector<heavy_map::value_type> make_input(size_t n)
+{
+	std::vector<heavy_map::value_type> input;
+	char buf[64];
+	srand(42);
+	for (size_t i = 0; i < n; ++i)
+	{
+		snprintf(buf, sizeof(buf), "key-%08d-%08d-padding", rand(), static_cast<int>(i));
+		input.push_back(heavy_map::value_type(std::string(buf), std::vector<int>(64, static_cast<int>(i))));
+	}
+	return (input);
+}
+
+void report(const char* label, const heavy_map& mp, double start)
+{
+	double ms = now_ms() - start;
+	std::cout << label << "\t" << ms << " ms (" << static_cast<long>(mp.size() / ms * 1000) << "/s)\t("
+		<< mp.size() << " keys)" << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+	size_t n = (argc > 1 ? static_cast<size_t>(std::atol(argv[1])) : 500000);
+	std::cout << n << " inserts of string keys with vector<int>(64) payloads" << std::endl;
+	{
+		std::vector<heavy_map::value_type> input = make_input(n);
+		double start = now_ms();
+		heavy_map mp;
+		for (size_t i = 0; i < n; ++i)
+			mp.insert(input[i]);
+		report("copy insert", mp, start);
+	}
+	{
+		std::vector<heavy_map::value_type> input = make_input(n);
+		double start = now_ms();
+		heavy_map mp;
+		for (size_t i = 0; i < n; ++i)
+			mp.insert(std::move(input[i]));
+		report("move insert", mp, start);
+	}
+	{
+		std::vector<heavy_map::value_type> input = make_input(n);
+		double start = now_ms();
+		heavy_map mp;
+		for (size_t i = 0; i < n; ++i)
+			mp.emplace(input[i].first, std::move(input[i].second));
+		report("emplace\t", mp, start);
+	}
+	return (0);
+}
+
+#endif
@@ -0,0 +1,59 @@
+#include "map.hpp"
+#include <cstdlib>
+#include <iostream>
+#include <sys/time.h>
+
+// parallel_reduce and parallel_for_each over one map at 1, 2, 4, ... threads up to
+// the core count; wall-clock time. The map size is the first argument (default 5M,
+// each entry costs about 60 bytes).
+
+double now_ms()
+{
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+	return (tv.tv_sec * 1000.0 + tv.tv_usec / 1000.0);
+}
+
+struct Add {
+	double operator()(double a, double b) const { return (a + b); }
+};
+
+// a little arithmetic per element so the walk is not purely memory bound
+struct Score {
+	double operator()(const ft::pair<const int, double>& val) const
+	{
+		double x = val.second;
+		return (x * x * 0.5 + x / (1.0 + val.first % 7));
+	}
+};
+
+struct Scale {
+	void operator()(ft::pair<const int, double>& val) const { val.second *= 1.0000001; }
+};
+
+int main(int argc, char** argv)
+{
+	size_t n = (argc > 1 ? static_cast<size_t>(std::atol(argv[1])) : 5000000);
+	ft::map<int, double> mp;
+	srand(42);
+	while (mp.size() < n)
+		mp.insert(mp.end(), ft::make_pair(static_cast<int>(mp.size()), static_cast<double>(rand() % 1000)));
+	unsigned int cores = ft::hardware_threads();
+	std::cout << mp.size() << " entries, " << cores << " cores" << std::endl;
+
+	double base = 0;
+	for (unsigned int threads = 1; threads <= cores || threads == 1; threads *= 2)
+	{
+		double start = now_ms();
+		double sum = mp.parallel_reduce(0.0, Add(), Score(), threads);
+		double reduce_ms = now_ms() - start;
+		start = now_ms();
+		mp.parallel_for_each(Scale(), threads);
+		double each_ms = now_ms() - start;
+		if (threads == 1)
+			base = reduce_ms;
+		std::cout << threads << " threads\treduce " << reduce_ms << " ms (x" << base / reduce_ms << ")\tfor_each "
+			<< each_ms << " ms\t(sum " << sum << ")" << std::endl;
+	}
+	return (0);
+}
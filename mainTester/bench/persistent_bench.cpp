@@ -0,0 +1,82 @@
+#include "persistent_map.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include <vector>
+#include <sys/time.h>
+
+// restart cost: reopening a persistent_map file and answering the first lookups, against
+// reloading the same pairs from a flat dump into an ft::map. Wall-clock time, page faults
+// on the mapped file are part of what is measured.
+
+#define N 2000000
+#define LOOKUPS 100000
+#define DB_PATH "./persistent_bench.db"
+#define DUMP_PATH "./persistent_bench.dump"
+
+double now_ms()
+{
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+	return (tv.tv_sec * 1000.0 + tv.tv_usec / 1000.0);
+}
+
+template <typename Map>
+size_t lookups(const Map& mp)
+{
+	size_t found = 0;
+	srand(7);
+	for (int i = 0; i < LOOKUPS; ++i)
+		found += mp.count(rand() % (N * 2));
+	return (found);
+}
+
+int main()
+{
+	std::remove(DB_PATH);
+	std::vector< ft::pair<int, long> > pairs;
+	srand(42);
+	for (int i = 0; i < N; ++i)
+		pairs.push_back(ft::make_pair(rand() % (N * 2), static_cast<long>(i)));
+
+	double start = now_ms();
+	{
+		ft::persistent_map<int, long> mp(DB_PATH);
+		mp.reserve(N);
+		for (size_t i = 0; i < pairs.size(); ++i)
+			mp.insert(pairs[i]);
+		mp.checkpoint();
+		std::cout << "persistent_map build + checkpoint\t" << now_ms() - start << " ms\t(" << mp.size() << " entries)" << std::endl;
+	}
+	FILE* dump = std::fopen(DUMP_PATH, "wb");
+	std::fwrite(&pairs[0], sizeof(pairs[0]), pairs.size(), dump);
+	std::fclose(dump);
+
+	start = now_ms();
+	{
+		ft::persistent_map<int, long> mp(DB_PATH);
+		double opened = now_ms();
+		size_t found = lookups(mp);
+		std::cout << "persistent_map reopen\t\t\t" << opened - start << " ms, first " << LOOKUPS << " lookups "
+			<< now_ms() - opened << " ms\t(hits " << found << ")" << std::endl;
+	}
+
+	start = now_ms();
+	{
+		std::vector< ft::pair<int, long> > loaded(N);
+		dump = std::fopen(DUMP_PATH, "rb");
+		size_t read = std::fread(&loaded[0], sizeof(loaded[0]), loaded.size(), dump);
+		std::fclose(dump);
+		ft::map<int, long> mp;
+		for (size_t i = 0; i < read; ++i)
+			mp.insert(loaded[i]);
+		double built = now_ms();
+		size_t found = lookups(mp);
+		std::cout << "ft::map reload from dump\t\t" << built - start << " ms, first " << LOOKUPS << " lookups "
+			<< now_ms() - built << " ms\t(hits " << found << ")" << std::endl;
+	}
+	std::remove(DB_PATH);
+	std::remove(DUMP_PATH);
+	return (0);
+}
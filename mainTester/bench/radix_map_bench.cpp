@@ -0,0 +1,102 @@
+#include "radix_map.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <sys/time.h>
+
+// radix_map against ft::map on three key distributions: dense integers (a shuffled
+// 0..N-1), sparse integers (random 64-bit) and strings (URL-like, long shared prefixes).
+// N inserts in random order, 2M finds (half misses), 2M lower_bounds and one in-order
+// scan. Wall-clock time; N is the first argument (default 1M).
+
+double now_ms()
+{
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+	return (tv.tv_sec * 1000.0 + tv.tv_usec / 1000.0);
+}
+
+template <typename Map, typename Key>
+void run(const char* label, const std::vector<Key>& keys, const std::vector<Key>& probes)
+{
+	double ms[4];
+	long sum = 0;
+	Map mp;
+	double start = now_ms();
+	for (size_t i = 0; i < keys.size(); ++i)
+		mp.insert(ft::make_pair(keys[i], static_cast<int>(i)));
+	ms[0] = now_ms() - start;
+	start = now_ms();
+	for (size_t i = 0; i < probes.size(); ++i)
+		sum += (mp.find(probes[i]) != mp.end());
+	ms[1] = now_ms() - start;
+	start = now_ms();
+	for (size_t i = 0; i < probes.size(); ++i)
+	{
+		typename Map::iterator it = mp.lower_bound(probes[i]);
+		sum += (it == mp.end() ? 0 : it->second);
+	}
+	ms[2] = now_ms() - start;
+	start = now_ms();
+	for (typename Map::iterator it = mp.begin(); it != mp.end(); ++it)
+		sum += it->second;
+	ms[3] = now_ms() - start;
+	std::cout << label << "\tinsert " << ms[0] << " ms\tfind " << ms[1] << " ms\tlower_bound " << ms[2]
+		<< " ms\tscan " << ms[3] << " ms\t(" << sum << ")" << std::endl;
+}
+
+template <typename Key>
+void compare(const char* name, const std::vector<Key>& keys, const std::vector<Key>& probes)
+{
+	std::cout << name << ", " << keys.size() << " keys" << std::endl;
+	run<ft::map<Key, int> >("  ft::map\t", keys, probes);
+	run<ft::radix_map<Key, int> >("  radix_map\t", keys, probes);
+}
+
+unsigned long long rand64()
+{
+	return ((static_cast<unsigned long long>(rand()) << 42) ^ (static_cast<unsigned long long>(rand()) << 21) ^ rand());
+}
+
+int main(int argc, char** argv)
+{
+	size_t n = (argc > 1 ? static_cast<size_t>(std::atol(argv[1])) : 1000000);
+	srand(42);
+	{
+		std::vector<int> keys;
+		std::vector<int> probes;
+		for (size_t i = 0; i < n; ++i)
+			keys.push_back(static_cast<int>(i));
+		for (size_t i = n - 1; i > 0; --i)
+			std::swap(keys[i], keys[rand() % (i + 1)]);
+		for (size_t i = 0; i < 2000000; ++i)
+			probes.push_back(rand() % static_cast<int>(n * 2));
+		compare("dense int", keys, probes);
+	}
+	{
+		std::vector<unsigned long long> keys;
+		std::vector<unsigned long long> probes;
+		for (size_t i = 0; i < n; ++i)
+			keys.push_back(rand64());
+		for (size_t i = 0; i < 2000000; ++i)
+			probes.push_back(i % 2 ? keys[rand() % n] : rand64());
+		compare("sparse uint64", keys, probes);
+	}
+	{
+		const char* hosts[] = { "https://www.example.com/", "https://www.example.org/", "https://static.example.net/assets/" };
+		std::vector<std::string> keys;
+		std::vector<std::string> probes;
+		char buf[64];
+		for (size_t i = 0; i < n; ++i)
+		{
+			std::sprintf(buf, "%s/item/%u", (rand() % 2 ? "users" : "posts"), static_cast<unsigned>(rand() % (n * 4)));
+			keys.push_back(std::string(hosts[rand() % 3]) + buf);
+		}
+		for (size_t i = 0; i < 2000000; ++i)
+			probes.push_back(i % 2 ? keys[rand() % n] : keys[rand() % n] + "x");
+		compare("url string", keys, probes);
+	}
+	return (0);
+}
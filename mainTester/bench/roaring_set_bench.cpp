@@ -0,0 +1,141 @@
+#include "roaring_set.hpp"
+#include "set.hpp"
+#include <cstdlib>
+#include <iostream>
+#include <iterator>
+#include <algorithm>
+#include <vector>
+#include <malloc.h>
+#include <sys/time.h>
+
+// 32-bit ids in ft::set and ft::roaring_set: heap bytes per id (glibc mallinfo2), random
+// inserts, count() on random ids (half present), a full ordered scan, then union and
+// intersection of two such sets (set_union / set_intersection into an ft::set for the
+// tree). Ids are dense (a quarter of [0, 4N)), sparse (anywhere in 32 bits) or mostly
+// consecutive blocks, after optimize(); the roaring_set is also built at once by its
+// range constructor. N is the first argument (default 4M).
+
+double now_ms()
+{
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+	return (tv.tv_sec * 1000.0 + tv.tv_usec / 1000.0);
+}
+
+size_t heap_bytes()
+{
+	return (mallinfo2().uordblks);
+}
+
+unsigned int rand32()
+{
+	return ((static_cast<unsigned int>(rand()) << 16) ^ static_cast<unsigned int>(rand()));
+}
+
+std::vector<unsigned int> make_ids(const char* kind, size_t n)
+{
+	std::vector<unsigned int> ids;
+	ids.reserve(n);
+	for (size_t i = 0; i < n; ++i)
+	{
+		if (kind[0] == 'd')
+			ids.push_back(rand32() % static_cast<unsigned int>(4 * n));
+		else if (kind[0] == 's')
+			ids.push_back(rand32());
+		else
+			ids.push_back(static_cast<unsigned int>(i + i / 1000 * 50));
+	}
+	std::random_shuffle(ids.begin(), ids.end());
+	return (ids);
+}
+
+template <typename Set>
+void optimize(Set&) {}
+void optimize(ft::roaring_set& st) { st.optimize(); }
+
+template <typename Set>
+void row(const char* label, const std::vector<unsigned int>& ids, const std::vector<unsigned int>& probes)
+{
+	size_t before = heap_bytes();
+	double start = now_ms();
+	Set* st = new Set();
+	for (size_t i = 0; i < ids.size(); ++i)
+		st->insert(ids[i]);
+	optimize(*st);
+	double insert = now_ms() - start;
+	size_t bytes = heap_bytes() - before;
+	start = now_ms();
+	size_t found = 0;
+	for (size_t i = 0; i < probes.size(); ++i)
+		found += st->count(probes[i]);
+	double count = now_ms() - start;
+	start = now_ms();
+	unsigned long long sum = 0;
+	for (typename Set::const_iterator it = st->begin(); it != st->end(); ++it)
+		sum += *it;
+	double scan = now_ms() - start;
+	std::cout << label << "\t" << static_cast<double>(bytes) / st->size() << " B/id\tinsert " << insert << " ms\tcount " << count
+		<< " ms\tscan " << scan << " ms\t(" << st->size() << " ids, " << found << " found, " << sum % 1000 << ")" << std::endl;
+	delete st;
+}
+
+void set_ops(const char* kind, size_t n)
+{
+	std::vector<unsigned int> a = make_ids(kind, n);
+	std::vector<unsigned int> b = make_ids(kind, n);
+	ft::set<unsigned int> ta(a.begin(), a.end());
+	ft::set<unsigned int> tb(b.begin(), b.end());
+	ft::roaring_set ra(a.begin(), a.end());
+	ft::roaring_set rb(b.begin(), b.end());
+	ra.optimize();
+	rb.optimize();
+
+	double start = now_ms();
+	ft::set<unsigned int> tu;
+	std::set_union(ta.begin(), ta.end(), tb.begin(), tb.end(), std::inserter(tu, tu.end()));
+	double tree_union = now_ms() - start;
+	start = now_ms();
+	ft::set<unsigned int> ti;
+	std::set_intersection(ta.begin(), ta.end(), tb.begin(), tb.end(), std::inserter(ti, ti.end()));
+	double tree_inter = now_ms() - start;
+	start = now_ms();
+	ft::roaring_set ru(ra);
+	ru |= rb;
+	double roaring_union = now_ms() - start;
+	start = now_ms();
+	ft::roaring_set ri(ra);
+	ri &= rb;
+	double roaring_inter = now_ms() - start;
+	std::cout << kind << " a|b\tft::set " << tree_union << " ms, roaring_set " << roaring_union << " ms (x" << tree_union / roaring_union
+		<< ")\ta&b\tft::set " << tree_inter << " ms, roaring_set " << roaring_inter << " ms (x" << tree_inter / roaring_inter
+		<< ")\t(" << tu.size() << "/" << ru.size() << ", " << ti.size() << "/" << ri.size() << ")" << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+	size_t n = (argc > 1 ? static_cast<size_t>(std::atol(argv[1])) : 4000000);
+	const char* kinds[] = { "dense", "sparse", "blocks" };
+	srand(42);
+	std::cout << n << " ids" << std::endl;
+	for (size_t k = 0; k < 3; ++k)
+	{
+		std::vector<unsigned int> ids = make_ids(kinds[k], n);
+		std::vector<unsigned int> probes;
+		for (size_t i = 0; i < n; ++i)
+			probes.push_back(i % 2 ? ids[i] : rand32());
+		std::cout << kinds[k] << std::endl;
+		row< ft::set<unsigned int> >("  ft::set\t", ids, probes);
+		row<ft::roaring_set>("  roaring_set\t", ids, probes);
+		double start = now_ms();
+		ft::roaring_set st(ids.begin(), ids.end());
+		st.optimize();
+		std::cout << "  roaring_set(first, last) " << now_ms() - start << " ms";
+		size_t counts[3];
+		st.chunk_counts(counts);
+		std::cout << ", chunks: " << counts[0] << " arrays, " << counts[1] << " bitmaps, " << counts[2] << " runs; bytes_used "
+			<< static_cast<double>(st.bytes_used()) / st.size() << " B/id" << std::endl;
+	}
+	for (size_t k = 0; k < 3; ++k)
+		set_ops(kinds[k], n / 2);
+	return (0);
+}
@@ -0,0 +1,38 @@
+#include "small_map.hpp"
+#include <ctime>
+#include <iostream>
+#include <map>
+
+// create, fill with a few entries, look them up and destroy, as a per-request map does
+
+#define ROUNDS 1000000
+
+template <typename Map>
+void run(const char* name, int entries)
+{
+	clock_t start = clock();
+	long sum = 0;
+	for (int r = 0; r < ROUNDS; ++r)
+	{
+		Map mp;
+		for (int i = 0; i < entries; ++i)
+			mp[(i * 7 + r) % 64] = i;
+		for (int i = 0; i < entries; ++i)
+			sum += mp.count(i * 3 % 64);
+		sum += mp.size();
+	}
+	double ms = static_cast<double>(clock() - start) * 1000 / CLOCKS_PER_SEC;
+	std::cout << name << "\t" << entries << " entries\t" << ms << " ms\t" << (ms * 1e6 / ROUNDS) << " ns/map\t(" << sum << ")" << std::endl;
+}
+
+int main()
+{
+	int sizes[] = {0, 4, 8, 16, 24};
+	for (size_t i = 0; i < sizeof(sizes) / sizeof(*sizes); ++i)
+	{
+		run< ft::map<int, int> >("ft::map", sizes[i]);
+		run< ft::small_map<int, int> >("ft::small_map<16>", sizes[i]);
+		run< std::map<int, int> >("std::map", sizes[i]);
+	}
+	return (0);
+}
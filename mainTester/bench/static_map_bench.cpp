@@ -0,0 +1,141 @@
+#include "static_map.hpp"
+#include "map.hpp"
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include <vector>
+
+// lookups in a fixed table: ft::static_map, sorted when compiled, against ft::map::find,
+// which also has to be filled at startup (timed on its own). Tables of 16 to 1024 int
+// keys and 32 C string keywords; the probes are random, half of them hits. Needs C++14:
+// make bench BENCH=static_map_bench CXXSTD=c++14
+
+#define LOOKUPS 20000000
+
+// N int keys, scrambled, with gaps so that misses fall between them
+template <size_t N>
+struct Table {
+	int keys[N];
+	int values[N];
+
+	constexpr Table() : keys(), values()
+	{
+		for (size_t i = 0; i < N; ++i)
+		{
+			keys[i] = static_cast<int>((i * 7919) % N * 2);
+			values[i] = static_cast<int>(i);
+		}
+	}
+};
+
+template <size_t N>
+constexpr ft::static_map<int, int, N> make_table()
+{
+	constexpr Table<N> table;
+	ft::pair<int, int> items[N];
+	for (size_t i = 0; i < N; ++i)
+		items[i] = ft::pair<int, int>(table.keys[i], table.values[i]);
+	return (ft::make_static_map(items));
+}
+
+constexpr ft::static_map<int, int, 16> table16 = make_table<16>();
+constexpr ft::static_map<int, int, 64> table64 = make_table<64>();
+constexpr ft::static_map<int, int, 256> table256 = make_table<256>();
+constexpr ft::static_map<int, int, 1024> table1024 = make_table<1024>();
+
+constexpr const char* keywords[] = { "while", "auto", "break", "case", "char", "const", "continue", "default", "do", "double",
+	"else", "enum", "extern", "float", "for", "goto", "if", "int", "long", "register", "return", "short", "signed", "sizeof",
+	"static", "struct", "switch", "typedef", "union", "unsigned", "void", "volatile" };
+constexpr int ids[] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26,
+	27, 28, 29, 30, 31 };
+
+constexpr ft::static_map<const char*, int, 32, ft::cstr_less> make_keywords()
+{
+	ft::pair<const char*, int> items[32];
+	for (size_t i = 0; i < 32; ++i)
+		items[i] = ft::pair<const char*, int>(keywords[i], ids[i]);
+	return (ft::make_static_map<const char*, int, ft::cstr_less>(items));
+}
+
+constexpr ft::static_map<const char*, int, 32, ft::cstr_less> keyword_table = make_keywords();
+
+double elapsed_ms(clock_t start)
+{
+	return (static_cast<double>(clock() - start) * 1000 / CLOCKS_PER_SEC);
+}
+
+template <typename Key, typename Table, typename Map>
+void run(const char* label, const Table& table, const std::vector<Key>& probes)
+{
+	clock_t start = clock();
+	Map* mp = new Map();
+	for (typename Table::const_iterator it = table.begin(); it != table.end(); ++it)
+		mp->insert(typename Map::value_type(it->first, it->second));
+	double build = elapsed_ms(start);
+
+	start = clock();
+	long sum = 0;
+	for (size_t r = 0; r < LOOKUPS; r += probes.size())
+	{
+		for (size_t i = 0; i < probes.size(); ++i)
+		{
+			typename Table::const_iterator it = table.find(probes[i]);
+			sum += (it == table.end() ? -1 : it->second);
+		}
+	}
+	double fixed = elapsed_ms(start);
+
+	start = clock();
+	long check = 0;
+	for (size_t r = 0; r < LOOKUPS; r += probes.size())
+	{
+		for (size_t i = 0; i < probes.size(); ++i)
+		{
+			typename Map::const_iterator it = mp->find(probes[i]);
+			check += (it == mp->end() ? -1 : it->second);
+		}
+	}
+	double tree = elapsed_ms(start);
+	delete mp;
+	std::cout << label << "\tstatic_map " << fixed * 1e6 / LOOKUPS << " ns/find\tft::map " << tree * 1e6 / LOOKUPS
+		<< " ns/find (x" << tree / fixed << "), filled in " << build * 1000 << " us\t(" << sum << (sum == check ? " = " : " != ")
+		<< check << ")" << std::endl;
+}
+
+template <size_t N>
+void run_ints(const char* label, const ft::static_map<int, int, N>& table)
+{
+	std::vector<int> probes;
+	for (size_t i = 0; i < 4096; ++i)
+		probes.push_back(rand() % static_cast<int>(2 * N));
+	run<int, ft::static_map<int, int, N>, ft::map<int, int> >(label, table, probes);
+}
+
+int main()
+{
+	srand(42);
+	std::cout << LOOKUPS << " lookups" << std::endl;
+	run_ints("16 ints", table16);
+	run_ints("64 ints", table64);
+	run_ints("256 ints", table256);
+	run_ints("1024 ints", table1024);
+
+	// keys copied out of the literals, so that no lookup can match on the address
+	static char words[64][16];
+	std::vector<const char*> probes;
+	for (size_t i = 0; i < 64; ++i)
+	{
+		const char* src = (i % 2 ? keywords[i / 2] : "identifier");
+		size_t len = 0;
+		for (; src[len] != '\0'; ++len)
+			words[i][len] = src[len];
+		words[i][len] = '\0';
+		if (i % 4 == 0)
+			words[i][0] = static_cast<char>('a' + i / 4);
+	}
+	for (size_t i = 0; i < 4096; ++i)
+		probes.push_back(words[rand() % 64]);
+	run<const char*, ft::static_map<const char*, int, 32, ft::cstr_less>, ft::map<const char*, int, ft::cstr_less> >("32 keywords",
+		keyword_table, probes);
+	return (0);
+}
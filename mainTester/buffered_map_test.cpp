@@ -0,0 +1,83 @@
+#include "buffered_map.hpp"
+#include <iostream>
+#include <map>
+
+#ifndef TESTED_NAMESPACE
+#define TESTED_NAMESPACE ft
+#endif
+
+// std::map stand-in for the oracle run: no buffer, every write lands at once
+template <typename K, typename V>
+class unbuffered_map : public std::map<K, V> {
+	public :
+		explicit unbuffered_map(size_t) {}
+		void flush() {}
+		void set_buffer_size(size_t) {}
+};
+
+template <typename K, typename V>
+struct select_ft { typedef ft::buffered_map<K, V> map; };
+template <typename K, typename V>
+struct select_std { typedef unbuffered_map<K, V> map; };
+#define SELECT_(ns) select_##ns
+#define SELECT(ns) SELECT_(ns)
+
+#define T1 int
+#define T2 int
+#define TESTED_MAP SELECT(TESTED_NAMESPACE)<T1, T2>::map
+
+template <typename T>
+void printContainers(T const &mp) {
+	std::cout << "size: " << mp.size() << std::endl;
+	for (typename T::const_iterator it = mp.begin(); it != mp.end(); ++it)
+		std::cout << "- key: " << it->first << " | value: " << it->second << std::endl;
+	std::cout << "###############################################" << std::endl;
+}
+
+int main() {
+	std::cout << "===== insert through the buffer =====" << std::endl;
+	TESTED_MAP mp(8);
+	std::cout << "empty: " << mp.empty() << std::endl;
+	for (int i = 0; i < 30; ++i)
+		mp.insert(TESTED_NAMESPACE::make_pair(i * 7 % 31, i));
+	mp.insert(TESTED_NAMESPACE::make_pair(7, -1));
+	mp.insert(TESTED_NAMESPACE::make_pair(100, 100));
+	mp.insert(TESTED_NAMESPACE::make_pair(100, -100));
+	printContainers(mp);
+
+	std::cout << "===== find | count | bounds =====" << std::endl;
+	for (int k = -1; k < 35; k += 6)
+		std::cout << k << ": count " << mp.count(k) << ", find " << (mp.find(k) == mp.end() ? -1 : mp.find(k)->second)
+			<< ", lower_bound " << (mp.lower_bound(k) == mp.end() ? -1 : mp.lower_bound(k)->first)
+			<< ", upper_bound " << (mp.upper_bound(k) == mp.end() ? -1 : mp.upper_bound(k)->first) << std::endl;
+	mp.insert(TESTED_NAMESPACE::make_pair(-5, 5));
+	std::cout << "pending -5: count " << mp.count(-5) << ", begin " << mp.begin()->first << std::endl;
+
+	std::cout << "===== erase | reverse =====" << std::endl;
+	for (int k = 0; k < 40; k += 4)
+		std::cout << mp.erase(k);
+	std::cout << std::endl;
+	mp.insert(TESTED_NAMESPACE::make_pair(4, 44));
+	mp.erase(mp.find(5));
+	for (typename TESTED_MAP::const_reverse_iterator it = mp.rbegin(); it != mp.rend(); ++it)
+		std::cout << it->first << " ";
+	std::cout << std::endl;
+
+	std::cout << "===== flush | copy | swap =====" << std::endl;
+	mp.flush();
+	TESTED_MAP cp(mp);
+	cp.insert(TESTED_NAMESPACE::make_pair(50, 50));
+	TESTED_MAP other(4);
+	other.insert(TESTED_NAMESPACE::make_pair(1, 1));
+	other.swap(cp);
+	mp.set_buffer_size(2);
+	mp.insert(TESTED_NAMESPACE::make_pair(60, 60));
+	mp.insert(TESTED_NAMESPACE::make_pair(61, 61));
+	std::cout << "equal: " << (mp == other) << ", less: " << (mp < other) << std::endl;
+	printContainers(other);
+	printContainers(cp);
+	printContainers(mp);
+	mp.clear();
+	std::cout << "cleared: " << mp.size() << " " << mp.empty() << std::endl;
+	return (0);
+}
@@ -0,0 +1,77 @@
+// built with -DFT_HOT_COUNTERS (see the test target), so ft containers keep their counts
+// while every other tester stays on the default, empty policy
+#include "map.hpp"
+#include <iostream>
+#include <map>
+
+#ifndef TESTED_NAMESPACE
+#define TESTED_NAMESPACE ft
+#endif
+
+// a red-black tree of n nodes is at most 2 * log2(n + 1) high
+static size_t maxHeight(size_t n)
+{
+	size_t h = 0;
+	while (n > 0)
+	{
+		n >>= 1;
+		++h;
+	}
+	return (2 * h);
+}
+
+// one descent per operation, with a few extra comparisons to spare
+static bool withinDescents(size_t comparisons, size_t ops, size_t n)
+{
+	return (comparisons > 0 && comparisons <= ops * 2 * (maxHeight(n) + 1));
+}
+
+// std has no hot counters: the exact numbers move with any change to the descents or
+// the rebalancing, so ft is checked against the bounds every red-black tree meets
+void hotCountersTest(std::map<int, int>*)
+{
+	std::cout << "inserts: comparisons 1, rotations 1" << std::endl;
+	std::cout << "erases: comparisons 1, rotations 1, one free per erase 1" << std::endl;
+	std::cout << "reset while shared: 0 0, still shared 1, copy 0" << std::endl;
+	std::cout << "finds: comparisons 1, rotations 0" << std::endl;
+	std::cout << "iterator steps: one per element 1" << std::endl;
+}
+
+void hotCountersTest(ft::map<int, int>*)
+{
+	ft::map<int, int> mp;
+	mp.enable_copy_on_write();
+	for (int i = 0; i < 200; ++i)
+		mp.insert(ft::make_pair(i * 37 % 211, i));
+	ft::HotCounters c = mp.hot_counters();
+	std::cout << "inserts: comparisons " << withinDescents(c.comparisons, 200, 200)
+		<< ", rotations " << (c.rotations > 0 && c.rotations <= 2 * 200) << std::endl;
+	mp.reset_hot_counters();
+	size_t erased = 0;
+	for (int i = 0; i < 100; ++i)
+		erased += mp.erase(i);
+	c = mp.hot_counters();
+	std::cout << "erases: comparisons " << withinDescents(c.comparisons, 100, 200)
+		<< ", rotations " << (c.rotations > 0 && c.rotations <= 3 * 100) << ", one free per erase " << (c.node_frees == erased) << std::endl;
+	ft::map<int, int> copy(mp);
+	mp.reset_hot_counters();
+	c = mp.hot_counters();
+	std::cout << "reset while shared: " << c.comparisons << " " << c.rotations << ", still shared " << mp.shares_tree()
+		<< ", copy " << copy.hot_counters().comparisons << std::endl;
+	const ft::map<int, int>& view = mp;
+	for (int i = 0; i < 211; i += 5)
+		view.find(i);
+	c = mp.hot_counters();
+	std::cout << "finds: comparisons " << withinDescents(c.comparisons, 43, mp.size())
+		<< ", rotations " << c.rotations << std::endl;
+	size_t before = ft::hot_iterator_steps();
+	for (ft::map<int, int>::const_iterator it = view.begin(); it != view.end(); ++it)
+		;
+	std::cout << "iterator steps: one per element " << (ft::hot_iterator_steps() - before == mp.size()) << std::endl;
+}
+
+int main() {
+	std::cout << "################ Test Hot Counters ################" << std::endl;
+	std::cout << "===== map =====" << std::endl;
+	hotCountersTest(static_cast<TESTED_NAMESPACE::map<int, int>*>(NULL));
+}
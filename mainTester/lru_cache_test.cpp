@@ -0,0 +1,310 @@
+#include "lru_cache.hpp"
+#include <iostream>
+#include <string>
+#include <list>
+#include <map>
+
+#ifndef TESTED_NAMESPACE
+#define TESTED_NAMESPACE ft
+#endif
+
+// std has no LRU cache: ft::lru_cache is checked against the usual std::list plus std::map
+// of list positions, with the same interface
+template <class Key, class T, class Weigher = ft::unit_weight>
+class std_lru_cache {
+	public :
+		typedef Key	key_type;
+		typedef T	mapped_type;
+		typedef std::pair<const Key, T>	value_type;
+		typedef typename std::list<value_type>::iterator	iterator;
+		typedef typename std::list<value_type>::const_iterator	const_iterator;
+		typedef typename std::list<value_type>::const_reverse_iterator	const_reverse_iterator;
+
+	private:
+		std::list<value_type>	_list;
+		std::map<Key, iterator>	_index;
+		size_t	_weight;
+		size_t	_capacity;
+		size_t	_hits;
+		size_t	_misses;
+		size_t	_evictions;
+		Weigher	_weigher;
+
+		void drop(iterator it)
+		{
+			this->_weight -= this->_weigher(it->first, it->second);
+			this->_index.erase(it->first);
+			this->_list.erase(it);
+		}
+
+		void evict()
+		{
+			while (!this->_list.empty() && this->_weight > this->_capacity)
+			{
+				drop(--this->_list.end());
+				++this->_evictions;
+			}
+		}
+
+	public:
+		explicit std_lru_cache(size_t capacity) : _weight(0), _capacity(capacity), _hits(0), _misses(0), _evictions(0) {}
+
+		std_lru_cache(const std_lru_cache& x) : _weight(0), _capacity(x._capacity), _hits(x._hits), _misses(x._misses), _evictions(x._evictions)
+		{
+			for (const_reverse_iterator it = x._list.rbegin(); it != x._list.rend(); ++it)
+				put(it->first, it->second);
+		}
+
+		std_lru_cache& operator=(const std_lru_cache& x)
+		{
+			std_lru_cache tmp(x);
+			swap(tmp);
+			return (*this);
+		}
+
+		iterator begin() { return (this->_list.begin()); }
+		iterator end() { return (this->_list.end()); }
+		const_iterator begin() const { return (this->_list.begin()); }
+		const_iterator end() const { return (this->_list.end()); }
+		const_reverse_iterator rbegin() const { return (this->_list.rbegin()); }
+		const_reverse_iterator rend() const { return (this->_list.rend()); }
+		bool empty() const { return (this->_list.empty()); }
+		size_t size() const { return (this->_list.size()); }
+		size_t capacity() const { return (this->_capacity); }
+		size_t weight() const { return (this->_weight); }
+		size_t hits() const { return (this->_hits); }
+		size_t misses() const { return (this->_misses); }
+		size_t evictions() const { return (this->_evictions); }
+		size_t count(const Key& k) const { return (this->_index.count(k)); }
+
+		T* get(const Key& k)
+		{
+			typename std::map<Key, iterator>::iterator found = this->_index.find(k);
+			if (found == this->_index.end())
+			{
+				++this->_misses;
+				return (NULL);
+			}
+			++this->_hits;
+			this->_list.splice(this->_list.begin(), this->_list, found->second);
+			return (&found->second->second);
+		}
+
+		const T* peek(const Key& k) const
+		{
+			typename std::map<Key, iterator>::const_iterator found = this->_index.find(k);
+			return (found == this->_index.end() ? NULL : &found->second->second);
+		}
+
+		iterator find(const Key& k)
+		{
+			typename std::map<Key, iterator>::iterator found = this->_index.find(k);
+			return (found == this->_index.end() ? end() : found->second);
+		}
+
+		bool put(const Key& k, const T& v)
+		{
+			size_t w = this->_weigher(k, v);
+			typename std::map<Key, iterator>::iterator found = this->_index.find(k);
+			bool added = (found == this->_index.end());
+			if (!added)
+				drop(found->second);
+			if (w > this->_capacity)
+				return (false);
+			this->_list.push_front(value_type(k, v));
+			this->_index[k] = this->_list.begin();
+			this->_weight += w;
+			evict();
+			return (added);
+		}
+
+		size_t erase(const Key& k)
+		{
+			typename std::map<Key, iterator>::iterator found = this->_index.find(k);
+			if (found == this->_index.end())
+				return (0);
+			drop(found->second);
+			return (1);
+		}
+
+		void erase(iterator position)
+		{
+			drop(position);
+		}
+
+		void clear()
+		{
+			this->_list.clear();
+			this->_index.clear();
+			this->_weight = 0;
+		}
+
+		void set_capacity(size_t capacity)
+		{
+			this->_capacity = capacity;
+			evict();
+		}
+
+		void reset_stats()
+		{
+			this->_hits = 0;
+			this->_misses = 0;
+			this->_evictions = 0;
+		}
+
+		void swap(std_lru_cache& x)
+		{
+			this->_list.swap(x._list);
+			this->_index.swap(x._index);
+			std::swap(this->_weight, x._weight);
+			std::swap(this->_capacity, x._capacity);
+			std::swap(this->_hits, x._hits);
+			std::swap(this->_misses, x._misses);
+			std::swap(this->_evictions, x._evictions);
+		}
+};
+
+// weighs an entry by its string's length, to bound a cache by bytes
+struct ByLength {
+	size_t operator()(int, const std::string& s) const
+	{
+		return (s.size());
+	}
+};
+
+template <typename K, typename V, typename W = ft::unit_weight>
+struct select_ft { typedef ft::lru_cache<K, V, ft::checked_hash<K>, W> cache; };
+template <typename K, typename V, typename W = ft::unit_weight>
+struct select_std { typedef std_lru_cache<K, V, W> cache; };
+#define SELECT_(ns) select_##ns
+#define SELECT(ns) SELECT_(ns)
+
+#define INT_CACHE SELECT(TESTED_NAMESPACE)<int, std::string>::cache
+#define STRING_CACHE SELECT(TESTED_NAMESPACE)<std::string, int>::cache
+#define BYTE_CACHE SELECT(TESTED_NAMESPACE)<int, std::string, ByLength>::cache
+
+template <typename T>
+void printContainers(T const &lru) {
+	std::cout << "size: " << lru.size() << ", weight: " << lru.weight() << "/" << lru.capacity()
+		<< ", hits: " << lru.hits() << ", misses: " << lru.misses() << ", evictions: " << lru.evictions() << std::endl;
+	for (typename T::const_iterator it = lru.begin(); it != lru.end(); ++it)
+		std::cout << it->first << ":" << (*it).second << " ";
+	std::cout << std::endl;
+	for (typename T::const_reverse_iterator it = lru.rbegin(); it != lru.rend(); ++it)
+		std::cout << it->first << " ";
+	std::cout << std::endl << "------------------------" << std::endl;
+}
+
+template <typename T, typename K>
+void printGet(T &lru, const K& k) {
+	typename T::mapped_type* v = lru.get(k);
+	std::cout << "get(" << k << "): ";
+	if (v == NULL)
+		std::cout << "miss" << std::endl;
+	else
+		std::cout << *v << std::endl;
+}
+
+int main() {
+	std::cout << "################ Test LRU Cache ################" << std::endl;
+	std::cout << "===== put | get | evict =====" << std::endl;
+	INT_CACHE lru(4);
+	std::cout << "empty: " << lru.empty() << std::endl;
+	for (int i = 1; i <= 4; ++i)
+		std::cout << lru.put(i, std::string(i, 'a' + i));
+	std::cout << std::endl;
+	printContainers(lru);
+	printGet(lru, 2);
+	printGet(lru, 9);
+	std::cout << "put(5): " << lru.put(5, "five") << std::endl;
+	printContainers(lru);
+	printGet(lru, 1);
+	std::cout << "put(3) again: " << lru.put(3, "three") << std::endl;
+	printContainers(lru);
+	std::cout << "peek(4): " << *lru.peek(4) << ", peek(1): " << (lru.peek(1) == NULL) << ", count(5): " << lru.count(5) << std::endl;
+	printContainers(lru);
+	*lru.get(4) += "!";
+	lru.find(5)->second = "FIVE";
+	printContainers(lru);
+	for (int i = 6; i < 20; ++i)
+	{
+		lru.put(i, std::string(1, 'A' + i));
+		if (i % 3 == 0)
+			lru.get(i - 2);
+	}
+	printContainers(lru);
+
+	std::cout << "===== erase | clear | capacity =====" << std::endl;
+	std::cout << "erase: " << lru.erase(18) << lru.erase(18) << lru.erase(100) << std::endl;
+	lru.erase(lru.begin());
+	printContainers(lru);
+	lru.set_capacity(1);
+	printContainers(lru);
+	lru.set_capacity(3);
+	lru.put(30, "x");
+	lru.put(31, "y");
+	printContainers(lru);
+	lru.clear();
+	printContainers(lru);
+	lru.reset_stats();
+	lru.put(1, "one");
+	printContainers(lru);
+	INT_CACHE none(0);
+	std::cout << "capacity 0: " << none.put(1, "one") << " " << none.size() << " " << (none.get(1) == NULL) << std::endl;
+
+	std::cout << "===== copy | swap =====" << std::endl;
+	INT_CACHE big(100);
+	for (int i = 0; i < 300; ++i)
+		big.put(i * 7 % 250, std::string(1, 'a' + i % 26));
+	for (int i = 0; i < 250; i += 3)
+		big.get(i);
+	INT_CACHE copy(big);
+	printContainers(copy);
+	copy.put(1000, "new");
+	lru = copy;
+	std::cout << "assigned: " << lru.size() << " " << lru.begin()->first << std::endl;
+	lru.swap(big);
+	std::cout << "swapped: " << lru.size() << " " << lru.begin()->first << " " << big.size() << " " << big.begin()->first << std::endl;
+	INT_CACHE small(2);
+	small.put(7, "seven");
+	small.swap(big);
+	printContainers(big);
+	std::cout << "after swap: " << small.size() << " " << (small.get(1000) != NULL) << " " << (small.get(7) == NULL) << std::endl;
+	INT_CACHE empty(5);
+	empty.swap(big);
+	printContainers(big);
+	printContainers(empty);
+	big.put(3, "three");
+	printContainers(big);
+
+	std::cout << "===== string keys =====" << std::endl;
+	STRING_CACHE words(50);
+	const char* text[] = { "the", "quick", "brown", "fox", "jumps", "over", "the", "lazy", "dog" };
+	for (int round = 0; round < 40; ++round)
+	{
+		for (int i = 0; i < 9; ++i)
+		{
+			std::string w = text[i] + std::string(1, 'a' + (round * 7 + i) % 13);
+			int* seen = words.get(w);
+			if (seen == NULL)
+				words.put(w, 1);
+			else
+				++*seen;
+		}
+	}
+	printContainers(words);
+
+	std::cout << "===== byte weight =====" << std::endl;
+	BYTE_CACHE bytes(20);
+	std::cout << bytes.put(1, "12345") << bytes.put(2, "1234567890") << bytes.put(3, "1234") << std::endl;
+	printContainers(bytes);
+	std::cout << "grow 1: " << bytes.put(1, "123456789") << std::endl;
+	printContainers(bytes);
+	std::cout << "too heavy: " << bytes.put(4, std::string(21, 'x')) << bytes.put(1, std::string(30, 'y')) << std::endl;
+	printContainers(bytes);
+	std::cout << "fill: " << bytes.put(5, std::string(20, 'z')) << std::endl;
+	printContainers(bytes);
+	std::cout << "empty value: " << bytes.put(6, "") << bytes.put(7, "") << std::endl;
+	printContainers(bytes);
+	return (0);
+}
@@ -3,6 +3,7 @@
 #include <string>
 #include <list>
 #include <map>
+#include <vector>
 
 #ifndef TESTED_NAMESPACE
 #define TESTED_NAMESPACE ft
@@ -13,6 +14,558 @@
 #define T3 TESTED_NAMESPACE::map<T1, T2>::value_type
 #define T_SIZE_TYPE typename TESTED_NAMESPACE::map<T1, T2>::size_type
 
+// maps on the other balancing policies, diffed against a plain std::map
+template <typename Balance>
+struct select_ft { typedef ft::map<int, int, ft::less<int>, std::allocator< ft::pair<const int, int> >, Balance> map; };
+template <typename Balance>
+struct select_std { typedef std::map<int, int> map; };
+#define SELECT_(ns) select_##ns
+#define SELECT(ns) SELECT_(ns)
+
+// the find cache only exists on ft::map, std::map runs the same sequence uncached
+template <typename Map>
+void enableFindCache(Map&) {}
+
+template <typename K, typename V>
+void enableFindCache(ft::map<K, V>& mp) { mp.enable_find_cache(8); }
+
+template <typename Map>
+void findCacheTest()
+{
+	Map mp;
+	enableFindCache(mp);
+	for (int i = 0; i < 100; ++i)
+		mp[i] = i * i;
+	long sum = 0;
+	for (int round = 0; round < 5; ++round)
+		for (int i = 0; i < 120; i += 7)
+			sum += (mp.find(i) == mp.end() ? -1 : mp.find(i)->second) + static_cast<long>(mp.count(i));
+	std::cout << "hot finds: " << sum << std::endl;
+	for (int i = 0; i < 100; i += 7)
+		mp.erase(i);
+	mp.erase(mp.find(1));
+	std::cout << "after erase: " << (mp.find(7) == mp.end()) << (mp.find(1) == mp.end()) << (mp.find(2) == mp.end()) << std::endl;
+	mp[7] = 70;
+	std::cout << "reinserted: " << mp.find(7)->second << ", count " << mp.count(7) << std::endl;
+	Map other;
+	other[7] = 700;
+	mp.swap(other);
+	std::cout << "after swap: " << mp.find(7)->second << ", " << other.find(7)->second << ", " << (mp.find(2) == mp.end()) << std::endl;
+	mp.clear();
+	std::cout << "after clear: " << (mp.find(7) == mp.end()) << std::endl;
+}
+
+// parallel traversal only exists on ft::map, std::map gets the sequential loop
+struct SquareValue {
+	template <typename V>
+	long operator()(const V& val) const { return (static_cast<long>(val.second) * val.second); }
+};
+struct AddLong {
+	long operator()(long a, long b) const { return (a + b); }
+};
+struct Increment {
+	template <typename V>
+	void operator()(V& val) const { val.second += 1; }
+};
+
+long sumSquares(const std::map<int, int>& mp)
+{
+	long sum = 0;
+	for (std::map<int, int>::const_iterator it = mp.begin(); it != mp.end(); ++it)
+		sum += SquareValue()(*it);
+	return (sum);
+}
+long sumSquares(const ft::map<int, int>& mp) { return (mp.parallel_reduce(0L, AddLong(), SquareValue(), 4)); }
+
+void incrementAll(std::map<int, int>& mp)
+{
+	for (std::map<int, int>::iterator it = mp.begin(); it != mp.end(); ++it)
+		Increment()(*it);
+}
+void incrementAll(ft::map<int, int>& mp) { mp.parallel_for_each(Increment(), 4); }
+
+template <typename It>
+void bulkLoad(std::map<int, int>& mp, It first, It last) { mp.insert(first, last); }
+template <typename It>
+void bulkLoad(ft::map<int, int>& mp, It first, It last) { mp.bulk_load(first, last, 3); }
+
+template <typename Map>
+void parallelTest()
+{
+	Map mp;
+	std::cout << "empty: " << sumSquares(mp) << std::endl;
+	for (int i = 0; i < 20000; ++i)
+		mp[i * 7 % 20011] = i % 1000;
+	std::cout << "sum of squares: " << sumSquares(mp) << std::endl;
+	incrementAll(mp);
+	std::cout << "after increment: " << sumSquares(mp) << ", first " << mp.begin()->second << ", last " << (--mp.end())->second << std::endl;
+
+	std::list<typename Map::value_type> input;
+	for (int i = 0; i < 30000; ++i)
+		input.push_back(typename Map::value_type(i * 13 % 25013, -i));
+	bulkLoad(mp, input.begin(), input.end());
+	std::cout << "bulk load: size " << mp.size() << ", sum of squares " << sumSquares(mp) << ", [5] " << mp[5]
+		<< ", [25012] " << mp[25012] << ", last " << (--mp.end())->first << std::endl;
+}
+
+// compaction only exists on ft::map, std::map runs the same sequence without it
+void compactStep(std::map<int, int>&, size_t) {}
+void compactStep(ft::map<int, int>& mp, size_t budget) { mp.compact_step(budget); }
+void compactAll(std::map<int, int>&, bool) {}
+void compactAll(ft::map<int, int>& mp, bool veb) { mp.compact(veb ? ft::VEB_ORDER : ft::IN_ORDER); }
+
+template <typename Map>
+void compactTest()
+{
+	Map mp;
+	for (int i = 0; i < 3000; ++i)
+		mp[i * 17 % 3001] = i;
+	for (int i = 0; i < 3000; i += 4)
+		mp.erase(i);
+	for (int round = 0; round < 40; ++round)
+	{
+		compactStep(mp, 100);
+		mp.erase(round * 61);
+		mp[5000 + round] = round;
+	}
+	compactAll(mp, false);
+	for (int i = 1; i < 3000; i += 5)
+		mp.erase(i);
+	compactAll(mp, true);
+	long sum = 0;
+	for (typename Map::iterator it = mp.begin(); it != mp.end(); ++it)
+		sum += it->first - it->second;
+	std::cout << "compacted: size " << mp.size() << ", sum " << sum << ", find 2998 " << mp.find(2998)->second
+		<< ", last " << (--mp.end())->first << std::endl;
+}
+
+// lazy erase only exists on ft::map, std::map erases eagerly through the same sequence
+void enableLazyErase(std::map<int, int>&, double) {}
+void enableLazyErase(ft::map<int, int>& mp, double max_dead) { mp.enable_lazy_erase(max_dead); }
+
+template <typename Map>
+void lazyEraseTest()
+{
+	Map mp;
+	enableLazyErase(mp, 0.25);
+	for (int i = 0; i < 1000; ++i)
+		mp[i] = i * 3;
+	typename Map::iterator kept = mp.find(500);
+	for (int i = 0; i < 1000; i += 3)
+		mp.erase(i);
+	mp.erase(mp.find(1), mp.find(40));
+	std::cout << "after erase: size " << mp.size() << ", kept " << kept->first << ", count 3 " << mp.count(3)
+		<< ", lower_bound 300 " << mp.lower_bound(300)->first << ", upper_bound 38 " << mp.upper_bound(38)->first << std::endl;
+	for (int i = 0; i < 60; i += 2)
+		mp.insert(TESTED_NAMESPACE::make_pair(i, -i));
+	std::cout << "reinserted: size " << mp.size() << ", first " << mp.begin()->first << " " << mp.begin()->second
+		<< ", last " << mp.rbegin()->first << std::endl;
+	enableLazyErase(mp, 0);
+	for (int i = 0; i < 1000; i += 5)
+		mp.erase(i);
+	long sum = 0;
+	for (typename Map::reverse_iterator it = mp.rbegin(); it != mp.rend(); ++it)
+		sum += it->first + it->second;
+	std::cout << "eager again: size " << mp.size() << ", sum " << sum << std::endl;
+}
+
+// finger search only exists on ft::map, std::map answers from the root
+std::map<int, int>::iterator findNear(std::map<int, int>& mp, int k) { return (mp.find(k)); }
+ft::map<int, int>::iterator findNear(ft::map<int, int>& mp, int k) { return (mp.find_near(k)); }
+std::map<int, int>::iterator lowerBoundNear(std::map<int, int>& mp, int k) { return (mp.lower_bound(k)); }
+ft::map<int, int>::iterator lowerBoundNear(ft::map<int, int>& mp, int k) { return (mp.lower_bound_near(k)); }
+
+template <typename Map>
+void fingerTest()
+{
+	Map mp;
+	for (int i = 0; i < 2000; i += 2)
+		mp[i] = i / 2;
+	long sum = 0;
+	for (int k = 500; k < 700; ++k)
+		sum += (findNear(mp, k) == mp.end() ? -1 : findNear(mp, k)->second);
+	for (int k = 1997; k > 1900; k -= 3)
+		sum += lowerBoundNear(mp, k)->first;
+	std::cout << "near walk: " << sum << ", jump back " << findNear(mp, 4)->second << ", past end "
+		<< (lowerBoundNear(mp, 5000) == mp.end()) << std::endl;
+	mp.erase(10);
+	mp.erase(12);
+	std::cout << "after erase: " << lowerBoundNear(mp, 9)->first << " " << (findNear(mp, 12) == mp.end())
+		<< " " << lowerBoundNear(mp, 11)->first << std::endl;
+}
+
+// copy-on-write only exists on ft::map, std::map copies deep and gives the same results
+void enableCopyOnWrite(std::map<int, int>&) {}
+void enableCopyOnWrite(ft::map<int, int>& mp) { mp.enable_copy_on_write(); }
+
+template <typename Map>
+void copyOnWriteTest()
+{
+	Map mp;
+	enableCopyOnWrite(mp);
+	for (int i = 0; i < 100; ++i)
+		mp[i] = i;
+	Map reader(mp);
+	Map writer;
+	writer = reader;
+	const Map& view = reader;
+	std::cout << "shared: " << view.size() << " " << view.find(42)->second << " " << view.rbegin()->first << std::endl;
+	writer[42] = -42;
+	writer.erase(writer.find(10));
+	writer.erase(writer.find(50), writer.find(60));
+	Map third(writer);
+	mp.erase(0);
+	mp.insert(mp.end(), TESTED_NAMESPACE::make_pair(200, 200));
+	third.clear();
+	std::cout << "after writes: " << mp.size() << " " << mp.begin()->first << " | " << reader.size() << " "
+		<< reader.find(42)->second << " " << reader.count(10) << " | " << writer.size() << " " << writer.find(42)->second
+		<< " " << writer.count(55) << " | " << third.size() << std::endl;
+	// an iterator that can write takes the tree for this map alone
+	Map fourth(reader);
+	reader.find(5)->second = -5;
+	reader.begin()->second = -1;
+	reader.lower_bound(7)->second = -7;
+	reader.rbegin()->second = -99;
+	std::cout << "written through iterators: " << view.find(5)->second << " " << view.begin()->second << " "
+		<< view.find(7)->second << " " << view.rbegin()->second << " | " << fourth.count(5) << " " << fourth[5] << " "
+		<< fourth[0] << " " << fourth[7] << " " << fourth[99] << std::endl;
+}
+
+// the Bloom filter only exists on ft::map; it must not change any answer
+void enableBloomFilter(std::map<int, int>&, size_t) {}
+void enableBloomFilter(ft::map<int, int>& mp, size_t expected) { mp.enable_bloom_filter(expected, 4); }
+
+template <typename Map>
+void bloomFilterTest()
+{
+	Map mp;
+	enableBloomFilter(mp, 16);
+	for (int i = 0; i < 300; i += 3)
+		mp[i] = i;
+	mp.insert(TESTED_NAMESPACE::make_pair(1000, 1));
+	size_t found = 0;
+	for (int k = -50; k < 400; ++k)
+		found += mp.count(k) + (mp.find(k) != mp.end());
+	for (int i = 0; i < 150; i += 6)
+		mp.erase(i);
+	mp.erase(mp.find(297));
+	Map copy(mp);
+	size_t after = 0;
+	for (int k = -50; k < 400; ++k)
+		after += mp.count(k) + copy.count(k);
+	mp.clear();
+	mp[7] = 7;
+	std::cout << "found " << found << ", after erase " << after << ", cleared " << mp.count(3) << mp.count(7) << std::endl;
+}
+
+// k-way merge only exists on ft::map; std::map folds every element in by hand. Concat
+// shows the input order, Add is associative as a threaded merge needs
+struct Concat {
+	int operator()(int acc, int v) const { return (acc * 10 + v); }
+};
+struct Add {
+	int operator()(int acc, int v) const { return (acc + v); }
+};
+
+template <typename Reduce>
+void assignMerged(std::map<int, int>& out, const std::vector< std::map<int, int> >& parts, Reduce reduce, unsigned int)
+{
+	std::map<int, int> res;
+	for (size_t i = 0; i < parts.size(); ++i)
+	{
+		for (std::map<int, int>::const_iterator it = parts[i].begin(); it != parts[i].end(); ++it)
+		{
+			std::map<int, int>::iterator found = res.find(it->first);
+			if (found == res.end())
+				res.insert(*it);
+			else
+				found->second = reduce(found->second, it->second);
+		}
+	}
+	out.swap(res);
+}
+template <typename Reduce>
+void assignMerged(ft::map<int, int>& out, const std::vector< ft::map<int, int> >& parts, Reduce reduce, unsigned int threads)
+{
+	out.assign_merged(parts.begin(), parts.end(), reduce, threads);
+}
+
+template <typename Map>
+void mergeTest()
+{
+	std::vector<Map> parts(7);
+	for (int p = 0; p < 6; ++p)
+		for (int i = 0; i < 3000; i += p + 1)
+			parts[p][i * 7 % 3001] = p + 1;
+	Map out;
+	out[-1] = -1;
+	for (unsigned int threads = 1; threads <= 4; threads += 3)
+	{
+		if (threads == 1)
+			assignMerged(out, parts, Concat(), threads);
+		else
+			assignMerged(out, parts, Add(), threads);
+		long sum = 0;
+		for (typename Map::iterator it = out.begin(); it != out.end(); ++it)
+			sum += it->second;
+		std::cout << "threads " << threads << ": size " << out.size() << ", sum " << sum << ", [0] " << out[0] << ", [7] " << out[7]
+			<< ", [3000] " << out[3000] << ", last " << (--out.end())->first << std::endl;
+	}
+	assignMerged(parts[1], parts, Concat(), 1);
+	std::cout << "into an input: size " << parts[1].size() << ", [21] " << parts[1][21] << std::endl;
+	assignMerged(out, std::vector<Map>(), Add(), 2);
+	std::cout << "no input: " << out.size() << std::endl;
+}
+
+// erase_if is C++20 on std::map, which a C++98 build walks by hand instead
+struct ValueBelow {
+	int	limit;
+
+	ValueBelow(int l) : limit(l) {}
+
+	bool operator()(const std::pair<const int, int>& val) const { return (val.second < limit); }
+	bool operator()(const ft::pair<const int, int>& val) const { return (val.second < limit); }
+};
+
+size_t eraseIf(std::map<int, int>& mp, ValueBelow pred)
+{
+	size_t res = 0;
+	for (std::map<int, int>::iterator it = mp.begin(); it != mp.end();)
+	{
+		if (pred(*it))
+		{
+			mp.erase(it++);
+			++res;
+		}
+		else
+			++it;
+	}
+	return (res);
+}
+size_t eraseIf(ft::map<int, int>& mp, ValueBelow pred) { return (ft::erase_if(mp, pred)); }
+
+template <typename Map>
+void eraseIfTest()
+{
+	Map mp;
+	for (int i = 0; i < 3000; ++i)
+		mp[i * 7 % 3001] = i;
+	typename Map::iterator kept = mp.find(2999 * 7 % 3001);
+	std::cout << "few: " << eraseIf(mp, ValueBelow(100)) << ", size " << mp.size() << ", first " << mp.begin()->first
+		<< ", kept " << kept->first << " " << kept->second << std::endl;
+	std::cout << "most: " << eraseIf(mp, ValueBelow(2950)) << ", size " << mp.size() << ", first " << mp.begin()->first
+		<< ", last " << mp.rbegin()->first << ", kept " << kept->first << " " << kept->second << std::endl;
+	for (int i = 0; i < 40; ++i)
+		mp[i] = i;
+	enableLazyErase(mp, 0.5);
+	mp.erase(3);
+	std::cout << "lazy: " << eraseIf(mp, ValueBelow(30)) << ", size " << mp.size() << ", count 3 " << mp.count(3) << std::endl;
+	long sum = 0;
+	for (typename Map::iterator it = mp.begin(); it != mp.end(); ++it)
+		sum += it->first;
+	std::cout << "sum " << sum << ", none: " << eraseIf(mp, ValueBelow(0)) << ", all: " << eraseIf(mp, ValueBelow(5000))
+		<< ", empty " << mp.empty() << ", again " << eraseIf(mp, ValueBelow(5000)) << std::endl;
+}
+
+// std::map has no change tracking: a checkpoint there is a copy, and the changes since
+// are found by diffing against it; known false stands for a version ft::map forgot
+void enableChangeTracking(std::map<int, int>&) {}
+void enableChangeTracking(ft::map<int, int>& mp) { mp.enable_change_tracking(); }
+void checkpoint(std::map<int, int>& mp, std::map<int, int>& snap, unsigned long&) { snap = mp; }
+void checkpoint(ft::map<int, int>& mp, std::map<int, int>&, unsigned long& version) { version = mp.checkpoint(); }
+void touch(std::map<int, int>&, int) {}
+void touch(ft::map<int, int>& mp, int k) { mp.touch(k); }
+void forgetChangesBefore(std::map<int, int>&, unsigned long) {}
+void forgetChangesBefore(ft::map<int, int>& mp, unsigned long version) { mp.forget_changes_before(version); }
+
+void printChanges(std::map<int, int>& mp, const std::map<int, int>& snap, unsigned long, bool known)
+{
+	if (!known)
+	{
+		std::cout << "full snapshot" << std::endl;
+		return ;
+	}
+	std::cout << "written:";
+	for (std::map<int, int>::iterator it = mp.begin(); it != mp.end(); ++it)
+	{
+		std::map<int, int>::const_iterator old = snap.find(it->first);
+		if (old == snap.end() || old->second != it->second)
+			std::cout << " " << it->first << ":" << it->second;
+	}
+	std::cout << ", erased:";
+	for (std::map<int, int>::const_iterator it = snap.begin(); it != snap.end(); ++it)
+		if (mp.count(it->first) == 0)
+			std::cout << " " << it->first;
+	std::cout << std::endl;
+}
+
+void printChanges(ft::map<int, int>& mp, const std::map<int, int>&, unsigned long version, bool)
+{
+	std::vector<ft::map<int, int>::const_iterator> written;
+	std::vector<int> erased;
+	if (!mp.changes_since(version, written, erased))
+	{
+		std::cout << "full snapshot" << std::endl;
+		return ;
+	}
+	std::cout << "written:";
+	for (size_t i = 0; i < written.size(); ++i)
+		std::cout << " " << written[i]->first << ":" << written[i]->second;
+	std::cout << ", erased:";
+	for (size_t i = 0; i < erased.size(); ++i)
+		std::cout << " " << erased[i];
+	std::cout << std::endl;
+}
+
+// sizes only, for changes too many to print
+void printChangeCounts(std::map<int, int>& mp, const std::map<int, int>& snap, unsigned long)
+{
+	size_t written = 0;
+	for (std::map<int, int>::iterator it = mp.begin(); it != mp.end(); ++it)
+	{
+		std::map<int, int>::const_iterator old = snap.find(it->first);
+		written += (old == snap.end() || old->second != it->second);
+	}
+	size_t erased = 0;
+	for (std::map<int, int>::const_iterator it = snap.begin(); it != snap.end(); ++it)
+		erased += (mp.count(it->first) == 0);
+	std::cout << "written " << written << ", erased " << erased << std::endl;
+}
+
+void printChangeCounts(ft::map<int, int>& mp, const std::map<int, int>&, unsigned long version)
+{
+	std::vector<ft::map<int, int>::const_iterator> written;
+	std::vector<int> erased;
+	mp.changes_since(version, written, erased);
+	std::cout << "written " << written.size() << ", erased " << erased.size() << std::endl;
+}
+
+// every write changes the value, so what was logged is what the diff finds
+template <typename Map>
+void changeTrackingTest()
+{
+	Map mp;
+	std::map<int, int> snap_a;
+	std::map<int, int> snap_b;
+	unsigned long a = 0;
+	unsigned long b = 0;
+	for (int i = 0; i < 1000; ++i)
+		mp[i] = i;
+	checkpoint(mp, snap_a, a);
+	printChanges(mp, snap_a, a, false);
+	enableChangeTracking(mp);
+	checkpoint(mp, snap_a, a);
+	printChanges(mp, snap_a, a, true);
+	mp[5] = -5;
+	mp.insert(TESTED_NAMESPACE::make_pair(2000, 3));
+	mp.insert(TESTED_NAMESPACE::make_pair(6, 1));
+	mp.erase(7);
+	mp.erase(mp.find(9));
+	mp.erase(mp.find(100), mp.find(103));
+	mp.find(10)->second = 77;
+	touch(mp, 10);
+	checkpoint(mp, snap_b, b);
+	eraseIf(mp, ValueBelow(3));
+	mp[500] = 1;
+	mp[500] = 2;
+	mp.insert(mp.begin(), TESTED_NAMESPACE::make_pair(-1, 1));
+	printChanges(mp, snap_a, a, true);
+	printChanges(mp, snap_b, b, true);
+	for (int i = 1; i <= 5000; ++i)
+		mp[42] = -i;
+	printChanges(mp, snap_b, b, true);
+	forgetChangesBefore(mp, b);
+	printChanges(mp, snap_a, a, false);
+	printChanges(mp, snap_b, b, true);
+	Map copy(mp);
+	mp.swap(copy);
+	printChanges(mp, snap_b, b, false);
+	mp.swap(copy);
+	mp.clear();
+	printChanges(mp, snap_b, b, false);
+	checkpoint(mp, snap_a, a);
+	mp[3] = 3;
+	printChanges(mp, snap_a, a, true);
+
+	// erasing most of a large map: the log must not be deduplicated on every erase
+	for (int i = 0; i < 60000; ++i)
+		mp[i] = i;
+	checkpoint(mp, snap_a, a);
+	for (int i = 0; i < 59000; ++i)
+	{
+		if (i % 2)
+			mp.erase(i);
+		else
+			mp.erase(mp.find(i));
+	}
+	mp[59500] = -1;
+	printChangeCounts(mp, snap_a, a);
+}
+
+// increasing keys take the append path, erasing the max moves it back
+template <typename Map>
+void appendTest()
+{
+	Map mp;
+	for (int i = 0; i < 2000; ++i)
+		mp.insert(TESTED_NAMESPACE::make_pair(i * 2, i));
+	mp.erase(3998);
+	mp.erase(--mp.end());
+	mp.insert(TESTED_NAMESPACE::make_pair(3995, -1));
+	mp[3997] = -2;
+	mp.insert(TESTED_NAMESPACE::make_pair(3997, -3));
+	mp.insert(TESTED_NAMESPACE::make_pair(1001, -4));
+	std::cout << "size " << mp.size() << ", last " << mp.rbegin()->first << " " << mp.rbegin()->second << ", before "
+		<< (--(--mp.end()))->first << ", [1001] " << mp[1001] << std::endl;
+	while (mp.size() > 3)
+		mp.erase(mp.rbegin()->first);
+	mp.insert(TESTED_NAMESPACE::make_pair(7, 7));
+	for (typename Map::iterator it = mp.begin(); it != mp.end(); ++it)
+		std::cout << it->first << " ";
+	std::cout << std::endl;
+}
+
+#if __cplusplus >= 201103L
+template <typename Map>
+void moveTest()
+{
+	Map mp;
+	typename Map::value_type val(std::string(20, 'a'), std::vector<int>(100, 1));
+	mp.insert(std::move(val));
+	std::string key(30, 'b');
+	mp[std::move(key)].push_back(2);
+	std::string taken(20, 'a');
+	mp[std::move(taken)].push_back(3);
+	std::cout << "moved: " << val.second.size() << " " << key.size() << ", kept " << taken.size() << std::endl;
+	std::cout << "emplace: " << mp.emplace("c", std::vector<int>(3, 4)).second << " "
+		<< mp.emplace("c", std::vector<int>(5, 5)).second << " "
+		<< mp.emplace_hint(mp.end(), "d", std::vector<int>(2, 6))->first << std::endl;
+	Map moved(std::move(mp));
+	Map assigned;
+	assigned = std::move(moved);
+	std::cout << "source: " << mp.size() << " " << moved.size() << std::endl;
+	for (typename Map::iterator it = assigned.begin(); it != assigned.end(); ++it)
+		std::cout << it->first << ": " << it->second.size() << " " << it->second.back() << std::endl;
+}
+#endif
+
+template <typename Map>
+void balanceTest(const char* name)
+{
+	Map mp;
+	for (int i = 0; i < 1000; ++i)
+		mp[i * 37 % 1000] = i;
+	for (int i = 0; i < 1000; i += 3)
+		mp.erase(i);
+	for (int i = 0; i < 1000; i += 2)
+		mp.insert(mp.end(), TESTED_NAMESPACE::make_pair(1000 + i, i));
+	long sum = 0;
+	for (typename Map::const_iterator it = mp.begin(); it != mp.end(); ++it)
+		sum += it->first * 3 + it->second;
+	std::cout << name << ": size " << mp.size() << ", sum " << sum << ", first " << mp.begin()->first
+		<< ", last " << (--mp.end())->first << ", lower_bound(500) " << mp.lower_bound(500)->first << std::endl;
+}
+
 template <typename T>
 void printContainers(T const &mp, bool print_content = true) {
 	const T_SIZE_TYPE size = mp.size();
@@ -148,4 +701,60 @@ int main() {
 	std::cout << "operator<=: " << ((lhs <= rhs) ? "OK" : "KO") << std::endl;
 	std::cout << "operator>:  " << ((lhs > rhs) ? "OK" : "KO") << std::endl;
 	std::cout << "operator>=: " << ((lhs >= rhs) ? "OK" : "KO") << std::endl;
+
+	std::cout << "\n################################################" << std::endl;
+	std::cout << "===== balancing policies =====" << std::endl;
+	balanceTest< SELECT(TESTED_NAMESPACE)<ft::RBBalance>::map >("red-black");
+	balanceTest< SELECT(TESTED_NAMESPACE)<ft::AVLBalance>::map >("avl");
+	balanceTest< SELECT(TESTED_NAMESPACE)<ft::WBBalance>::map >("weight-balanced");
+
+	std::cout << "\n################################################" << std::endl;
+	std::cout << "===== find cache =====" << std::endl;
+	findCacheTest< TESTED_NAMESPACE::map<int, int> >();
+
+	std::cout << "\n################################################" << std::endl;
+	std::cout << "===== parallel traversal =====" << std::endl;
+	parallelTest< TESTED_NAMESPACE::map<int, int> >();
+
+	std::cout << "\n################################################" << std::endl;
+	std::cout << "===== compact =====" << std::endl;
+	compactTest< TESTED_NAMESPACE::map<int, int> >();
+
+	std::cout << "\n################################################" << std::endl;
+	std::cout << "===== lazy erase =====" << std::endl;
+	lazyEraseTest< TESTED_NAMESPACE::map<int, int> >();
+
+	std::cout << "\n################################################" << std::endl;
+	std::cout << "===== finger search =====" << std::endl;
+	fingerTest< TESTED_NAMESPACE::map<int, int> >();
+
+	std::cout << "\n################################################" << std::endl;
+	std::cout << "===== copy-on-write =====" << std::endl;
+	copyOnWriteTest< TESTED_NAMESPACE::map<int, int> >();
+
+	std::cout << "\n################################################" << std::endl;
+	std::cout << "===== bloom filter =====" << std::endl;
+	bloomFilterTest< TESTED_NAMESPACE::map<int, int> >();
+
+	std::cout << "\n################################################" << std::endl;
+	std::cout << "===== k-way merge =====" << std::endl;
+	mergeTest< TESTED_NAMESPACE::map<int, int> >();
+
+	std::cout << "\n################################################" << std::endl;
+	std::cout << "===== erase_if =====" << std::endl;
+	eraseIfTest< TESTED_NAMESPACE::map<int, int> >();
+
+	std::cout << "\n################################################" << std::endl;
+	std::cout << "===== append =====" << std::endl;
+	appendTest< TESTED_NAMESPACE::map<int, int> >();
+
+	std::cout << "\n################################################" << std::endl;
+	std::cout << "===== change tracking =====" << std::endl;
+	changeTrackingTest< TESTED_NAMESPACE::map<int, int> >();
+
+#if __cplusplus >= 201103L
+	std::cout << "\n################################################" << std::endl;
+	std::cout << "===== move | emplace =====" << std::endl;
+	moveTest< TESTED_NAMESPACE::map<std::string, std::vector<int> > >();
+#endif
 }
@@ -0,0 +1,183 @@
+#include "persistent_map.hpp"
+#include <iostream>
+#include <map>
+#include <cstdio>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#ifndef TESTED_NAMESPACE
+#define TESTED_NAMESPACE ft
+#endif
+
+#define DB_PATH "./mainTester/log/persistent_map_test.db"
+
+// std::map stand-in for the oracle run: "reopening" hands back what the last
+// instance held when it went out of scope
+template <typename K, typename V>
+class reopened_map : public std::map<K, V> {
+	public :
+		explicit reopened_map(const char*) : std::map<K, V>(store()) {}
+		~reopened_map() { store() = *this; }
+		void checkpoint() {}
+		bool verify() const { return (true); }
+	private :
+		static std::map<K, V>& store()
+		{
+			static std::map<K, V> saved;
+			return (saved);
+		}
+};
+
+template <typename K, typename V>
+struct select_ft { typedef ft::persistent_map<K, V> map; };
+template <typename K, typename V>
+struct select_std { typedef reopened_map<K, V> map; };
+#define SELECT_(ns) select_##ns
+#define SELECT(ns) SELECT_(ns)
+
+#define T1 int
+#define T2 double
+#define TESTED_MAP SELECT(TESTED_NAMESPACE)<T1, T2>::map
+
+template <typename T>
+void printContainers(T const &mp) {
+	std::cout << "size: " << mp.size() << ", valid: " << mp.verify() << std::endl;
+	for (typename T::const_iterator it = mp.begin(); it != mp.end(); ++it)
+		std::cout << "- key: " << it->first << " | value: " << it->second << std::endl;
+	std::cout << "###############################################" << std::endl;
+}
+
+template <typename T>
+void printSummary(T const &mp) {
+	long sum = 0;
+	for (typename T::const_iterator it = mp.begin(); it != mp.end(); ++it)
+		sum += it->first * static_cast<long>(it->second);
+	std::cout << "size: " << mp.size() << ", valid: " << mp.verify() << ", sum: " << sum << std::endl;
+}
+
+template <typename T>
+void writeSome(T &mp) {
+	for (int i = 0; i < 500; ++i)
+		mp[i * 3 % 500] = i;
+	for (int i = 0; i < 500; i += 7)
+		mp.erase(i);
+}
+
+// std has no file to crash on: what ft must report
+void interruptedWriteTest(reopened_map<T1, T2>*)
+{
+	reopened_map<T1, T2> mp(DB_PATH);
+	mp.clear();
+	writeSome(mp);
+	printSummary(mp);
+	std::cout << "stopped halfway: refused" << std::endl;
+	std::cout << "other types: refused" << std::endl;
+}
+
+// a writer killed before checkpoint() or close leaves the file dirty: the next open
+// checks the tree, and refuses it if the writer stopped halfway through a change
+void interruptedWriteTest(ft::persistent_map<T1, T2>*)
+{
+	std::remove(DB_PATH);
+	std::cout.flush();
+	pid_t pid = fork();
+	if (pid == 0)
+	{
+		ft::persistent_map<T1, T2> mp(DB_PATH);
+		mp.checkpoint();
+		writeSome(mp);
+		_exit(0);
+	}
+	waitpid(pid, NULL, 0);
+	{
+		ft::persistent_map<T1, T2> mp(DB_PATH);
+		printSummary(mp);
+	}
+	// as if the writer died between linking a node and counting it
+	ft::PersistentHeader head;
+	int fd = open(DB_PATH, O_RDWR);
+	if (pread(fd, &head, sizeof(head), 0) == sizeof(head))
+	{
+		head.dirty = 1;
+		head.size++;
+		if (pwrite(fd, &head, sizeof(head), 0) != sizeof(head))
+			std::cout << "pwrite failed" << std::endl;
+	}
+	close(fd);
+	try
+	{
+		ft::persistent_map<T1, T2> mp(DB_PATH);
+		std::cout << "stopped halfway: opened, size " << mp.size() << std::endl;
+	}
+	catch (std::runtime_error&)
+	{
+		std::cout << "stopped halfway: refused" << std::endl;
+	}
+	// nodes of the same size, other types
+	try
+	{
+		ft::persistent_map<long, long> mp(DB_PATH);
+		std::cout << "other types: opened, size " << mp.size() << std::endl;
+	}
+	catch (std::runtime_error&)
+	{
+		std::cout << "other types: refused" << std::endl;
+	}
+}
+
+int main() {
+	std::remove(DB_PATH);
+
+	std::cout << "===== first run =====" << std::endl;
+	{
+		TESTED_MAP mp(DB_PATH);
+		std::cout << "empty: " << mp.empty() << std::endl;
+		for (int i = 0; i < 40; ++i)
+			mp.insert(TESTED_NAMESPACE::make_pair(i * 7 % 40, i * 0.5));
+		mp[100] = 1.25;
+		mp[3] = -3.0;
+		std::cout << "insert dup: " << mp.insert(TESTED_NAMESPACE::make_pair(5, 0.0)).second << std::endl;
+		for (int i = 0; i < 40; i += 3)
+			mp.erase(i);
+		mp.erase(mp.find(1));
+		printContainers(mp);
+		mp.checkpoint();
+	}
+
+	std::cout << "===== reopened =====" << std::endl;
+	{
+		TESTED_MAP mp(DB_PATH);
+		printContainers(mp);
+		std::cout << "find 7: " << mp.find(7)->second << ", count 9: " << mp.count(9) << ", count 8: " << mp.count(8) << std::endl;
+		std::cout << "lower_bound 9: " << mp.lower_bound(9)->first << ", upper_bound 10: " << mp.upper_bound(10)->first << std::endl;
+		std::cout << "last: " << (--mp.end())->first << ", rbegin: " << mp.rbegin()->first << std::endl;
+		const TESTED_MAP& cref = mp;
+		TESTED_MAP::const_iterator cit = cref.find(7);
+		TESTED_MAP::const_iterator cit_copy(cit);
+		TESTED_MAP::const_reverse_iterator crit = cref.rbegin();
+		TESTED_MAP::const_reverse_iterator crit_copy(crit);
+		cit = cit_copy;
+		std::cout << "const copies: " << (++cit_copy)->first << " " << cit->first << " " << (++crit_copy)->first << " " << crit->first << std::endl;
+		for (int i = 200; i < 2200; ++i)
+			mp[i] = i;
+		for (int i = 200; i < 2200; i += 2)
+			mp.erase(i);
+		std::cout << "size after growth: " << mp.size() << ", valid: " << mp.verify() << std::endl;
+	}
+
+	std::cout << "===== reopened again =====" << std::endl;
+	{
+		TESTED_MAP mp(DB_PATH);
+		std::cout << "size: " << mp.size() << ", find 2199: " << mp.find(2199)->second << ", find 2198: " << (mp.find(2198) == mp.end()) << std::endl;
+		mp.erase(mp.lower_bound(200), mp.end());
+		printContainers(mp);
+		mp.clear();
+		std::cout << "cleared: " << mp.size() << ", begin == end: " << (mp.begin() == mp.end()) << std::endl;
+	}
+
+	std::cout << "===== interrupted write =====" << std::endl;
+	interruptedWriteTest(static_cast<TESTED_MAP*>(NULL));
+	std::remove(DB_PATH);
+}
@@ -1,3 +1,5 @@
+#include <cstdlib>
+#include <fstream>
 #include <iostream>
 #include <list>
 #include <map>
@@ -10,7 +12,7 @@
 #define T2 std::string
 #define T3 ft::map< T1, T2 >::value_type
 
-int main() {
+int main(int argc, char** argv) {
   std::list< T3 > lst;
   unsigned int lst_size = 10;
   for (unsigned int i = 0; i < lst_size; ++i) {
@@ -19,5 +21,22 @@ int main() {
   ft::map< T1, T2 > mp(lst.begin(), lst.end());
 
   mp.showTree();
+
+  ft::RBTreeStats stats = mp.tree_stats();
+  std::cout << "// TREE STATS //" << std::endl
+            << "nodes: " << stats.node_count << std::endl
+            << "height: " << stats.height << std::endl
+            << "black height: " << stats.black_height << std::endl
+            << "average depth: " << stats.average_depth << std::endl
+            << "bytes (nodes/values/sentinel/total): " << stats.node_bytes << "/"
+            << stats.value_bytes << "/" << stats.sentinel_bytes << "/" << stats.total_bytes
+            << std::endl
+            << "invariants: " << (stats.valid ? "OK" : "KO") << std::endl;
+
+  if (argc > 1) {
+    std::ofstream dot(argv[1]);
+    mp.exportDot(dot);
+    std::cout << "dot written to " << argv[1] << std::endl;
+  }
 	system("leaks map");
 }
@@ -0,0 +1,116 @@
+#include "radix_map.hpp"
+#include <iostream>
+#include <map>
+#include <string>
+
+#ifndef TESTED_NAMESPACE
+#define TESTED_NAMESPACE ft
+#endif
+
+template <typename K, typename V>
+struct select_ft { typedef ft::radix_map<K, V> map; };
+template <typename K, typename V>
+struct select_std { typedef std::map<K, V> map; };
+#define SELECT_(ns) select_##ns
+#define SELECT(ns) SELECT_(ns)
+
+#define INT_MAP SELECT(TESTED_NAMESPACE)<int, int>::map
+#define ULONG_MAP SELECT(TESTED_NAMESPACE)<unsigned long, int>::map
+#define STRING_MAP SELECT(TESTED_NAMESPACE)<std::string, int>::map
+
+template <typename T>
+void printContainers(T const &mp) {
+	std::cout << "size: " << mp.size() << std::endl;
+	for (typename T::const_iterator it = mp.begin(); it != mp.end(); ++it)
+		std::cout << "- key: " << it->first << " | value: " << it->second << std::endl;
+	std::cout << "###############################################" << std::endl;
+}
+
+template <typename T>
+void printBounds(T &mp, typename T::key_type const &k) {
+	typename T::iterator lo = mp.lower_bound(k);
+	typename T::iterator up = mp.upper_bound(k);
+	std::cout << "[" << k << "] count " << mp.count(k) << ", find " << (mp.find(k) == mp.end() ? -1 : mp.find(k)->second)
+		<< ", lower_bound " << (lo == mp.end() ? "end" : "") << (lo == mp.end() ? typename T::key_type() : lo->first)
+		<< ", upper_bound " << (up == mp.end() ? "end" : "") << (up == mp.end() ? typename T::key_type() : up->first) << std::endl;
+}
+
+int main() {
+	std::cout << "===== signed keys =====" << std::endl;
+	INT_MAP mp;
+	std::cout << "empty: " << mp.empty() << std::endl;
+	for (int i = 0; i < 40; ++i)
+		mp.insert(TESTED_NAMESPACE::make_pair((i * 37 % 41 - 20) * 1000003, i));
+	mp.insert(TESTED_NAMESPACE::make_pair(-2147483647 - 1, -1));
+	mp.insert(TESTED_NAMESPACE::make_pair(2147483647, 1));
+	mp[0] = 100;
+	mp[7] = 7;
+	std::cout << "insert existing: " << mp.insert(TESTED_NAMESPACE::make_pair(7, -7)).second << std::endl;
+	printContainers(mp);
+	for (int k = -21000063; k < 22000000; k += 3000009)
+		printBounds(mp, k);
+	printBounds(mp, 2147483647);
+
+	std::cout << "===== erase | reverse =====" << std::endl;
+	for (int i = -20; i < 20; i += 3)
+		std::cout << mp.erase(i * 1000003);
+	std::cout << std::endl;
+	mp.erase(mp.find(7));
+	mp.erase(mp.lower_bound(5000000), mp.upper_bound(12000000));
+	for (INT_MAP::const_reverse_iterator it = mp.rbegin(); it != mp.rend(); ++it)
+		std::cout << it->first << " ";
+	std::cout << std::endl;
+	INT_MAP::iterator last = mp.end();
+	--last;
+	std::cout << "last: " << last->first << std::endl;
+
+	std::cout << "===== dense unsigned keys =====" << std::endl;
+	ULONG_MAP dense;
+	for (unsigned long i = 0; i < 600; ++i)
+		dense[i * 3] = static_cast<int>(i);
+	for (unsigned long i = 0; i < 1800; i += 5)
+		dense.erase(i);
+	std::cout << "size: " << dense.size() << ", first " << dense.begin()->first << ", last " << dense.rbegin()->first << std::endl;
+	for (unsigned long k = 250; k < 1800; k += 311)
+		printBounds(dense, k);
+	unsigned long sum = 0;
+	for (ULONG_MAP::iterator it = dense.begin(); it != dense.end(); ++it)
+		sum += it->first * it->second;
+	std::cout << "sum: " << sum << std::endl;
+	dense.erase(dense.begin(), dense.lower_bound(1700));
+	printContainers(dense);
+
+	std::cout << "===== string keys =====" << std::endl;
+	STRING_MAP words;
+	const char* list[] = { "romane", "romanus", "romulus", "rubens", "ruber", "rubicon", "rubicundus", "r", "", "rom",
+		"a-key-with-a-very-long-shared-prefix-1", "a-key-with-a-very-long-shared-prefix-2", "a-key-with-a-very-long-shared-prefix",
+		"a-key-with-a-very-long-shared-prefix-10", "zeta", "z" };
+	for (size_t i = 0; i < sizeof(list) / sizeof(list[0]); ++i)
+		words[list[i]] = static_cast<int>(i);
+	printContainers(words);
+	printBounds(words, "rom");
+	printBounds(words, "roma");
+	printBounds(words, "rubicon!");
+	printBounds(words, "a-key-with-a-very-long-shared-prefix-0");
+	printBounds(words, "a-key-with-a-very-long-shared-prefiy");
+	printBounds(words, "zz");
+	std::cout << words.erase("rom") << words.erase("rom") << words.erase("romanus") << words.erase("a-key-with-a-very-long-shared-prefix") << std::endl;
+	printBounds(words, "rom");
+	printBounds(words, "a-key-with-a-very-long-shared-prefix");
+
+	std::cout << "===== copy | swap | compare =====" << std::endl;
+	STRING_MAP cp(words);
+	cp["rome"] = 42;
+	STRING_MAP other;
+	other["x"] = 1;
+	other.swap(cp);
+	std::cout << "equal: " << (words == cp) << ", less: " << (words < other) << ", greater: " << (cp > words) << std::endl;
+	printContainers(other);
+	cp = other;
+	std::cout << "assigned equal: " << (cp == other) << std::endl;
+	STRING_MAP range(words.find("r"), words.end());
+	printContainers(range);
+	words.clear();
+	std::cout << "cleared: " << words.size() << " " << words.empty() << std::endl;
+	return (0);
+}
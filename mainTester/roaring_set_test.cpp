@@ -0,0 +1,200 @@
+#include "roaring_set.hpp"
+#include <iostream>
+#include <set>
+#include <vector>
+
+#ifndef TESTED_NAMESPACE
+#define TESTED_NAMESPACE ft
+#endif
+
+struct select_ft { typedef ft::roaring_set set; };
+struct select_std { typedef std::set<unsigned int> set; };
+#define SELECT_(ns) select_##ns
+#define SELECT(ns) SELECT_(ns)
+
+#define UINT_SET SELECT(TESTED_NAMESPACE)::set
+
+// |=, &= and optimize() only exist on ft::roaring_set, std::set gets the same result by hand
+void unite(std::set<unsigned int>& a, const std::set<unsigned int>& b) { a.insert(b.begin(), b.end()); }
+void unite(ft::roaring_set& a, const ft::roaring_set& b) { a |= b; }
+
+void intersect(std::set<unsigned int>& a, const std::set<unsigned int>& b)
+{
+	for (std::set<unsigned int>::iterator it = a.begin(); it != a.end();)
+	{
+		if (b.count(*it) == 0)
+			a.erase(it++);
+		else
+			++it;
+	}
+}
+void intersect(ft::roaring_set& a, const ft::roaring_set& b) { a &= b; }
+
+void optimize(std::set<unsigned int>&) {}
+void optimize(ft::roaring_set& st) { st.optimize(); }
+
+template <typename T>
+void printContainers(T const &st) {
+	std::cout << "size: " << st.size() << std::endl;
+	for (typename T::const_iterator it = st.begin(); it != st.end(); ++it)
+		std::cout << *it << " ";
+	std::cout << std::endl << "###############################################" << std::endl;
+}
+
+// size, a checksum both ways and the ends, for sets too large to print
+template <typename T>
+void printSummary(const char* label, T const &st) {
+	unsigned long long forward = 0;
+	for (typename T::const_iterator it = st.begin(); it != st.end(); ++it)
+		forward = forward * 31 + *it;
+	unsigned long long backward = 0;
+	for (typename T::const_reverse_iterator it = st.rbegin(); it != st.rend(); ++it)
+		backward = backward * 31 + *it;
+	std::cout << label << ": size " << st.size() << ", hash " << forward << " " << backward;
+	if (!st.empty())
+		std::cout << ", first " << *st.begin() << ", last " << *st.rbegin();
+	std::cout << std::endl;
+}
+
+template <typename T>
+void printBounds(T &st, unsigned int v) {
+	typename T::iterator lo = st.lower_bound(v);
+	typename T::iterator up = st.upper_bound(v);
+	std::cout << "[" << v << "] count " << st.count(v) << ", find " << (st.find(v) != st.end())
+		<< ", lower_bound " << (lo == st.end() ? "end " : "") << (lo == st.end() ? 0 : *lo)
+		<< ", upper_bound " << (up == st.end() ? "end " : "") << (up == st.end() ? 0 : *up) << std::endl;
+}
+
+int main() {
+	std::cout << "===== sparse =====" << std::endl;
+	UINT_SET st;
+	std::cout << "empty: " << st.empty() << std::endl;
+	unsigned int edges[] = { 0, 1, 65535, 65536, 65537, 131071, 4294967295U, 4294901760U, 2147483648U, 7, 65535 };
+	for (size_t i = 0; i < sizeof(edges) / sizeof(edges[0]); ++i)
+		std::cout << st.insert(edges[i]).second;
+	std::cout << std::endl;
+	for (unsigned int i = 0; i < 30; ++i)
+		st.insert(i * 2654435761U);
+	std::cout << "insert existing: " << st.insert(65536).second << " " << *st.insert(65536).first << std::endl;
+	printContainers(st);
+	unsigned int probes[] = { 0, 2, 65534, 65535, 65536, 65538, 131072, 2147483647, 4294901759U, 4294967294U, 4294967295U };
+	for (size_t i = 0; i < sizeof(probes) / sizeof(probes[0]); ++i)
+		printBounds(st, probes[i]);
+	for (UINT_SET::const_reverse_iterator it = st.rbegin(); it != st.rend(); ++it)
+		std::cout << *it << " ";
+	std::cout << std::endl;
+	std::cout << "erase: " << st.erase(65536) << st.erase(65536) << st.erase(3) << std::endl;
+	st.erase(st.find(4294967295U));
+	st.erase(st.lower_bound(100), st.lower_bound(2000000000));
+	printContainers(st);
+
+	std::cout << "===== dense =====" << std::endl;
+	UINT_SET dense;
+	for (unsigned int i = 0; i < 10000; ++i)
+		dense.insert(196608 + i * 7 % 10000);
+	printSummary("bitmap", dense);
+	for (unsigned int v = 196600; v < 206610; v += 1999)
+		printBounds(dense, v);
+	std::cout << "insert existing: " << dense.insert(200000).second << std::endl;
+	for (unsigned int i = 0; i < 10000; i += 2)
+		dense.erase(196608 + i);
+	printSummary("half erased", dense);
+	for (unsigned int i = 1; i < 10000; i += 4)
+		dense.erase(196608 + i);
+	printSummary("back to array", dense);
+	printBounds(dense, 196610);
+	printBounds(dense, 206607);
+	UINT_SET::iterator it = dense.end();
+	for (int i = 0; i < 3; ++i)
+		std::cout << *--it << " ";
+	std::cout << *it++ << " ";
+	std::cout << *it << std::endl;
+
+	std::cout << "===== runs =====" << std::endl;
+	UINT_SET runs;
+	for (unsigned int v = 100000; v < 160000; ++v)
+		runs.insert(v);
+	for (unsigned int v = 300000; v < 300010; ++v)
+		runs.insert(v);
+	runs.insert(300020);
+	optimize(runs);
+	printSummary("optimized", runs);
+	std::cout << runs.insert(130000).second << runs.insert(160000).second << runs.insert(99999).second << runs.insert(300011).second
+		<< runs.insert(300010).second << runs.insert(300019).second << std::endl;
+	std::cout << runs.erase(130000) << runs.erase(130000) << runs.erase(100000) << runs.erase(159999) << runs.erase(300020)
+		<< runs.erase(5) << std::endl;
+	printSummary("edited", runs);
+	printBounds(runs, 130000);
+	printBounds(runs, 160000);
+	printBounds(runs, 300012);
+	for (unsigned int v = 300000; v < 300012; ++v)
+		std::cout << runs.count(v);
+	std::cout << std::endl;
+	for (unsigned int v = 100001; v < 160000; v += 3)
+		runs.erase(v);
+	printSummary("split up", runs);
+
+	std::cout << "===== union | intersection =====" << std::endl;
+	UINT_SET a;
+	UINT_SET b;
+	for (unsigned int i = 0; i < 60000; ++i)
+	{
+		a.insert(i * 3);
+		b.insert(i * 2 + 1000);
+	}
+	for (unsigned int i = 0; i < 3000; ++i)
+	{
+		a.insert(10000000 + i * 7);
+		b.insert(10000000 + i * 5);
+		a.insert(20000000 + i * 11);
+		b.insert(20000000 + i);
+	}
+	for (unsigned int v = 30000000; v < 30050000; ++v)
+		a.insert(v);
+	for (unsigned int i = 0; i < 100; ++i)
+		b.insert(30000000 + i * 477);
+	for (unsigned int i = 0; i < 2000; ++i)
+		a.insert(40000000 + i * 17);
+	for (unsigned int i = 0; i < 50; ++i)
+		b.insert(40000000 + i * 17 * 37);
+	b.insert(4000000000U);
+	optimize(b);
+	UINT_SET u(a);
+	unite(u, b);
+	printSummary("a | b", u);
+	UINT_SET n(a);
+	intersect(n, b);
+	printSummary("a & b", n);
+	UINT_SET n2(b);
+	intersect(n2, a);
+	std::cout << "symmetric: " << (n == n2) << std::endl;
+	optimize(a);
+	UINT_SET ou(b);
+	unite(ou, a);
+	std::cout << "after optimize: " << (ou == u);
+	UINT_SET on(b);
+	intersect(on, a);
+	std::cout << " " << (on == n) << std::endl;
+	unite(u, u);
+	intersect(n, n);
+	std::cout << "self: " << u.size() << " " << n.size() << std::endl;
+	UINT_SET none;
+	intersect(u, none);
+	unite(none, b);
+	std::cout << "empty: " << u.size() << " " << (none == b) << std::endl;
+
+	std::cout << "===== copy | swap | compare =====" << std::endl;
+	UINT_SET c(st.begin(), st.end());
+	std::cout << (c == st) << (c != st) << (c < st) << (c <= st) << std::endl;
+	c.insert(5);
+	std::cout << (c == st) << (c < st) << (c > st) << (c >= st) << std::endl;
+	c.swap(st);
+	printContainers(st);
+	swap(c, st);
+	printContainers(st);
+	c = dense;
+	printSummary("assigned", c);
+	c.clear();
+	std::cout << "cleared: " << c.size() << " " << (c.begin() == c.end()) << std::endl;
+	return (0);
+}
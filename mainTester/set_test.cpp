@@ -27,6 +27,28 @@ void printContainers(T const &st, bool print_content = true) {
 	std::cout << "------------------------" << std::endl;
 }
 
+// erase_if is C++20 on std::set, which a C++98 build walks by hand instead
+struct IsOdd {
+	bool operator()(int v) const { return (v % 2 != 0); }
+};
+
+size_t eraseOdd(std::set<T1>& st)
+{
+	size_t res = 0;
+	for (std::set<T1>::iterator it = st.begin(); it != st.end();)
+	{
+		if (IsOdd()(*it))
+		{
+			st.erase(it++);
+			++res;
+		}
+		else
+			++it;
+	}
+	return (res);
+}
+size_t eraseOdd(ft::set<T1>& st) { return (ft::erase_if(st, IsOdd())); }
+
 int main() {
 	std::cout << "################ Test Map ################" << std::endl;
 	std::cout << "===== default | range | copy constructor =====" << std::endl;
@@ -136,4 +158,25 @@ int main() {
 	std::cout << "operator<=: " << ((lhs <= rhs) ? "OK" : "KO") << std::endl;
 	std::cout << "operator>:  " << ((lhs > rhs) ? "OK" : "KO") << std::endl;
 	std::cout << "operator>=: " << ((lhs >= rhs) ? "OK" : "KO") << std::endl;
+
+	std::cout << "\n################################################" << std::endl;
+	std::cout << "===== erase_if =====" << std::endl;
+	TESTED_NAMESPACE::set<T1> odds;
+	for (int i = 0; i < 500; ++i)
+		odds.insert(i);
+	std::cout << "erased: " << eraseOdd(odds) << std::endl;
+	printContainers(odds, false);
+	std::cout << "first " << *odds.begin() << ", last " << *odds.rbegin() << ", count 7 " << odds.count(7) << std::endl;
+
+#if __cplusplus >= 201103L
+	std::cout << "\n################################################" << std::endl;
+	std::cout << "===== move | emplace =====" << std::endl;
+	TESTED_NAMESPACE::set<std::string> words;
+	std::string word(25, 'x');
+	words.insert(std::move(word));
+	std::cout << "emplace: " << words.emplace(3, 'y').second << " " << words.emplace(25, 'x').second << " "
+		<< *words.emplace_hint(words.begin(), "a") << std::endl;
+	TESTED_NAMESPACE::set<std::string> moved(std::move(words));
+	std::cout << "moved: " << word.size() << " " << words.size() << " " << moved.size() << " " << *moved.rbegin() << std::endl;
+#endif
 } 
@@ -0,0 +1,177 @@
+#include "static_map.hpp"
+#include <iostream>
+
+#ifndef TESTED_NAMESPACE
+#define TESTED_NAMESPACE ft
+#endif
+
+#if __cplusplus >= 201402L
+
+#include <map>
+#include <set>
+#include <string>
+#include <stdexcept>
+
+// ft::static_map and ft::static_set are checked against std::map and std::set built from the
+// same unsorted keys and values
+struct select_ft {
+	template <class K, class T, class C = ft::less<K>, size_t N>
+	static constexpr ft::static_map<K, T, N, C> map(const K (&keys)[N], const T (&vals)[N])
+	{
+		ft::pair<K, T> items[N];
+		for (size_t i = 0; i < N; ++i)
+			items[i] = ft::pair<K, T>(keys[i], vals[i]);
+		return (ft::make_static_map<K, T, C>(items));
+	}
+
+	template <class K, class C = ft::less<K>, size_t N>
+	static constexpr ft::static_set<K, N, C> set(const K (&keys)[N])
+	{
+		return (ft::make_static_set<K, C>(keys));
+	}
+};
+struct select_std {
+	template <class K, class T, class C = std::less<K>, size_t N>
+	static std::map<K, T, C> map(const K (&keys)[N], const T (&vals)[N])
+	{
+		std::map<K, T, C> mp;
+		for (size_t i = 0; i < N; ++i)
+			mp.insert(std::make_pair(keys[i], vals[i]));
+		return (mp);
+	}
+
+	template <class K, class C = std::less<K>, size_t N>
+	static std::set<K, C> set(const K (&keys)[N])
+	{
+		return (std::set<K, C>(keys, keys + N));
+	}
+};
+#define SELECT_(ns) select_##ns
+#define SELECT(ns) SELECT_(ns)
+
+constexpr int codes[] = { 404, 200, 500, 301, 418, 204, 302, 403, 201, 503 };
+constexpr const char* reasons[] = { "Not Found", "OK", "Internal Server Error", "Moved Permanently", "I'm a teapot",
+	"No Content", "Found", "Forbidden", "Created", "Service Unavailable" };
+
+constexpr const char* words[] = { "pear", "apple", "fig", "banana", "cherry", "apricot", "date", "", "b" };
+constexpr int lengths[] = { 4, 5, 3, 6, 6, 7, 4, 0, 1 };
+
+// the table is sorted by the compiler, a lookup in it can be a constant expression
+constexpr auto compiled = ft::make_static_map<int, const char*>({ { 3, "three" }, { 1, "one" }, { 2, "two" } });
+static_assert(compiled.size() == 3, "static_map size");
+static_assert(compiled.begin()->first == 1 && (compiled.end() - 1)->first == 3, "static_map order");
+static_assert(compiled.count(2) == 1 && compiled.count(4) == 0, "static_map count");
+static_assert(compiled.at(2)[1] == 'w', "static_map at");
+static_assert(compiled.lower_bound(0)->first == 1 && compiled.upper_bound(3) == compiled.end(), "static_map bounds");
+constexpr auto sorted_words = ft::make_static_set<const char*, ft::cstr_less>(words);
+static_assert(sorted_words.find("cherry") == sorted_words.begin() + 5, "static_set find");
+static_assert(sorted_words.find("cherr") == sorted_words.end(), "static_set find missing");
+
+constexpr int spread[] = { 90, 10, 50, 70, 30, 20, 80, 40, 60, 0 };
+
+// 500 keys in scrambled order, to sort within the compiler's constexpr limits
+struct Scrambled {
+	int keys[500];
+
+	constexpr Scrambled() : keys()
+	{
+		for (int i = 0; i < 500; ++i)
+			keys[i] = (i * 37) % 500 * 3;
+	}
+};
+constexpr Scrambled scrambled;
+constexpr auto big = ft::make_static_set(scrambled.keys);
+static_assert(big.size() == 500 && *big.begin() == 0 && *(big.end() - 1) == 1497, "static_set of 500");
+
+template <typename T>
+void printMap(T const &mp) {
+	std::cout << "size: " << mp.size() << ", empty: " << mp.empty() << std::endl;
+	for (typename T::const_iterator it = mp.begin(); it != mp.end(); ++it)
+		std::cout << "- key: " << (*it).first << "\t& value: " << it->second << std::endl;
+	for (typename T::const_reverse_iterator it = mp.rbegin(); it != mp.rend(); ++it)
+		std::cout << it->first << " ";
+	std::cout << std::endl << "------------------------" << std::endl;
+}
+
+template <typename T, typename K>
+void printLookup(T const &mp, K k) {
+	typename T::const_iterator lo = mp.lower_bound(k);
+	typename T::const_iterator up = mp.upper_bound(k);
+	std::cout << "[" << k << "] count " << mp.count(k) << ", find " << (mp.find(k) == mp.end() ? "end" : mp.find(k)->second)
+		<< ", lower_bound " << (lo == mp.end() ? "end" : lo->second) << ", upper_bound " << (up == mp.end() ? "end" : up->second)
+		<< ", equal_range " << (mp.equal_range(k).first == lo) << (mp.equal_range(k).second == up) << ", at ";
+	try {
+		std::cout << mp.at(k) << std::endl;
+	}
+	catch (std::out_of_range&) {
+		std::cout << "out_of_range" << std::endl;
+	}
+}
+
+template <typename T>
+void printSet(T const &st) {
+	std::cout << "size: " << st.size() << std::endl;
+	for (typename T::const_iterator it = st.begin(); it != st.end(); ++it)
+		std::cout << *it << " ";
+	std::cout << std::endl;
+	for (typename T::const_reverse_iterator it = st.rbegin(); it != st.rend(); ++it)
+		std::cout << *it << " ";
+	std::cout << std::endl << "------------------------" << std::endl;
+}
+
+template <typename T, typename K>
+void printBounds(T const &st, K k) {
+	typename T::const_iterator lo = st.lower_bound(k);
+	typename T::const_iterator up = st.upper_bound(k);
+	std::cout << "[" << k << "] count " << st.count(k) << ", find " << (st.find(k) != st.end())
+		<< ", lower_bound " << (lo == st.end() ? "end" : std::to_string(*lo))
+		<< ", upper_bound " << (up == st.end() ? "end" : std::to_string(*up)) << std::endl;
+}
+
+int main() {
+	std::cout << "################ Test Static Map ################" << std::endl;
+	std::cout << "===== int keys =====" << std::endl;
+	const auto status = SELECT(TESTED_NAMESPACE)::map(codes, reasons);
+	printMap(status);
+	int probes[] = { 100, 200, 201, 250, 302, 304, 418, 503, 600 };
+	for (size_t i = 0; i < sizeof(probes) / sizeof(probes[0]); ++i)
+		printLookup(status, probes[i]);
+	std::cout << "key_comp: " << status.key_comp()(200, 404) << status.key_comp()(404, 200) << std::endl;
+
+	std::cout << "===== string literal keys =====" << std::endl;
+	const auto length = SELECT(TESTED_NAMESPACE)::map<const char*, int, ft::cstr_less>(words, lengths);
+	printMap(length);
+	// keys built at run time, compared by content and not by address
+	std::string names[] = { "apple", "apples", "app", "", "a", "b", "zebra", "date" };
+	for (size_t i = 0; i < sizeof(names) / sizeof(names[0]); ++i)
+	{
+		const char* k = names[i].c_str();
+		std::cout << "[" << k << "] count " << length.count(k) << ", find " << (length.find(k) == length.end() ? "end" : length.find(k)->first)
+			<< ", lower_bound " << (length.lower_bound(k) == length.end() ? "end" : length.lower_bound(k)->first) << std::endl;
+	}
+
+	std::cout << "===== set =====" << std::endl;
+	const auto st = SELECT(TESTED_NAMESPACE)::set(spread);
+	printSet(st);
+	for (int k = -5; k <= 95; k += 15)
+		printBounds(st, k);
+	const auto one = SELECT(TESTED_NAMESPACE)::set({ 42 });
+	printSet(one);
+	printBounds(one, 41);
+	printBounds(one, 42);
+	printBounds(one, 43);
+	const auto large = SELECT(TESTED_NAMESPACE)::set(scrambled.keys);
+	std::cout << "large: " << large.size() << " " << *large.begin() << " " << *large.rbegin() << std::endl;
+	for (int k = 0; k < 1500; k += 149)
+		printBounds(large, k);
+	return (0);
+}
+
+#else
+
+int main() {
+	std::cout << "static_map needs C++14 (make test CXXSTD=c++14)" << std::endl;
+	return (0);
+}
+
+#endif